@@ -0,0 +1,354 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/DungeonGenBenchmarkCommandlet.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+#include "Rooms/MasterRoom.h"
+#include "Data/Room/RoomData.h"
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/DungeonSeed.h"
+
+UDungeonGenBenchmarkCommandlet::UDungeonGenBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Generates room data assets over a reproducible seed corpus and reports per-pass timings, memory and counts");
+	HelpUsage = TEXT("-run=DungeonGenBenchmark [-RoomData=/Game/A.A,/Game/B.B] [-Seeds=200] [-CorpusSeed=1] [-Warmup=5] [-SolveOnly] [-Format=csv|json] [-Output=Path]");
+}
+
+int32 UDungeonGenBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumSeeds = 200;
+	int32 CorpusSeed = 1;
+	int32 NumWarmupSeeds = 5;
+	FString Format = TEXT("csv");
+	FString OutputPath;
+	FParse::Value(*Params, TEXT("Seeds="), NumSeeds);
+	FParse::Value(*Params, TEXT("CorpusSeed="), CorpusSeed);
+	FParse::Value(*Params, TEXT("Warmup="), NumWarmupSeeds);
+	FParse::Value(*Params, TEXT("Format="), Format);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	const bool bSolveOnly = FParse::Param(*Params, TEXT("SolveOnly"));
+	const bool bJson = Format.Equals(TEXT("json"), ESearchCase::IgnoreCase);
+
+	if (NumSeeds <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UDungeonGenBenchmarkCommandlet::Main - -Seeds must be positive"));
+		return 1;
+	}
+
+	TArray<URoomData*> RoomDataAssets;
+	GatherRoomData(Params, RoomDataAssets);
+	if (RoomDataAssets.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UDungeonGenBenchmarkCommandlet::Main - No room data assets to benchmark"));
+		return 1;
+	}
+
+	// The corpus only depends on CorpusSeed, so runs on different builds or machines compare like for like
+	TArray<int32> Seeds;
+	Seeds.Reserve(NumSeeds);
+	for (int32 SeedIndex = 0; SeedIndex < NumSeeds; ++SeedIndex)
+	{
+		Seeds.Add(FDungeonSeed::DeriveRoomSeed(CorpusSeed, SeedIndex));
+	}
+
+	// Transient game world to spawn the rooms in - nothing is rendered
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DungeonGenBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	TArray<FRoomDataReport> Reports;
+	for (URoomData* RoomDataAsset : RoomDataAssets)
+	{
+		AMasterRoom* Room = World->SpawnActorDeferred<AMasterRoom>(AMasterRoom::StaticClass(), FTransform::Identity);
+		Room->RoomData = RoomDataAsset;
+		Room->bUseRandomSeed = false;
+		Room->bGenerateOnSpawn = false;
+		Room->bUseBuildCache = false;
+		Room->FinishSpawning(FTransform::Identity);
+
+		FRoomDataReport& Report = Reports.AddDefaulted_GetRef();
+		Report.RoomDataPath = RoomDataAsset->GetPathName();
+
+		const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+		BenchmarkRoom(*Room, Seeds, NumWarmupSeeds, bSolveOnly, Report);
+		const uint64 UsedPhysicalAfter = FPlatformMemory::GetStats().UsedPhysical;
+		Report.GetSamples(TEXT("ProcessMemoryDeltaMB")).Add((static_cast<double>(UsedPhysicalAfter) - static_cast<double>(UsedPhysicalBefore)) / (1024.0 * 1024.0));
+
+		Room->CleanupRoom();
+		Room->TrimComponentPool(0);
+		World->DestroyActor(Room);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	// Summary in the log, full report on disk
+	for (const FRoomDataReport& Report : Reports)
+	{
+		for (const FMetricSamples& Metric : Report.Metrics)
+		{
+			if (Metric.Name != TEXT("SolveMs") && Metric.Name != TEXT("CommitMs"))
+			{
+				continue;
+			}
+
+			TArray<double> SortedValues = Metric.Values;
+			SortedValues.Sort();
+			UE_LOG(LogTemp, Display, TEXT("%s %s: p50 %.3f p95 %.3f p99 %.3f (%d samples)"), *Report.RoomDataPath, *Metric.Name,
+				GetPercentile(SortedValues, 0.50), GetPercentile(SortedValues, 0.95), GetPercentile(SortedValues, 0.99), SortedValues.Num());
+		}
+	}
+
+	if (OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("DungeonGen/Benchmark") / FString::Printf(TEXT("DungeonGenBenchmark-%s.%s"),
+			*FDateTime::Now().ToString(), bJson ? TEXT("json") : TEXT("csv"));
+	}
+
+	const FString ReportText = bJson ? FormatJson(Reports, NumSeeds, CorpusSeed) : FormatCsv(Reports);
+	if (!FFileHelper::SaveStringToFile(ReportText, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UDungeonGenBenchmarkCommandlet::Main - Failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UDungeonGenBenchmarkCommandlet::Main - Wrote %s (%d room data assets x %d seeds, corpus seed %d)"),
+		*OutputPath, Reports.Num(), NumSeeds, CorpusSeed);
+	return 0;
+}
+
+TArray<double>& UDungeonGenBenchmarkCommandlet::FRoomDataReport::GetSamples(const TCHAR* MetricName)
+{
+	for (FMetricSamples& Metric : Metrics)
+	{
+		if (Metric.Name == MetricName)
+		{
+			return Metric.Values;
+		}
+	}
+
+	FMetricSamples& Metric = Metrics.AddDefaulted_GetRef();
+	Metric.Name = MetricName;
+	return Metric.Values;
+}
+
+void UDungeonGenBenchmarkCommandlet::GatherRoomData(const FString& Params, TArray<URoomData*>& OutRoomData)
+{
+	FString RoomDataList;
+	if (FParse::Value(*Params, TEXT("RoomData="), RoomDataList, false))
+	{
+		TArray<FString> RoomDataPaths;
+		RoomDataList.ParseIntoArray(RoomDataPaths, TEXT(","));
+
+		for (const FString& RoomDataPath : RoomDataPaths)
+		{
+			URoomData* RoomDataAsset = LoadObject<URoomData>(nullptr, *RoomDataPath);
+			UE_CLOG(!RoomDataAsset, LogTemp, Warning, TEXT("UDungeonGenBenchmarkCommandlet::GatherRoomData - Failed to load %s"), *RoomDataPath);
+			if (RoomDataAsset)
+			{
+				OutRoomData.Add(RoomDataAsset);
+			}
+		}
+		return;
+	}
+
+	// No list given: every room data asset of the project
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(URoomData::StaticClass()->GetClassPathName(), Assets, true);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	for (const FAssetData& Asset : Assets)
+	{
+		if (URoomData* RoomDataAsset = Cast<URoomData>(Asset.GetAsset()))
+		{
+			OutRoomData.Add(RoomDataAsset);
+		}
+	}
+}
+
+void UDungeonGenBenchmarkCommandlet::BenchmarkRoom(AMasterRoom& Room, const TArray<int32>& Seeds, int32 NumWarmupSeeds, bool bSolveOnly, FRoomDataReport& OutReport)
+{
+	NumWarmupSeeds = FMath::Max(NumWarmupSeeds, 0);
+	const int32 NumRuns = NumWarmupSeeds + Seeds.Num();
+	for (int32 RunIndex = 0; RunIndex < NumRuns; ++RunIndex)
+	{
+		// Warmup runs reuse the start of the corpus and are not recorded
+		const bool bRecord = RunIndex >= NumWarmupSeeds;
+		Room.GenerationSeed = Seeds[bRecord ? RunIndex - NumWarmupSeeds : RunIndex % Seeds.Num()];
+
+		// Same stages as AMasterRoom::GenerateRoom, timed one by one
+		const double StartTime = FPlatformTime::Seconds();
+		FRoomLayoutInput LayoutInput;
+		if (!Room.PrepareLayoutInput(LayoutInput))
+		{
+			return;
+		}
+		const double PrepareEndTime = FPlatformTime::Seconds();
+
+		FRoomLayoutSolveTimings Timings;
+		const FRoomBuildPlan Plan = FRoomLayoutSolver::Solve(LayoutInput, &Timings);
+		const double SolveEndTime = FPlatformTime::Seconds();
+
+		if (!Plan.bSucceeded)
+		{
+			continue;
+		}
+
+		if (!bSolveOnly)
+		{
+			Room.CommitBuildPlan(Plan, LayoutInput);
+		}
+		const double CommitEndTime = FPlatformTime::Seconds();
+
+		if (!bRecord)
+		{
+			continue;
+		}
+
+		OutReport.GetSamples(TEXT("PrepareMs")).Add((PrepareEndTime - StartTime) * 1000.0);
+		OutReport.GetSamples(TEXT("ShapeMs")).Add(Timings.ShapeSeconds * 1000.0);
+		OutReport.GetSamples(TEXT("GridInitMs")).Add(Timings.GridSeconds * 1000.0);
+		OutReport.GetSamples(TEXT("ForcedPlacementsMs")).Add(Timings.ForcedPlacementSeconds * 1000.0);
+		OutReport.GetSamples(TEXT("FloorMs")).Add(Timings.FloorSeconds * 1000.0);
+		OutReport.GetSamples(TEXT("WallsMs")).Add(Timings.WallSeconds * 1000.0);
+		OutReport.GetSamples(TEXT("CeilingMs")).Add(Timings.CeilingSeconds * 1000.0);
+		OutReport.GetSamples(TEXT("SolveMs")).Add((SolveEndTime - PrepareEndTime) * 1000.0);
+		OutReport.GetSamples(TEXT("TotalMs")).Add((CommitEndTime - StartTime) * 1000.0);
+
+		// Memory held by the plan (entries, path tables and grid)
+		const SIZE_T PlanBytes = Plan.GetAllocatedSize();
+		OutReport.GetSamples(TEXT("Cells")).Add(Plan.Grid.Num());
+		OutReport.GetSamples(TEXT("Entries")).Add(Plan.Entries.Num());
+		OutReport.GetSamples(TEXT("PlanBytes")).Add(static_cast<double>(PlanBytes));
+
+		if (bSolveOnly)
+		{
+			continue;
+		}
+
+		OutReport.GetSamples(TEXT("CommitMs")).Add((CommitEndTime - SolveEndTime) * 1000.0);
+
+		// Pooled components are hidden, so only visible ones belong to this generation
+		int32 NumComponents = 0;
+		int32 NumInstances = 0;
+		TInlineComponentArray<UStaticMeshComponent*> MeshComponents(&Room);
+		for (const UStaticMeshComponent* MeshComponent : MeshComponents)
+		{
+			if (!MeshComponent->IsVisible())
+			{
+				continue;
+			}
+
+			++NumComponents;
+			const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent);
+			NumInstances += InstancedComponent ? InstancedComponent->GetInstanceCount() : 1;
+		}
+
+		OutReport.GetSamples(TEXT("Components")).Add(NumComponents);
+		OutReport.GetSamples(TEXT("Instances")).Add(NumInstances);
+	}
+}
+
+double UDungeonGenBenchmarkCommandlet::GetPercentile(const TArray<double>& SortedValues, double Percentile)
+{
+	if (SortedValues.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	const int32 Rank = FMath::CeilToInt32(Percentile * SortedValues.Num());
+	return SortedValues[FMath::Clamp(Rank - 1, 0, SortedValues.Num() - 1)];
+}
+
+FString UDungeonGenBenchmarkCommandlet::FormatCsv(const TArray<FRoomDataReport>& Reports)
+{
+	FString Csv = TEXT("RoomData,Metric,Samples,Mean,P50,P95,P99,Max\n");
+
+	for (const FRoomDataReport& Report : Reports)
+	{
+		for (const FMetricSamples& Metric : Report.Metrics)
+		{
+			TArray<double> SortedValues = Metric.Values;
+			SortedValues.Sort();
+
+			double Sum = 0.0;
+			for (double Value : SortedValues)
+			{
+				Sum += Value;
+			}
+
+			Csv += FString::Printf(TEXT("%s,%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f\n"), *Report.RoomDataPath, *Metric.Name, SortedValues.Num(),
+				SortedValues.Num() > 0 ? Sum / SortedValues.Num() : 0.0, GetPercentile(SortedValues, 0.50), GetPercentile(SortedValues, 0.95),
+				GetPercentile(SortedValues, 0.99), SortedValues.Num() > 0 ? SortedValues.Last() : 0.0);
+		}
+	}
+
+	return Csv;
+}
+
+FString UDungeonGenBenchmarkCommandlet::FormatJson(const TArray<FRoomDataReport>& Reports, int32 NumSeeds, int32 CorpusSeed)
+{
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("CorpusSeed"), CorpusSeed);
+	Writer->WriteValue(TEXT("Seeds"), NumSeeds);
+	Writer->WriteValue(TEXT("GeneratorVersion"), FDungeonSeed::GeneratorVersion);
+	Writer->WriteArrayStart(TEXT("RoomData"));
+
+	for (const FRoomDataReport& Report : Reports)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Path"), Report.RoomDataPath);
+		Writer->WriteObjectStart(TEXT("Metrics"));
+
+		for (const FMetricSamples& Metric : Report.Metrics)
+		{
+			TArray<double> SortedValues = Metric.Values;
+			SortedValues.Sort();
+
+			double Sum = 0.0;
+			for (double Value : SortedValues)
+			{
+				Sum += Value;
+			}
+
+			Writer->WriteObjectStart(Metric.Name);
+			Writer->WriteValue(TEXT("Samples"), SortedValues.Num());
+			Writer->WriteValue(TEXT("Mean"), SortedValues.Num() > 0 ? Sum / SortedValues.Num() : 0.0);
+			Writer->WriteValue(TEXT("P50"), GetPercentile(SortedValues, 0.50));
+			Writer->WriteValue(TEXT("P95"), GetPercentile(SortedValues, 0.95));
+			Writer->WriteValue(TEXT("P99"), GetPercentile(SortedValues, 0.99));
+			Writer->WriteValue(TEXT("Max"), SortedValues.Num() > 0 ? SortedValues.Last() : 0.0);
+			Writer->WriteObjectEnd();
+		}
+
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return Json;
+}
@@ -0,0 +1,233 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/RoomGrid.h"
+
+void FRoomGrid::Initialize(const FIntPoint& InMinCoord, const FIntPoint& InSize)
+{
+	MinCoord = InMinCoord;
+	Size = FIntPoint(FMath::Max(InSize.X, 0), FMath::Max(InSize.Y, 0));
+	NumCells = 0;
+
+	const int32 TotalSlots = Size.X * Size.Y;
+	CellStates.Reset(TotalSlots);
+	CellStates.SetNumZeroed(TotalSlots);
+	EdgeMasks.Reset(TotalSlots);
+	EdgeMasks.SetNumZeroed(TotalSlots);
+	CellExistsBits.Reset(FMath::DivideAndRoundUp(TotalSlots, 64));
+	CellExistsBits.SetNumZeroed(FMath::DivideAndRoundUp(TotalSlots, 64));
+	OccupyingActors.Reset();
+
+	WordsPerRow = FMath::DivideAndRoundUp(Size.X, 64);
+	StateRowBits.Reset(NumCellStates * Size.Y * WordsPerRow);
+	StateRowBits.SetNumZeroed(NumCellStates * Size.Y * WordsPerRow);
+}
+
+void FRoomGrid::Empty()
+{
+	MinCoord = FIntPoint::ZeroValue;
+	Size = FIntPoint::ZeroValue;
+	NumCells = 0;
+	CellStates.Empty();
+	EdgeMasks.Empty();
+	CellExistsBits.Empty();
+	OccupyingActors.Empty();
+	WordsPerRow = 0;
+	StateRowBits.Empty();
+}
+
+int32 FRoomGrid::AddCell(const FIntPoint& GridCoord)
+{
+	const int32 Index = ToIndex(GridCoord);
+	check(Index != INDEX_NONE);
+
+	if (!IsCellIndex(Index))
+	{
+		CellExistsBits[Index >> 6] |= uint64(1) << (Index & 63);
+		++NumCells;
+		CellStates[Index] = static_cast<uint8>(ECellState::Unoccupied);
+		EdgeMasks[Index] = 0;
+		SetStateBit(ECellState::Unoccupied, Index, true);
+	}
+
+	return Index;
+}
+
+void FRoomGrid::SetRectState(const FIntPoint& BottomLeftCell, const FIntPoint& Extent, ECellState State)
+{
+	for (int32 Y = 0; Y < Extent.Y; ++Y)
+	{
+		const int32 RowStart = ToIndex(FIntPoint(BottomLeftCell.X, BottomLeftCell.Y + Y));
+		check(RowStart != INDEX_NONE);
+
+		for (int32 X = 0; X < Extent.X; ++X)
+		{
+			SetCellState(RowStart + X, State);
+		}
+	}
+}
+
+bool FRoomGrid::IsRectInState(const FIntPoint& BottomLeftCell, const FIntPoint& Extent, ECellState State) const
+{
+	if (Extent.X <= 0 || Extent.Y <= 0)
+	{
+		return false;
+	}
+
+	// The whole rectangle must lie inside the bounding box
+	if (!IsInBounds(BottomLeftCell) || !IsInBounds(BottomLeftCell + Extent - FIntPoint(1, 1)))
+	{
+		return false;
+	}
+
+	const int32 FirstColumn = BottomLeftCell.X - MinCoord.X;
+	const int32 EndColumn = FirstColumn + Extent.X;
+	const int32 FirstRow = BottomLeftCell.Y - MinCoord.Y;
+	const int32 FirstWord = FirstColumn / 64;
+	const int32 LastWord = (EndColumn - 1) / 64;
+
+	for (int32 Row = FirstRow; Row < FirstRow + Extent.Y; ++Row)
+	{
+		const uint64* RowWords = GetStateRow(State, Row);
+
+		for (int32 WordIndex = FirstWord; WordIndex <= LastWord; ++WordIndex)
+		{
+			// Bits of [FirstColumn, EndColumn) that fall inside this word
+			const int32 WordStart = WordIndex * 64;
+			const int32 LowBit = FMath::Max(FirstColumn - WordStart, 0);
+			const int32 HighBit = FMath::Min(EndColumn - WordStart, 64);
+			const uint64 HighMask = HighBit == 64 ? ~uint64(0) : ((uint64(1) << HighBit) - 1);
+			const uint64 Mask = HighMask & (~uint64(0) << LowBit);
+
+			if ((RowWords[WordIndex] & Mask) != Mask)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void FRoomGrid::SetWall(int32 Index, EWallDirection Direction, bool bHasWall)
+{
+	const uint8 Bit = GetEdgeBit(Direction);
+	SetWallMask(Index, bHasWall ? (GetWallMask(Index) | Bit) : (GetWallMask(Index) & ~Bit));
+}
+
+void FRoomGrid::SetDoorway(int32 Index, EWallDirection Direction, bool bHasDoorway)
+{
+	const uint8 Bit = GetEdgeBit(Direction);
+	SetDoorwayMask(Index, bHasDoorway ? (GetDoorwayMask(Index) | Bit) : (GetDoorwayMask(Index) & ~Bit));
+}
+
+void FRoomGrid::SetOccupyingActor(int32 Index, AActor* Actor)
+{
+	if (Actor)
+	{
+		OccupyingActors.Add(Index, Actor);
+	}
+	else
+	{
+		OccupyingActors.Remove(Index);
+	}
+}
+
+AActor* FRoomGrid::GetOccupyingActor(int32 Index) const
+{
+	const TWeakObjectPtr<AActor>* Found = OccupyingActors.Find(Index);
+	return Found ? Found->Get() : nullptr;
+}
+
+void FRoomGrid::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		RebuildDerivedState();
+	}
+}
+
+void FRoomGrid::RebuildDerivedState()
+{
+	const int32 TotalSlots = Size.X * Size.Y;
+	if (Size.X < 0 || Size.Y < 0 || CellStates.Num() != TotalSlots || EdgeMasks.Num() != TotalSlots
+		|| CellExistsBits.Num() != FMath::DivideAndRoundUp(TotalSlots, 64))
+	{
+		// Saved before cell existence was serialized, or corrupt: an empty grid is safe to query, the room regenerates it
+		UE_LOG(LogTemp, Warning, TEXT("FRoomGrid::RebuildDerivedState - Serialized grid arrays do not match its %dx%d bounds, emptying it"), Size.X, Size.Y);
+		Empty();
+		return;
+	}
+
+	// Bits past the last slot must stay clear, ForEachCellIndex would visit them
+	if (TotalSlots % 64 != 0)
+	{
+		CellExistsBits.Last() &= (uint64(1) << (TotalSlots % 64)) - 1;
+	}
+
+	NumCells = 0;
+	for (const uint64 Word : CellExistsBits)
+	{
+		NumCells += FMath::CountBits(Word);
+	}
+
+	// A state byte outside ECellState would index past the bitboard on the next SetCellState: reset it to unoccupied
+	int32 NumInvalidStates = 0;
+	for (uint8& State : CellStates)
+	{
+		if (State >= NumCellStates)
+		{
+			State = static_cast<uint8>(ECellState::Unoccupied);
+			++NumInvalidStates;
+		}
+	}
+	UE_CLOG(NumInvalidStates > 0, LogTemp, Warning, TEXT("FRoomGrid::RebuildDerivedState - Reset %d cells with an invalid serialized state to Unoccupied"), NumInvalidStates);
+
+	// The state bitboard is not serialized, it follows from the existence mask and the cell states
+	WordsPerRow = FMath::DivideAndRoundUp(Size.X, 64);
+	StateRowBits.Reset(NumCellStates * Size.Y * WordsPerRow);
+	StateRowBits.SetNumZeroed(NumCellStates * Size.Y * WordsPerRow);
+	ForEachCellIndex([this](int32 Index)
+	{
+		SetStateBit(GetCellState(Index), Index, true);
+	});
+}
+
+FGridCell FRoomGrid::GetCellView(int32 Index, const FVector& Origin, float CellSize) const
+{
+	FGridCell Cell;
+	Cell.GridCoordinates = ToCoord(Index);
+	Cell.CellState = GetCellState(Index);
+	Cell.WorldPosition = GetCellWorldPosition(Index, Origin, CellSize);
+
+	Cell.bHasNorthWall = HasWall(Index, EWallDirection::North);
+	Cell.bHasEastWall = HasWall(Index, EWallDirection::East);
+	Cell.bHasSouthWall = HasWall(Index, EWallDirection::South);
+	Cell.bHasWestWall = HasWall(Index, EWallDirection::West);
+
+	Cell.bHasNorthDoorway = HasDoorway(Index, EWallDirection::North);
+	Cell.bHasEastDoorway = HasDoorway(Index, EWallDirection::East);
+	Cell.bHasSouthDoorway = HasDoorway(Index, EWallDirection::South);
+	Cell.bHasWestDoorway = HasDoorway(Index, EWallDirection::West);
+
+	Cell.OccupyingActor = GetOccupyingActor(Index);
+	return Cell;
+}
+
+SIZE_T FRoomGrid::GetAllocatedSize() const
+{
+	return CellStates.GetAllocatedSize() + EdgeMasks.GetAllocatedSize() + OccupyingActors.GetAllocatedSize()
+		+ CellExistsBits.GetAllocatedSize() + StateRowBits.GetAllocatedSize();
+}
+
+TMap<FIntPoint, FGridCell> FRoomGrid::ToMap(const FVector& Origin, float CellSize) const
+{
+	TMap<FIntPoint, FGridCell> Result;
+	Result.Reserve(NumCells);
+
+	ForEachCellIndex([&](int32 Index)
+	{
+		Result.Add(ToCoord(Index), GetCellView(Index, Origin, CellSize));
+	});
+
+	return Result;
+}
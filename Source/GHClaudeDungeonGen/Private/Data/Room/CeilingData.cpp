@@ -2,3 +2,19 @@
 
 
 #include "GHClaudeDungeonGen/Public/Data/Room/CeilingData.h"
+
+void UCeilingData::GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const FMeshPlacementData& PlacementData : CeilingTiles)
+	{
+		if (!PlacementData.Mesh.IsNull())
+		{
+			OutPaths.AddUnique(PlacementData.Mesh.ToSoftObjectPath());
+		}
+	}
+
+	if (!DefaultMaterial.IsNull())
+	{
+		OutPaths.AddUnique(DefaultMaterial.ToSoftObjectPath());
+	}
+}
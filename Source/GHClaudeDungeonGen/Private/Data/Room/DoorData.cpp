@@ -2,3 +2,27 @@
 
 
 #include "GHClaudeDungeonGen/Public/Data/Room/DoorData.h"
+
+void UDoorData::GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const FMeshPlacementData& PlacementData : DoorwayMeshes)
+	{
+		if (!PlacementData.Mesh.IsNull())
+		{
+			OutPaths.AddUnique(PlacementData.Mesh.ToSoftObjectPath());
+		}
+	}
+
+	for (const FMeshPlacementData& PlacementData : DoorMeshes)
+	{
+		if (!PlacementData.Mesh.IsNull())
+		{
+			OutPaths.AddUnique(PlacementData.Mesh.ToSoftObjectPath());
+		}
+	}
+
+	if (!DefaultMaterial.IsNull())
+	{
+		OutPaths.AddUnique(DefaultMaterial.ToSoftObjectPath());
+	}
+}
@@ -2,3 +2,27 @@
 
 
 #include "GHClaudeDungeonGen/Public/Data/Room/FloorData.h"
+
+void UFloorData::GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const FMeshPlacementData& PlacementData : FloorTiles)
+	{
+		if (!PlacementData.Mesh.IsNull())
+		{
+			OutPaths.AddUnique(PlacementData.Mesh.ToSoftObjectPath());
+		}
+	}
+
+	if (!DefaultMaterial.IsNull())
+	{
+		OutPaths.AddUnique(DefaultMaterial.ToSoftObjectPath());
+	}
+
+	for (const TSoftObjectPtr<UMaterialInterface>& Material : MaterialVariations)
+	{
+		if (!Material.IsNull())
+		{
+			OutPaths.AddUnique(Material.ToSoftObjectPath());
+		}
+	}
+}
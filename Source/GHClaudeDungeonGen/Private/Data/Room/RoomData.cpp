@@ -2,3 +2,54 @@
 
 
 #include "GHClaudeDungeonGen/Public/Data/Room/RoomData.h"
+#include "GHClaudeDungeonGen/Public/Data/Room/FloorData.h"
+#include "GHClaudeDungeonGen/Public/Data/Room/WallData.h"
+#include "GHClaudeDungeonGen/Public/Data/Room/DoorData.h"
+#include "GHClaudeDungeonGen/Public/Data/Room/CeilingData.h"
+
+void URoomData::GetComponentDataPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!FloorData.IsNull())
+	{
+		OutPaths.AddUnique(FloorData.ToSoftObjectPath());
+	}
+
+	if (!WallData.IsNull())
+	{
+		OutPaths.AddUnique(WallData.ToSoftObjectPath());
+	}
+
+	if (!DoorData.IsNull())
+	{
+		OutPaths.AddUnique(DoorData.ToSoftObjectPath());
+	}
+
+	if (!CeilingData.IsNull())
+	{
+		OutPaths.AddUnique(CeilingData.ToSoftObjectPath());
+	}
+}
+
+void URoomData::GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	// Only already-loaded component data can be inspected - call after GetComponentDataPaths has been streamed in
+	if (const UFloorData* LoadedFloorData = FloorData.Get())
+	{
+		LoadedFloorData->GetReferencedAssetPaths(OutPaths);
+	}
+
+	if (const UWallData* LoadedWallData = WallData.Get())
+	{
+		LoadedWallData->GetReferencedAssetPaths(OutPaths);
+	}
+
+	if (const UDoorData* LoadedDoorData = DoorData.Get())
+	{
+		LoadedDoorData->GetReferencedAssetPaths(OutPaths);
+	}
+
+	if (const UCeilingData* LoadedCeilingData = CeilingData.Get())
+	{
+		LoadedCeilingData->GetReferencedAssetPaths(OutPaths);
+	}
+}
@@ -2,3 +2,22 @@
 
 
 #include "GHClaudeDungeonGen/Public/Data/Room/WallData.h"
+
+void UWallData::GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	for (const TArray<FMeshPlacementData>* MeshArray : { &WallSegments, &InnerCorners, &OuterCorners, &DoorwayFrames })
+	{
+		for (const FMeshPlacementData& PlacementData : *MeshArray)
+		{
+			if (!PlacementData.Mesh.IsNull())
+			{
+				OutPaths.AddUnique(PlacementData.Mesh.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (!DefaultMaterial.IsNull())
+	{
+		OutPaths.AddUnique(DefaultMaterial.ToSoftObjectPath());
+	}
+}
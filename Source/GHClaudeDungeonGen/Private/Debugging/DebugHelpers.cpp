@@ -1,7 +1,12 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Debugging/DebugHelpers.h"
+#include "Debugging/DungeonGenProfiling.h"
+#include "Debugging/DungeonDebugGeometry.h"
+#include "Data/Grid/RoomGrid.h"
+#include "Components/LineBatchComponent.h"
 #include "DrawDebugHelpers.h"
+#include "Hash/xxhash.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 
@@ -17,7 +22,7 @@ UDebugHelpers::UDebugHelpers()
 	bDrawWalls = true;
 	bDrawDoorways = true;
 	bDrawForcedPlacements = true;
-	
+
 	DebugLineThickness = 2.0f;
 	DebugDrawDuration = -1.0f; // Persistent by default
 
@@ -29,6 +34,8 @@ UDebugHelpers::UDebugHelpers()
 	WallColor = FColor::Blue;
 	DoorwayColor = FColor::Cyan;
 	ForcedPlacementColor = FColor::Magenta;
+
+	DebugLineBatch = nullptr;
 }
 
 void UDebugHelpers::BeginPlay()
@@ -38,112 +45,9 @@ void UDebugHelpers::BeginPlay()
 
 void UDebugHelpers::DrawDebugGrid(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
 {
-	if (!bEnableDebugDraw || !bDrawGrid)
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = false; // Start disabled, enable when debug is needed
-
-	// Initialize default debug settings
-	bShowGrid = true;
-	bShowCellCoordinates = false;
-	bShowCellStates = true;
-	bShowWalls = true;
-	bShowDoorways = true;
-	bShowSnapPoints = true;
-	DebugDrawDuration = 0.0f;
-	DebugLineThickness = 2.0f;
-	CachedCellSize = 100.0f;
-}
-
-void UDebugHelpers::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	// Only draw if any debug flag is enabled and we have cached data
-	if (IsAnyDebugEnabled() && CachedGridCells.Num() > 0)
-	{
-		DrawRoomDebug(CachedGridCells, CachedSnapPoints, CachedCellSize);
-	}
-}
-
-void UDebugHelpers::DrawGrid(const TArray<FGridCell>& GridCells, float CellSize)
-{
-	if (!bShowGrid || GridCells.Num() == 0)
-	PrimaryComponentTick.bCanEverTick = false;
-
-	// Initialize default values
-	bDrawGrid = true;
-	bDrawCellCoordinates = true;
-	bDrawWalls = true;
-	bDrawDoorways = true;
-	bDrawCellStates = true;
-
-	// Set default colors
-	GridColor = FColor::White;
-	WallColor = FColor::Red;
-	DoorwayColor = FColor::Green;
-	UnoccupiedCellColor = FColor(100, 100, 100, 50); // Gray with transparency
-	OccupiedCellColor = FColor(0, 100, 200, 50); // Blue with transparency
-
-	// Set default drawing parameters
-	LineThickness = 2.0f;
-	DebugDrawHeight = 5.0f;
-}
-
-UWorld* UDebugHelpers::GetDebugWorld() const
-{
-	return GetWorld();
-}
-
-void UDebugHelpers::DrawGridCell(const FGridCell& Cell, float CellSize, const FVector& Offset)
-{
-	UWorld* World = GetDebugWorld();
-	if (!World)
-	bShowDebugVisualization = true;
-	bDrawGrid = true;
-	bDrawOccupiedCells = true;
-	bDrawUnoccupiedCells = true;
-	bDrawForcedPlacements = true;
-	DebugLineThickness = 2.0f;
-	DebugVisualizationZOffset = 1.0f;
-}
-
-void UDebugHelpers::DrawGrid(const TArray<FGridCell>& Grid, float CellSize, const FVector& OwnerLocation, UWorld* World)
-{
-	if (!bShowDebugVisualization || !bDrawGrid || !World)
-	{
-		return;
-	}
-
-	UWorld* World = GetWorld();
-	if (!World)
-	{
-		return;
-	}
+	DUNGEONGEN_SCOPE(DrawDebugGrid);
 
-	const FVector OwnerLocation = GetOwner()->GetActorLocation();
-	const float HalfCell = CellSize / 2.0f;
-	const FColor GridColor = FColor::Green;
-
-	for (const FGridCell& Cell : GridCells)
-	{
-		const FVector CellWorldPos = OwnerLocation + Cell.WorldPosition;
-		
-		// Draw cell boundaries as a square
-		const FVector TopLeft = CellWorldPos + FVector(-HalfCell, HalfCell, 0);
-		const FVector TopRight = CellWorldPos + FVector(HalfCell, HalfCell, 0);
-		const FVector BottomRight = CellWorldPos + FVector(HalfCell, -HalfCell, 0);
-		const FVector BottomLeft = CellWorldPos + FVector(-HalfCell, -HalfCell, 0);
-
-		DrawDebugLine(World, TopLeft, TopRight, GridColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		DrawDebugLine(World, TopRight, BottomRight, GridColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		DrawDebugLine(World, BottomRight, BottomLeft, GridColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		DrawDebugLine(World, BottomLeft, TopLeft, GridColor, false, DebugDrawDuration, 0, DebugLineThickness);
-	}
-}
-
-void UDebugHelpers::DrawCellCoordinates(const TArray<FGridCell>& GridCells)
-{
-	if (!bShowCellCoordinates || GridCells.Num() == 0)
+	if (!bEnableDebugDraw || !bDrawGrid)
 	{
 		return;
 	}
@@ -163,129 +67,43 @@ void UDebugHelpers::DrawCellCoordinates(const TArray<FGridCell>& GridCells)
 		// Draw cell boundary as a box
 		FVector BoxExtent(CellSize * 0.5f, CellSize * 0.5f, 5.0f);
 		FVector BoxCenter = CellWorldPos + FVector(CellSize * 0.5f, CellSize * 0.5f, 0.0f);
-		
+
 		DrawDebugBox(World, BoxCenter, BoxExtent, FColor::White, false, DebugDrawDuration, 0, DebugLineThickness);
 	}
 }
 
 void UDebugHelpers::DrawDebugCellStates(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
 {
-	if (!bEnableDebugDraw || !bDrawCellStates)
-	const FVector OwnerLocation = GetOwner()->GetActorLocation();
-
-	for (const FGridCell& Cell : GridCells)
-	{
-		const FVector TextLocation = OwnerLocation + Cell.WorldPosition + FVector(0, 0, 10);
-		const FString CoordText = FString::Printf(TEXT("(%d,%d)"), Cell.GridCoordinates.X, Cell.GridCoordinates.Y);
-		
-		DrawDebugString(World, TextLocation, CoordText, nullptr, FColor::White, DebugDrawDuration, true);
-	}
-}
-
-void UDebugHelpers::DrawCellStates(const TArray<FGridCell>& GridCells, float CellSize)
-{
-	if (!bShowCellStates || GridCells.Num() == 0)
-	const FVector CellCenter = Cell.WorldPosition + Offset + FVector(0, 0, DebugDrawHeight);
-	const float HalfCell = CellSize * 0.5f;
-
-	// Draw grid outline if enabled
-	if (bDrawGrid)
-	{
-		// Draw cell border
-		const FVector Corners[4] = {
-			CellCenter + FVector(-HalfCell, -HalfCell, 0),
-			CellCenter + FVector(HalfCell, -HalfCell, 0),
-			CellCenter + FVector(HalfCell, HalfCell, 0),
-			CellCenter + FVector(-HalfCell, HalfCell, 0)
-		};
-
-		for (int32 i = 0; i < 4; i++)
-		{
-			DrawDebugLine(World, Corners[i], Corners[(i + 1) % 4], GridColor, false, -1.0f, 0, LineThickness);
-		}
-	}
-
-	// Draw cell state color if enabled
-	if (bDrawCellStates)
-	{
-		FColor StateColor = UnoccupiedCellColor;
-		if (Cell.CellState == ECellState::Occupied)
-		{
-			StateColor = OccupiedCellColor;
-		}
-
-		// Draw a translucent box for the cell
-		const FVector BoxExtent(HalfCell, HalfCell, 2.0f);
-		DrawDebugBox(World, CellCenter, BoxExtent, StateColor, false, -1.0f, 0, 1.0f);
-	}
-
-	// Draw walls if enabled
-	if (bDrawWalls)
-	{
-		DrawCellWalls(Cell, CellSize, Offset);
-	}
-
-	// Draw doorways if enabled
-	if (bDrawDoorways)
-	{
-		DrawCellDoorways(Cell, CellSize, Offset);
-	}
-
-	// Draw coordinates if enabled
-	if (bDrawCellCoordinates)
-	{
-		DrawCellCoordinate(Cell, Offset);
-	}
-}
+	DUNGEONGEN_SCOPE(DrawDebugCellStates);
 
-void UDebugHelpers::DrawGridCells(const TArray<FGridCell>& Cells, float CellSize, const FVector& Offset)
-{
-	for (const FGridCell& Cell : Cells)
+	if (!bEnableDebugDraw || !bDrawCellStates)
 	{
-		DrawGridCell(Cell, CellSize, Offset);
+		return;
 	}
-}
 
-void UDebugHelpers::DrawCellWalls(const FGridCell& Cell, float CellSize, const FVector& Offset)
-{
-	UWorld* World = GetDebugWorld();
+	UWorld* World = GetWorld();
 	if (!World)
-	// Find grid bounds
-	FIntPoint MinCoord(INT_MAX, INT_MAX);
-	FIntPoint MaxCoord(INT_MIN, INT_MIN);
-
-	for (const FGridCell& Cell : Grid)
 	{
-		MinCoord.X = FMath::Min(MinCoord.X, Cell.GridCoordinates.X);
-		MinCoord.Y = FMath::Min(MinCoord.Y, Cell.GridCoordinates.Y);
-		MaxCoord.X = FMath::Max(MaxCoord.X, Cell.GridCoordinates.X);
-		MaxCoord.Y = FMath::Max(MaxCoord.Y, Cell.GridCoordinates.Y);
+		return;
 	}
 
-	// Draw grid lines (green)
-	const FColor GridColor = FColor::Green;
-	const float ZOffset = DebugVisualizationZOffset;
+	const float HalfCell = CellSize * 0.5f;
 
-	// Draw vertical lines
-	for (int32 X = MinCoord.X; X <= MaxCoord.X + 1; ++X)
+	for (const auto& CellPair : Grid)
 	{
-		FVector Start = OwnerLocation + FVector(X * CellSize, MinCoord.Y * CellSize, ZOffset);
-		FVector End = OwnerLocation + FVector(X * CellSize, (MaxCoord.Y + 1) * CellSize, ZOffset);
-		DrawDebugLine(World, Start, End, GridColor, true, -1.0f, 0, DebugLineThickness);
-	}
+		const FGridCell& Cell = CellPair.Value;
+		FVector CellCenter = GetWorldLocationForCell(Cell.GridCoordinates, CellSize) + FVector(HalfCell, HalfCell, 5.0f);
 
-	// Draw horizontal lines
-	for (int32 Y = MinCoord.Y; Y <= MaxCoord.Y + 1; ++Y)
-	{
-		FVector Start = OwnerLocation + FVector(MinCoord.X * CellSize, Y * CellSize, ZOffset);
-		FVector End = OwnerLocation + FVector((MaxCoord.X + 1) * CellSize, Y * CellSize, ZOffset);
-		DrawDebugLine(World, Start, End, GridColor, true, -1.0f, 0, DebugLineThickness);
+		// Draw filled square for cell state
+		DrawDebugSolidBox(World, CellCenter, FVector(HalfCell * 0.8f, HalfCell * 0.8f, 2.0f), GetColorForCellState(Cell.CellState), false, DebugDrawDuration);
 	}
 }
 
-void UDebugHelpers::DrawOccupiedCells(const TArray<FGridCell>& Grid, float CellSize, const FVector& OwnerLocation, UWorld* World)
+void UDebugHelpers::DrawDebugWalls(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
 {
-	if (!bShowDebugVisualization || !bDrawOccupiedCells || !World)
+	DUNGEONGEN_SCOPE(DrawDebugWalls);
+
+	if (!bEnableDebugDraw || !bDrawWalls)
 	{
 		return;
 	}
@@ -296,41 +114,51 @@ void UDebugHelpers::DrawOccupiedCells(const TArray<FGridCell>& Grid, float CellS
 		return;
 	}
 
-	// Draw color-coded cell states
+	const float WallHeight = 200.0f;
+
 	for (const auto& CellPair : Grid)
 	{
 		const FGridCell& Cell = CellPair.Value;
-		FVector CellWorldPos = GetWorldLocationForCell(Cell.GridCoordinates, CellSize);
-		FColor CellColor = GetColorForCellState(Cell.CellState);
+		FVector CellOrigin = GetWorldLocationForCell(Cell.GridCoordinates, CellSize);
 
-		// Draw filled square slightly above ground
-		FVector SquareCenter = CellWorldPos + FVector(CellSize * 0.5f, CellSize * 0.5f, 10.0f);
-		FVector SquareExtent(CellSize * 0.4f, CellSize * 0.4f, 1.0f);
-		
-		DrawDebugSolidBox(World, SquareCenter, SquareExtent, CellColor, false, DebugDrawDuration);
-	}
-}
+		auto DrawWallEdge = [&](const FVector& Start, const FVector& End)
+		{
+			// Draw the wall base and top edge
+			DrawDebugLine(World, Start, End, WallColor, false, DebugDrawDuration, 0, DebugLineThickness);
+			DrawDebugLine(World, Start + FVector(0.0f, 0.0f, WallHeight), End + FVector(0.0f, 0.0f, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness);
+		};
 
-void UDebugHelpers::DrawDebugWalls(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
-{
-	if (!bEnableDebugDraw || !bDrawWalls)
-	const FVector OwnerLocation = GetOwner()->GetActorLocation();
-	const float HalfCell = CellSize / 2.0f;
+		// Draw north wall (positive Y)
+		if (Cell.bHasNorthWall)
+		{
+			DrawWallEdge(CellOrigin + FVector(0.0f, CellSize, 0.0f), CellOrigin + FVector(CellSize, CellSize, 0.0f));
+		}
 
-	for (const FGridCell& Cell : GridCells)
-	{
-		const FVector CellWorldPos = OwnerLocation + Cell.WorldPosition;
-		const FColor StateColor = GetCellStateColor(Cell.CellState);
-		
-		// Draw filled square for cell state
-		const FVector Center = CellWorldPos + FVector(0, 0, 5);
-		DrawDebugSolidBox(World, Center, FVector(HalfCell * 0.8f, HalfCell * 0.8f, 2.0f), StateColor, false, DebugDrawDuration);
+		// Draw east wall (positive X)
+		if (Cell.bHasEastWall)
+		{
+			DrawWallEdge(CellOrigin + FVector(CellSize, 0.0f, 0.0f), CellOrigin + FVector(CellSize, CellSize, 0.0f));
+		}
+
+		// Draw south wall (negative Y)
+		if (Cell.bHasSouthWall)
+		{
+			DrawWallEdge(CellOrigin, CellOrigin + FVector(CellSize, 0.0f, 0.0f));
+		}
+
+		// Draw west wall (negative X)
+		if (Cell.bHasWestWall)
+		{
+			DrawWallEdge(CellOrigin, CellOrigin + FVector(0.0f, CellSize, 0.0f));
+		}
 	}
 }
 
-void UDebugHelpers::DrawWalls(const TArray<FGridCell>& GridCells, float CellSize)
+void UDebugHelpers::DrawDebugDoorways(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
 {
-	if (!bShowWalls || GridCells.Num() == 0)
+	DUNGEONGEN_SCOPE(DrawDebugDoorways);
+
+	if (!bEnableDebugDraw || !bDrawDoorways)
 	{
 		return;
 	}
@@ -341,438 +169,321 @@ void UDebugHelpers::DrawWalls(const TArray<FGridCell>& GridCells, float CellSize
 		return;
 	}
 
-	// Draw walls on cell edges
+	const float HalfCell = CellSize * 0.5f;
+	const float DoorwayHeight = 50.0f;
+
 	for (const auto& CellPair : Grid)
 	{
 		const FGridCell& Cell = CellPair.Value;
-		FVector CellWorldPos = GetWorldLocationForCell(Cell.GridCoordinates, CellSize);
+		FVector CellOrigin = GetWorldLocationForCell(Cell.GridCoordinates, CellSize);
 
-		// North wall (+Y)
-		if (Cell.bHasNorthWall)
+		// Draw doorways as spheres on the cell edge
+		if (Cell.bHasNorthDoorway)
 		{
-			FVector WallStart = CellWorldPos + FVector(0.0f, CellSize, 0.0f);
-			FVector WallEnd = CellWorldPos + FVector(CellSize, CellSize, 0.0f);
-			FVector WallTop = FVector(0.0f, 0.0f, 200.0f); // Wall height
-			
-			DrawDebugLine(World, WallStart, WallEnd, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
-			DrawDebugLine(World, WallStart + WallTop, WallEnd + WallTop, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
+			DrawDebugSphere(World, CellOrigin + FVector(HalfCell, CellSize, DoorwayHeight), 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
 		}
 
-		// East wall (+X)
-		if (Cell.bHasEastWall)
+		if (Cell.bHasEastDoorway)
 		{
-			FVector WallStart = CellWorldPos + FVector(CellSize, 0.0f, 0.0f);
-			FVector WallEnd = CellWorldPos + FVector(CellSize, CellSize, 0.0f);
-			FVector WallTop = FVector(0.0f, 0.0f, 200.0f);
-			
-			DrawDebugLine(World, WallStart, WallEnd, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
-			DrawDebugLine(World, WallStart + WallTop, WallEnd + WallTop, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
+			DrawDebugSphere(World, CellOrigin + FVector(CellSize, HalfCell, DoorwayHeight), 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
 		}
 
-		// South wall (-Y)
-		if (Cell.bHasSouthWall)
+		if (Cell.bHasSouthDoorway)
 		{
-			FVector WallStart = CellWorldPos;
-			FVector WallEnd = CellWorldPos + FVector(CellSize, 0.0f, 0.0f);
-			FVector WallTop = FVector(0.0f, 0.0f, 200.0f);
-			
-			DrawDebugLine(World, WallStart, WallEnd, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
-			DrawDebugLine(World, WallStart + WallTop, WallEnd + WallTop, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
+			DrawDebugSphere(World, CellOrigin + FVector(HalfCell, 0.0f, DoorwayHeight), 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
 		}
 
-		// West wall (-X)
-		if (Cell.bHasWestWall)
+		if (Cell.bHasWestDoorway)
 		{
-			FVector WallStart = CellWorldPos;
-			FVector WallEnd = CellWorldPos + FVector(0.0f, CellSize, 0.0f);
-			FVector WallTop = FVector(0.0f, 0.0f, 200.0f);
-			
-			DrawDebugLine(World, WallStart, WallEnd, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
-			DrawDebugLine(World, WallStart + WallTop, WallEnd + WallTop, WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2.0f);
+			DrawDebugSphere(World, CellOrigin + FVector(0.0f, HalfCell, DoorwayHeight), 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
 		}
 	}
 }
 
-void UDebugHelpers::DrawDebugDoorways(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
+void UDebugHelpers::DrawDebugForcedPlacements(const TMap<FIntPoint, FMeshPlacementData>& ForcedPlacements, float CellSize)
 {
-	if (!bEnableDebugDraw || !bDrawDoorways)
-	const FVector CellCenter = Cell.WorldPosition + Offset + FVector(0, 0, DebugDrawHeight);
-	const float HalfCell = CellSize * 0.5f;
-	const float WallThickness = LineThickness * 2.0f;
-
-	// Draw north wall (positive Y)
-	if (Cell.bHasNorthWall)
-	{
-		const FVector Start = CellCenter + FVector(-HalfCell, HalfCell, 0);
-		const FVector End = CellCenter + FVector(HalfCell, HalfCell, 0);
-		DrawDebugLine(World, Start, End, WallColor, false, -1.0f, 0, WallThickness);
-	}
+	DUNGEONGEN_SCOPE(DrawDebugForcedPlacements);
 
-	// Draw east wall (positive X)
-	if (Cell.bHasEastWall)
+	if (!bEnableDebugDraw || !bDrawForcedPlacements)
 	{
-		const FVector Start = CellCenter + FVector(HalfCell, -HalfCell, 0);
-		const FVector End = CellCenter + FVector(HalfCell, HalfCell, 0);
-		DrawDebugLine(World, Start, End, WallColor, false, -1.0f, 0, WallThickness);
+		return;
 	}
 
-	// Draw south wall (negative Y)
-	if (Cell.bHasSouthWall)
+	UWorld* World = GetWorld();
+	if (!World)
 	{
-		const FVector Start = CellCenter + FVector(-HalfCell, -HalfCell, 0);
-		const FVector End = CellCenter + FVector(HalfCell, -HalfCell, 0);
-		DrawDebugLine(World, Start, End, WallColor, false, -1.0f, 0, WallThickness);
+		return;
 	}
 
-	// Draw west wall (negative X)
-	if (Cell.bHasWestWall)
+	for (const auto& Placement : ForcedPlacements)
 	{
-		const FVector Start = CellCenter + FVector(-HalfCell, -HalfCell, 0);
-		const FVector End = CellCenter + FVector(-HalfCell, HalfCell, 0);
-		DrawDebugLine(World, Start, End, WallColor, false, -1.0f, 0, WallThickness);
-	}
-}
+		const FIntPoint& BottomLeftCell = Placement.Key;
+		const FMeshPlacementData& PlacementData = Placement.Value;
 
-void UDebugHelpers::DrawCellDoorways(const FGridCell& Cell, float CellSize, const FVector& Offset)
-{
-	UWorld* World = GetDebugWorld();
-	if (!World)
-	const FLinearColor OccupiedColor = FLinearColor::Red;
-	const float ZOffset = DebugVisualizationZOffset;
+		// Highlight the full footprint of the forced placement
+		FVector FootprintOrigin = GetWorldLocationForCell(BottomLeftCell, CellSize);
+		FVector FootprintExtent(PlacementData.CellsX * CellSize * 0.5f, PlacementData.CellsY * CellSize * 0.5f, 10.0f);
+		FVector FootprintCenter = FootprintOrigin + FVector(FootprintExtent.X, FootprintExtent.Y, 10.0f);
 
-	for (const FGridCell& Cell : Grid)
-	{
-		if (Cell.CellState == ECellState::Occupied)
-		{
-			FVector CellWorldPos = OwnerLocation + FVector(Cell.GridCoordinates.X * CellSize, Cell.GridCoordinates.Y * CellSize, ZOffset);
-			DrawCellRect(CellWorldPos, CellSize, OccupiedColor, World);
-		}
+		DrawDebugBox(World, FootprintCenter, FootprintExtent, ForcedPlacementColor, false, DebugDrawDuration, 0, DebugLineThickness * 1.5f);
 	}
 }
 
-void UDebugHelpers::DrawUnoccupiedCells(const TArray<FGridCell>& Grid, float CellSize, const FVector& OwnerLocation, UWorld* World)
+void UDebugHelpers::ToggleDebugDraw()
 {
-	if (!bShowDebugVisualization || !bDrawUnoccupiedCells || !World)
-	{
-		return;
-	}
-
-	const FVector OwnerLocation = GetOwner()->GetActorLocation();
-	const float HalfCell = CellSize / 2.0f;
-	const FColor WallColor = FColor::Red;
-	const float WallHeight = 50.0f;
+	bEnableDebugDraw = !bEnableDebugDraw;
 
-	for (const FGridCell& Cell : GridCells)
+	// The batch is drawn by the renderer on its own, so it has to be removed explicitly
+	if (!bEnableDebugDraw)
 	{
-		const FVector CellWorldPos = OwnerLocation + Cell.WorldPosition;
-		
-		// Draw walls as vertical lines
-		if (Cell.bHasNorthWall)
-		{
-			const FVector Start = CellWorldPos + FVector(-HalfCell, HalfCell, 0);
-			const FVector End = CellWorldPos + FVector(HalfCell, HalfCell, 0);
-			DrawDebugLine(World, Start, Start + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, End, End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, Start + FVector(0, 0, WallHeight), End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-		}
-		
-		if (Cell.bHasEastWall)
-		{
-			const FVector Start = CellWorldPos + FVector(HalfCell, -HalfCell, 0);
-			const FVector End = CellWorldPos + FVector(HalfCell, HalfCell, 0);
-			DrawDebugLine(World, Start, Start + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, End, End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, Start + FVector(0, 0, WallHeight), End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-		}
-		
-		if (Cell.bHasSouthWall)
-		{
-			const FVector Start = CellWorldPos + FVector(-HalfCell, -HalfCell, 0);
-			const FVector End = CellWorldPos + FVector(HalfCell, -HalfCell, 0);
-			DrawDebugLine(World, Start, Start + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, End, End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, Start + FVector(0, 0, WallHeight), End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-		}
-		
-		if (Cell.bHasWestWall)
-		{
-			const FVector Start = CellWorldPos + FVector(-HalfCell, -HalfCell, 0);
-			const FVector End = CellWorldPos + FVector(-HalfCell, HalfCell, 0);
-			DrawDebugLine(World, Start, Start + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, End, End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-			DrawDebugLine(World, Start + FVector(0, 0, WallHeight), End + FVector(0, 0, WallHeight), WallColor, false, DebugDrawDuration, 0, DebugLineThickness * 2);
-		}
+		ClearDebugVisualization();
 	}
+
+	OnDebugDrawToggled.Broadcast();
 }
 
-void UDebugHelpers::DrawDoorways(const TArray<FGridCell>& GridCells, float CellSize)
+#if WITH_EDITOR
+void UDebugHelpers::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
-	if (!bShowDoorways || GridCells.Num() == 0)
-	const FLinearColor UnoccupiedColor = FLinearColor::Blue;
-	const float ZOffset = DebugVisualizationZOffset;
+	Super::PostEditChangeProperty(PropertyChangedEvent);
 
-	for (const FGridCell& Cell : Grid)
+	if (PropertyChangedEvent.Property != nullptr && PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UDebugHelpers, bEnableDebugDraw))
 	{
-		if (Cell.CellState == ECellState::Unoccupied)
+		if (!bEnableDebugDraw)
 		{
-			FVector CellWorldPos = OwnerLocation + FVector(Cell.GridCoordinates.X * CellSize, Cell.GridCoordinates.Y * CellSize, ZOffset);
-			DrawCellRect(CellWorldPos, CellSize, UnoccupiedColor, World);
+			ClearDebugVisualization();
 		}
+
+		OnDebugDrawToggled.Broadcast();
 	}
 }
+#endif
 
-void UDebugHelpers::DrawForcedPlacements(const TMap<FIntPoint, FMeshPlacementData>& ForcedPlacements, float CellSize, const FVector& OwnerLocation, UWorld* World)
+void UDebugHelpers::UpdateDebugVisualization(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
 {
-	if (!bShowDebugVisualization || !bDrawForcedPlacements || !World)
-	{
-		return;
-	}
+	DUNGEONGEN_SCOPE(UpdateDebugVisualization);
 
-	UWorld* World = GetWorld();
-	if (!World)
+	if (!bEnableDebugDraw)
 	{
+		ClearDebugVisualization();
 		return;
 	}
 
-	// Draw doorways on cell edges
+	TArray<FDebugCell> Cells;
+	Cells.Reserve(Grid.Num());
 	for (const auto& CellPair : Grid)
 	{
 		const FGridCell& Cell = CellPair.Value;
-		FVector CellWorldPos = GetWorldLocationForCell(Cell.GridCoordinates, CellSize);
-
-		// North doorway (+Y)
-		if (Cell.bHasNorthDoorway)
-		{
-			FVector DoorCenter = CellWorldPos + FVector(CellSize * 0.5f, CellSize, 100.0f);
-			DrawDebugSphere(World, DoorCenter, 20.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
+		FDebugCell& DebugCell = Cells.AddDefaulted_GetRef();
+		DebugCell.GridCoord = Cell.GridCoordinates;
+		DebugCell.State = Cell.CellState;
+		DebugCell.WallMask = (Cell.bHasNorthWall ? FRoomGrid::GetEdgeBit(EWallDirection::North) : 0)
+			| (Cell.bHasEastWall ? FRoomGrid::GetEdgeBit(EWallDirection::East) : 0)
+			| (Cell.bHasSouthWall ? FRoomGrid::GetEdgeBit(EWallDirection::South) : 0)
+			| (Cell.bHasWestWall ? FRoomGrid::GetEdgeBit(EWallDirection::West) : 0);
+		DebugCell.DoorwayMask = (Cell.bHasNorthDoorway ? FRoomGrid::GetEdgeBit(EWallDirection::North) : 0)
+			| (Cell.bHasEastDoorway ? FRoomGrid::GetEdgeBit(EWallDirection::East) : 0)
+			| (Cell.bHasSouthDoorway ? FRoomGrid::GetEdgeBit(EWallDirection::South) : 0)
+			| (Cell.bHasWestDoorway ? FRoomGrid::GetEdgeBit(EWallDirection::West) : 0);
+	}
 
-		// East doorway (+X)
-		if (Cell.bHasEastDoorway)
-		{
-			FVector DoorCenter = CellWorldPos + FVector(CellSize, CellSize * 0.5f, 100.0f);
-			DrawDebugSphere(World, DoorCenter, 20.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
+	// Map order depends on insertion order; the same grid must produce the same batch key
+	Cells.Sort([](const FDebugCell& A, const FDebugCell& B)
+	{
+		return A.GridCoord.Y != B.GridCoord.Y ? A.GridCoord.Y < B.GridCoord.Y : A.GridCoord.X < B.GridCoord.X;
+	});
 
-		// South doorway (-Y)
-		if (Cell.bHasSouthDoorway)
-		{
-			FVector DoorCenter = CellWorldPos + FVector(CellSize * 0.5f, 0.0f, 100.0f);
-			DrawDebugSphere(World, DoorCenter, 20.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
+	RebuildLineBatch(Cells, CellSize);
+}
 
-		// West doorway (-X)
-		if (Cell.bHasWestDoorway)
-		{
-			FVector DoorCenter = CellWorldPos + FVector(0.0f, CellSize * 0.5f, 100.0f);
-			DrawDebugSphere(World, DoorCenter, 20.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
+void UDebugHelpers::ClearDebugVisualization()
+{
+	if (DebugLineBatch)
+	{
+		DebugLineBatch->Flush();
 	}
+	LineBatchKey = 0;
 }
 
-void UDebugHelpers::DrawDebugForcedPlacements(const TMap<FIntPoint, FMeshPlacementData>& ForcedPlacements, float CellSize)
+void UDebugHelpers::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
 {
-	if (!bEnableDebugDraw || !bDrawForcedPlacements)
-	const FVector OwnerLocation = GetOwner()->GetActorLocation();
-	const float HalfCell = CellSize / 2.0f;
-	const FColor DoorwayColor = FColor::Cyan;
-	const float DoorwayHeight = 50.0f;
+	Super::GetResourceSizeEx(CumulativeResourceSize);
 
-	for (const FGridCell& Cell : GridCells)
+	if (DebugLineBatch)
 	{
-		const FVector CellWorldPos = OwnerLocation + Cell.WorldPosition;
-		
-		// Draw doorways as cyan markers
-		if (Cell.bHasNorthDoorway)
+		SIZE_T BatchBytes = DebugLineBatch->BatchedLines.GetAllocatedSize() + DebugLineBatch->BatchedMeshes.GetAllocatedSize();
+		for (const FBatchedMesh& Mesh : DebugLineBatch->BatchedMeshes)
 		{
-			const FVector Location = CellWorldPos + FVector(0, HalfCell, DoorwayHeight / 2);
-			DrawDebugSphere(World, Location, 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
-		
-		if (Cell.bHasEastDoorway)
-		{
-			const FVector Location = CellWorldPos + FVector(HalfCell, 0, DoorwayHeight / 2);
-			DrawDebugSphere(World, Location, 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
-		
-		if (Cell.bHasSouthDoorway)
-		{
-			const FVector Location = CellWorldPos + FVector(0, -HalfCell, DoorwayHeight / 2);
-			DrawDebugSphere(World, Location, 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		}
-		
-		if (Cell.bHasWestDoorway)
-		{
-			const FVector Location = CellWorldPos + FVector(-HalfCell, 0, DoorwayHeight / 2);
-			DrawDebugSphere(World, Location, 15.0f, 8, DoorwayColor, false, DebugDrawDuration, 0, DebugLineThickness);
+			BatchBytes += Mesh.MeshVerts.GetAllocatedSize() + Mesh.MeshIndices.GetAllocatedSize();
 		}
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(BatchBytes);
 	}
 }
 
-void UDebugHelpers::DrawSnapPoints(const TArray<FVector>& SnapPoints)
+void UDebugHelpers::RebuildLineBatch(const TArray<FDebugCell>& Cells, float CellSize)
 {
-	if (!bShowSnapPoints || SnapPoints.Num() == 0)
+	DUNGEONGEN_SCOPE(RebuildLineBatch);
+
+	AActor* Owner = GetOwner();
+	ULineBatchComponent* LineBatch = GetOrCreateLineBatch();
+	if (!Owner || !LineBatch)
 	{
 		return;
 	}
 
-	UWorld* World = GetWorld();
-	const FVector CellCenter = Cell.WorldPosition + Offset + FVector(0, 0, DebugDrawHeight + 2.0f);
-	const float HalfCell = CellSize * 0.5f;
-	const float DoorwayIndicatorSize = CellSize * 0.3f;
+	const FVector Origin = Owner->GetActorLocation();
 
-	// Draw north doorway (positive Y)
-	if (Cell.bHasNorthDoorway)
+	// Everything the batch is built from: an unchanged room costs one pass over its cells instead of a rebuild
+	FXxHash64Builder KeyBuilder;
+	auto HashValue = [&KeyBuilder](const auto& Value)
 	{
-		const FVector DoorwayPos = CellCenter + FVector(0, HalfCell, 0);
-		DrawDebugSphere(World, DoorwayPos, DoorwayIndicatorSize * 0.5f, 8, DoorwayColor, false, -1.0f, 0, LineThickness);
-	}
+		KeyBuilder.Update(&Value, sizeof(Value));
+	};
 
-	// Draw east doorway (positive X)
-	if (Cell.bHasEastDoorway)
+	HashValue(Origin);
+	HashValue(CellSize);
+	for (const bool bFlag : { bDrawGrid, bDrawCellStates, bDrawWalls, bDrawDoorways })
 	{
-		const FVector DoorwayPos = CellCenter + FVector(HalfCell, 0, 0);
-		DrawDebugSphere(World, DoorwayPos, DoorwayIndicatorSize * 0.5f, 8, DoorwayColor, false, -1.0f, 0, LineThickness);
+		HashValue(bFlag);
 	}
-
-	// Draw south doorway (negative Y)
-	if (Cell.bHasSouthDoorway)
+	HashValue(DebugLineThickness);
+	HashValue(DebugDrawDuration);
+	for (const FColor& Color : { UnoccupiedCellColor, OccupiedCellColor, ReservedCellColor, ExcludedCellColor, WallColor, DoorwayColor })
 	{
-		const FVector DoorwayPos = CellCenter + FVector(0, -HalfCell, 0);
-		DrawDebugSphere(World, DoorwayPos, DoorwayIndicatorSize * 0.5f, 8, DoorwayColor, false, -1.0f, 0, LineThickness);
+		HashValue(Color);
 	}
 
-	// Draw west doorway (negative X)
-	if (Cell.bHasWestDoorway)
+	for (const FDebugCell& Cell : Cells)
 	{
-		const FVector DoorwayPos = CellCenter + FVector(-HalfCell, 0, 0);
-		DrawDebugSphere(World, DoorwayPos, DoorwayIndicatorSize * 0.5f, 8, DoorwayColor, false, -1.0f, 0, LineThickness);
+		HashValue(Cell.GridCoord);
+		HashValue(Cell.State);
+		HashValue(Cell.WallMask);
+		HashValue(Cell.DoorwayMask);
 	}
-}
 
-void UDebugHelpers::DrawCellCoordinate(const FGridCell& Cell, const FVector& Offset)
-{
-	UWorld* World = GetDebugWorld();
-	if (!World)
+	LineBatch->SetVisibility(true);
+
+	const uint64 NewKey = KeyBuilder.Finalize().Hash;
+	if (NewKey == LineBatchKey)
 	{
 		return;
 	}
+	LineBatchKey = NewKey;
+	LineBatch->Flush();
 
-	// Highlight forced placement areas
-	for (const auto& Placement : ForcedPlacements)
-	{
-		const FIntPoint& BottomLeftCell = Placement.Key;
-		const FMeshPlacementData& PlacementData = Placement.Value;
+	// A lifetime of 0 keeps the lines until the next rebuild, and the batch only needs to tick for timed lines
+	const float LifeTime = DebugDrawDuration > 0.0f ? DebugDrawDuration : 0.0f;
+	LineBatch->SetComponentTickEnabled(LifeTime > 0.0f);
 
-		FVector CellWorldPos = GetWorldLocationForCell(BottomLeftCell, CellSize);
-		
-		// Draw footprint area
-		FVector FootprintExtent(
-			PlacementData.CellsX * CellSize * 0.5f,
-			PlacementData.CellsY * CellSize * 0.5f,
-			50.0f
-		);
-		FVector FootprintCenter = CellWorldPos + FVector(
-			PlacementData.CellsX * CellSize * 0.5f,
-			PlacementData.CellsY * CellSize * 0.5f,
-			50.0f
-		);
-
-		DrawDebugBox(World, FootprintCenter, FootprintExtent, ForcedPlacementColor, false, DebugDrawDuration, 0, DebugLineThickness * 3.0f);
-	}
-}
+	const float HalfCell = CellSize * 0.5f;
+	const float WallHeight = 200.0f;
+	const float DoorwayHeight = 50.0f;
+	const float DoorwayRadius = 15.0f;
 
-void UDebugHelpers::ToggleDebugDraw()
-{
-	bEnableDebugDraw = !bEnableDebugDraw;
-}
+	TArray<FBatchedLine> Lines;
+	auto AddLine = [&Lines, LifeTime](const FVector& Start, const FVector& End, const FColor& Color, float Thickness)
+	{
+		Lines.Emplace(Start, End, FLinearColor(Color), LifeTime, Thickness, SDPG_World);
+	};
 
-void UDebugHelpers::UpdateDebugVisualization(const TMap<FIntPoint, FGridCell>& Grid, float CellSize)
-{
-	if (!bEnableDebugDraw)
-	const FVector OwnerLocation = GetOwner()->GetActorLocation();
-	const FColor SnapPointColor = FColor::Yellow;
+	// Three great circles, as DrawDebugSphere draws them
+	auto AddSphere = [&AddLine](const FVector& Center, float Radius, const FColor& Color, float Thickness)
+	{
+		const int32 NumSegments = 8;
+		const FVector Axes[3][2] = { { FVector::XAxisVector, FVector::YAxisVector }, { FVector::XAxisVector, FVector::ZAxisVector }, { FVector::YAxisVector, FVector::ZAxisVector } };
+		for (const FVector (&Plane)[2] : Axes)
+		{
+			for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+			{
+				const float StartAngle = 2.0f * PI * Segment / NumSegments;
+				const float EndAngle = 2.0f * PI * (Segment + 1) / NumSegments;
+				AddLine(Center + Radius * (FMath::Cos(StartAngle) * Plane[0] + FMath::Sin(StartAngle) * Plane[1]),
+					Center + Radius * (FMath::Cos(EndAngle) * Plane[0] + FMath::Sin(EndAngle) * Plane[1]), Color, Thickness);
+			}
+		}
+	};
 
-	for (const FVector& SnapPoint : SnapPoints)
+	// Neighbour lookup for drawing shared grid edges once
+	TSet<FIntPoint> CellCoords;
+	if (bDrawGrid)
 	{
-		const FVector WorldSnapPoint = OwnerLocation + SnapPoint;
-		DrawDebugSphere(World, WorldSnapPoint, 20.0f, 12, SnapPointColor, false, DebugDrawDuration, 0, DebugLineThickness);
-		DrawDebugCoordinateSystem(World, WorldSnapPoint, FRotator::ZeroRotator, 30.0f, false, DebugDrawDuration, 0, DebugLineThickness);
+		CellCoords.Reserve(Cells.Num());
+		for (const FDebugCell& Cell : Cells)
+		{
+			CellCoords.Add(Cell.GridCoord);
+		}
 	}
-}
 
-void UDebugHelpers::DrawRoomDebug(const TArray<FGridCell>& GridCells, const TArray<FVector>& SnapPoints, float CellSize)
-{
-	// Cache values for continuous drawing
-	CachedGridCells = GridCells;
-	CachedSnapPoints = SnapPoints;
-	CachedCellSize = CellSize;
-
-	// Enable tick only if debug is needed
-	SetComponentTickEnabled(IsAnyDebugEnabled() && CachedGridCells.Num() > 0);
-
-	// Draw all debug visuals
-	DrawGrid(GridCells, CellSize);
-	DrawCellCoordinates(GridCells);
-	DrawCellStates(GridCells, CellSize);
-	DrawWalls(GridCells, CellSize);
-	DrawDoorways(GridCells, CellSize);
-	DrawSnapPoints(SnapPoints);
-	const FVector TextLocation = Cell.WorldPosition + Offset + FVector(0, 0, DebugDrawHeight + 10.0f);
-	const FString CoordText = FString::Printf(TEXT("(%d,%d)"), Cell.GridCoordinates.X, Cell.GridCoordinates.Y);
-	
-	// Use finite duration to prevent accumulation of debug text
-	DrawDebugString(World, TextLocation, CoordText, nullptr, FColor::Yellow, 0.1f, true, 1.0f);
-}
+	// One mesh per cell state, indexed by ECellState
+	TArray<FVector> StateVerts[4];
+	TArray<int32> StateIndices[4];
 
-void UDebugHelpers::DrawDoorwaySnapPoints(const TArray<FVector>& SnapPoints, float Radius)
-{
-	UWorld* World = GetDebugWorld();
-	const FLinearColor ForcedPlacementColor = FLinearColor::Yellow;
-	const float ZOffset = DebugVisualizationZOffset + 0.5f; // Slightly higher to stand out
-
-	for (const TPair<FIntPoint, FMeshPlacementData>& Pair : ForcedPlacements)
+	for (const FDebugCell& Cell : Cells)
 	{
-		const FIntPoint& BottomLeft = Pair.Key;
-		const FMeshPlacementData& PlacementData = Pair.Value;
+		const FVector CellOrigin = Origin + FVector(Cell.GridCoord.X * CellSize, Cell.GridCoord.Y * CellSize, 0.0f);
+		FVector Corners[4];
+		DungeonDebugGeometry::GetCellCorners(CellOrigin, CellSize, Corners);
 
-		// Draw a rectangle covering the entire footprint
-		FVector StartPos = OwnerLocation + FVector(BottomLeft.X * CellSize, BottomLeft.Y * CellSize, ZOffset);
-		float Width = PlacementData.CellsX * CellSize;
-		float Height = PlacementData.CellsY * CellSize;
+		if (bDrawGrid)
+		{
+			DungeonDebugGeometry::ForEachOwnedGridEdge(Cell.GridCoord, CellCoords, [&](int32 StartCorner, int32 EndCorner)
+			{
+				AddLine(Corners[StartCorner], Corners[EndCorner], FColor::White, DebugLineThickness);
+			});
+		}
 
-		FVector Corners[4] = {
-			StartPos,
-			StartPos + FVector(Width, 0.0f, 0.0f),
-			StartPos + FVector(Width, Height, 0.0f),
-			StartPos + FVector(0.0f, Height, 0.0f)
-		};
+		const int32 StateIndex = static_cast<int32>(Cell.State);
+		if (bDrawCellStates && StateIndex < UE_ARRAY_COUNT(StateVerts))
+		{
+			// A quad per cell, wound both ways so it shows from above and below
+			const FVector Center = CellOrigin + FVector(HalfCell, HalfCell, 7.0f);
+			const float Inset = HalfCell * 0.8f;
+			const int32 FirstVertex = StateVerts[StateIndex].Num();
+			StateVerts[StateIndex].Append({ Center + FVector(-Inset, -Inset, 0.0f), Center + FVector(Inset, -Inset, 0.0f), Center + FVector(Inset, Inset, 0.0f), Center + FVector(-Inset, Inset, 0.0f) });
+			StateIndices[StateIndex].Append({ FirstVertex, FirstVertex + 1, FirstVertex + 2, FirstVertex, FirstVertex + 2, FirstVertex + 3,
+				FirstVertex, FirstVertex + 2, FirstVertex + 1, FirstVertex, FirstVertex + 3, FirstVertex + 2 });
+		}
+
+		// Wall base and top edge
+		if (bDrawWalls)
+		{
+			DungeonDebugGeometry::ForEachMaskedEdge(Cell.WallMask, [&](int32 StartCorner, int32 EndCorner)
+			{
+				AddLine(Corners[StartCorner], Corners[EndCorner], WallColor, DebugLineThickness);
+				AddLine(Corners[StartCorner] + FVector(0.0f, 0.0f, WallHeight), Corners[EndCorner] + FVector(0.0f, 0.0f, WallHeight), WallColor, DebugLineThickness);
+			});
+		}
 
-		// Draw the rectangle
-		for (int32 i = 0; i < 4; ++i)
+		// Doorway marker at the middle of the edge
+		if (bDrawDoorways)
 		{
-			FVector Start = Corners[i];
-			FVector End = Corners[(i + 1) % 4];
-			DrawDebugLine(World, Start, End, ForcedPlacementColor.ToFColor(true), true, -1.0f, 0, DebugLineThickness * 1.5f);
+			DungeonDebugGeometry::ForEachMaskedEdge(Cell.DoorwayMask, [&](int32 StartCorner, int32 EndCorner)
+			{
+				AddSphere((Corners[StartCorner] + Corners[EndCorner]) * 0.5f + FVector(0.0f, 0.0f, DoorwayHeight), DoorwayRadius, DoorwayColor, DebugLineThickness);
+			});
 		}
+	}
 
-		// Draw an X to mark the forced placement
-		DrawDebugLine(World, Corners[0], Corners[2], ForcedPlacementColor.ToFColor(true), true, -1.0f, 0, DebugLineThickness);
-		DrawDebugLine(World, Corners[1], Corners[3], ForcedPlacementColor.ToFColor(true), true, -1.0f, 0, DebugLineThickness);
+	LineBatch->DrawLines(Lines);
+	for (int32 StateIndex = 0; StateIndex < UE_ARRAY_COUNT(StateVerts); ++StateIndex)
+	{
+		if (StateIndices[StateIndex].Num() > 0)
+		{
+			LineBatch->DrawMesh(StateVerts[StateIndex], StateIndices[StateIndex], GetColorForCellState(static_cast<ECellState>(StateIndex)), SDPG_World, LifeTime);
+		}
 	}
 }
 
-void UDebugHelpers::DrawCellRect(const FVector& CellWorldPosition, float CellSize, const FLinearColor& Color, UWorld* World)
+ULineBatchComponent* UDebugHelpers::GetOrCreateLineBatch()
 {
-	if (!World)
+	AActor* Owner = GetOwner();
+	if (!DebugLineBatch && Owner && GetWorld())
 	{
-		return;
+		// Lines are in world space, so the batch needs no attachment; it is transient and rebuilt by the next update
+		DebugLineBatch = NewObject<ULineBatchComponent>(Owner, NAME_None, RF_Transient);
+		DebugLineBatch->RegisterComponent();
 	}
-
-	DrawDebugGrid(Grid, CellSize);
-	DrawDebugCellStates(Grid, CellSize);
-	DrawDebugWalls(Grid, CellSize);
-	DrawDebugDoorways(Grid, CellSize);
+	return DebugLineBatch;
 }
 
 FVector UDebugHelpers::GetWorldLocationForCell(const FIntPoint& GridCoord, float CellSize) const
@@ -787,7 +498,7 @@ FVector UDebugHelpers::GetWorldLocationForCell(const FIntPoint& GridCoord, float
 	WorldPos.X = GridCoord.X * CellSize;
 	WorldPos.Y = GridCoord.Y * CellSize;
 	WorldPos.Z = 0.0f;
-	
+
 	return Owner->GetActorLocation() + WorldPos;
 }
 
@@ -806,68 +517,4 @@ FColor UDebugHelpers::GetColorForCellState(ECellState State) const
 	default:
 		return FColor::White;
 	}
-	for (const FVector& SnapPoint : SnapPoints)
-	{
-		DrawDebugSphere(World, SnapPoint + FVector(0, 0, DebugDrawHeight), Radius, 12, DoorwayColor, false, -1.0f, 0, LineThickness * 2.0f);
-	}
-}
-
-void UDebugHelpers::ClearDebugDrawings()
-{
-	CachedGridCells.Empty();
-	CachedSnapPoints.Empty();
-
-	UWorld* World = GetWorld();
-	if (World)
-	{
-		FlushDebugStrings(World);
-		FlushPersistentDebugLines(World);
-	}
-}
-
-FColor UDebugHelpers::GetCellStateColor(ECellState State) const
-{
-	switch (State)
-	{
-		case ECellState::Unoccupied:
-			return FColor(100, 100, 100, 128); // Gray (semi-transparent)
-		case ECellState::Occupied:
-			return FColor(0, 255, 0, 128); // Green (semi-transparent)
-		case ECellState::Reserved:
-			return FColor(255, 255, 0, 128); // Yellow (semi-transparent)
-		case ECellState::Excluded:
-			return FColor(255, 0, 0, 128); // Red (semi-transparent)
-		default:
-			return FColor::White;
-	}
-}
-
-bool UDebugHelpers::IsAnyDebugEnabled() const
-{
-	return bShowGrid || bShowCellCoordinates || bShowCellStates || 
-	       bShowWalls || bShowDoorways || bShowSnapPoints;
-	UWorld* World = GetDebugWorld();
-	if (World)
-	{
-		FlushPersistentDebugLines(World);
-	}
-	// Draw a filled rectangle for the cell
-	FVector Corners[4] = {
-		CellWorldPosition,
-		CellWorldPosition + FVector(CellSize, 0.0f, 0.0f),
-		CellWorldPosition + FVector(CellSize, CellSize, 0.0f),
-		CellWorldPosition + FVector(0.0f, CellSize, 0.0f)
-	};
-
-	// Draw lines to form a rectangle
-	for (int32 i = 0; i < 4; ++i)
-	{
-		FVector Start = Corners[i];
-		FVector End = Corners[(i + 1) % 4];
-		DrawDebugLine(World, Start, End, Color.ToFColor(true), true, -1.0f, 0, DebugLineThickness);
-	}
-
-	// Draw diagonals for better visibility
-	DrawDebugLine(World, Corners[0], Corners[2], Color.ToFColor(true), true, -1.0f, 0, DebugLineThickness * 0.5f);
-	DrawDebugLine(World, Corners[1], Corners[3], Color.ToFColor(true), true, -1.0f, 0, DebugLineThickness * 0.5f);
 }
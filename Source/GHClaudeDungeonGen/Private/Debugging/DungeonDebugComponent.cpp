@@ -0,0 +1,595 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Debugging/DungeonDebugComponent.h"
+#include "Debugging/DungeonGenProfiling.h"
+#include "Debugging/DungeonDebugGeometry.h"
+#include "Data/Grid/RoomGrid.h"
+#include "DynamicMeshBuilder.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "LocalVertexFactory.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "PrimitiveSceneProxy.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+#include "SceneManagement.h"
+#include "StaticMeshResources.h"
+
+static constexpr int32 NumDungeonDebugLayers = static_cast<int32>(EDungeonDebugLayer::Count);
+
+// ========== Layer Geometry ==========
+
+void FDungeonDebugLayerGeometry::AddQuad(const FVector3f& A, const FVector3f& B, const FVector3f& C, const FVector3f& D, const FColor& Color)
+{
+	const uint32 FirstVertex = Positions.Num();
+	Positions.Append({ A, B, C, D });
+	Colors.Append({ Color, Color, Color, Color });
+	Indices.Append({ FirstVertex, FirstVertex + 1, FirstVertex + 2, FirstVertex, FirstVertex + 2, FirstVertex + 3,
+		FirstVertex, FirstVertex + 2, FirstVertex + 1, FirstVertex, FirstVertex + 3, FirstVertex + 2 });
+}
+
+void FDungeonDebugLayerGeometry::AddLine(const FVector3f& Start, const FVector3f& End, const FColor& Color, float Thickness)
+{
+	const FVector3f Direction = (End - Start).GetSafeNormal();
+	if (Direction.IsNearlyZero())
+	{
+		return;
+	}
+
+	// Two ribbons at right angles keep the line visible from any view direction
+	const FVector3f Reference = FMath::Abs(Direction.Z) < 0.99f ? FVector3f::UpVector : FVector3f::ForwardVector;
+	const FVector3f SideA = FVector3f::CrossProduct(Direction, Reference).GetSafeNormal() * (Thickness * 0.5f);
+	const FVector3f SideB = FVector3f::CrossProduct(Direction, SideA).GetSafeNormal() * (Thickness * 0.5f);
+
+	AddQuad(Start - SideA, Start + SideA, End + SideA, End - SideA, Color);
+	AddQuad(Start - SideB, Start + SideB, End + SideB, End - SideB, Color);
+}
+
+void FDungeonDebugLayerGeometry::AddBox(const FVector3f& Min, const FVector3f& Max, const FColor& Color, float Thickness)
+{
+	const FVector3f Corners[4] = { FVector3f(Min.X, Min.Y, 0.0f), FVector3f(Max.X, Min.Y, 0.0f), FVector3f(Max.X, Max.Y, 0.0f), FVector3f(Min.X, Max.Y, 0.0f) };
+	const FVector3f Bottom(0.0f, 0.0f, Min.Z);
+	const FVector3f Top(0.0f, 0.0f, Max.Z);
+
+	for (int32 Edge = 0; Edge < 4; ++Edge)
+	{
+		const FVector3f& Start = Corners[Edge];
+		const FVector3f& End = Corners[(Edge + 1) % 4];
+		AddLine(Start + Bottom, End + Bottom, Color, Thickness);
+		AddLine(Start + Top, End + Top, Color, Thickness);
+		AddLine(Start + Bottom, Start + Top, Color, Thickness);
+	}
+}
+
+void FDungeonDebugLayerGeometry::Reset()
+{
+	Positions.Reset();
+	Colors.Reset();
+	Indices.Reset();
+}
+
+// ========== Scene Proxy ==========
+
+/**
+ * Render-thread side of UDungeonDebugComponent
+ * Holds one vertex/index buffer per layer, uploaded once when the proxy is created, and draws the visible ones
+ */
+class FDungeonDebugSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	FDungeonDebugSceneProxy(const UDungeonDebugComponent* Component, UMaterialInterface* InMaterial)
+		: FPrimitiveSceneProxy(Component)
+		, Material(InMaterial)
+		, MaterialRelevance(InMaterial->GetRelevance_Concurrent(GetScene().GetShaderPlatform()))
+		, VisibleLayers(Component->GetVisibleLayerMask())
+	{
+		for (int32 LayerIndex = 0; LayerIndex < NumDungeonDebugLayers; ++LayerIndex)
+		{
+			const FDungeonDebugLayerGeometry& Geometry = Component->LayerGeometry[LayerIndex];
+			if (Geometry.Indices.Num() > 0)
+			{
+				Layers[LayerIndex] = MakeUnique<FLayerBuffers>(GetScene().GetFeatureLevel(), Geometry);
+			}
+		}
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	/** Layer toggles from the game thread; the buffers stay as they are */
+	void SetVisibleLayers_RenderThread(uint8 InVisibleLayers)
+	{
+		VisibleLayers = InVisibleLayers;
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	{
+		DUNGEONGEN_SCOPE(DebugOverlayMeshElements);
+
+		const FMaterialRenderProxy* MaterialProxy = Material->GetRenderProxy();
+
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+		{
+			if (!(VisibilityMap & (1 << ViewIndex)))
+			{
+				continue;
+			}
+
+			for (int32 LayerIndex = 0; LayerIndex < NumDungeonDebugLayers; ++LayerIndex)
+			{
+				const FLayerBuffers* Layer = Layers[LayerIndex].Get();
+				if (!Layer || !(VisibleLayers & (1 << LayerIndex)))
+				{
+					continue;
+				}
+
+				FMeshBatch& Mesh = Collector.AllocateMesh();
+				Mesh.VertexFactory = &Layer->VertexFactory;
+				Mesh.MaterialRenderProxy = MaterialProxy;
+				Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+				Mesh.Type = PT_TriangleList;
+				Mesh.DepthPriorityGroup = SDPG_World;
+				Mesh.bCanApplyViewModeOverrides = false;
+
+				FMeshBatchElement& BatchElement = Mesh.Elements[0];
+				BatchElement.IndexBuffer = &Layer->IndexBuffer;
+				BatchElement.PrimitiveUniformBuffer = GetUniformBuffer();
+				BatchElement.FirstIndex = 0;
+				BatchElement.NumPrimitives = Layer->IndexBuffer.Indices.Num() / 3;
+				BatchElement.MinVertexIndex = 0;
+				BatchElement.MaxVertexIndex = Layer->VertexBuffers.PositionVertexBuffer.GetNumVertices() - 1;
+
+				Collector.AddMesh(ViewIndex, Mesh);
+			}
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View) && VisibleLayers != 0;
+		Result.bDynamicRelevance = true;
+		Result.bShadowRelevance = false;
+		Result.bRenderInMainPass = ShouldRenderInMainPass();
+		Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+		MaterialRelevance.SetPrimitiveViewRelevance(Result);
+		Result.bVelocityRelevance = false;
+		return Result;
+	}
+
+	virtual bool CanBeOccluded() const override
+	{
+		return !MaterialRelevance.bDisableDepthTest;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T AllocatedSize = FPrimitiveSceneProxy::GetAllocatedSize();
+		for (const TUniquePtr<FLayerBuffers>& Layer : Layers)
+		{
+			if (Layer)
+			{
+				AllocatedSize += sizeof(FLayerBuffers) + Layer->IndexBuffer.Indices.GetAllocatedSize();
+			}
+		}
+		return AllocatedSize;
+	}
+
+private:
+	/** GPU buffers of one layer */
+	struct FLayerBuffers
+	{
+		FStaticMeshVertexBuffers VertexBuffers;
+		FDynamicMeshIndexBuffer32 IndexBuffer;
+		FLocalVertexFactory VertexFactory;
+
+		FLayerBuffers(ERHIFeatureLevel::Type FeatureLevel, const FDungeonDebugLayerGeometry& Geometry)
+			: VertexFactory(FeatureLevel, "FDungeonDebugSceneProxy")
+		{
+			TArray<FDynamicMeshVertex> Vertices;
+			Vertices.Reserve(Geometry.Positions.Num());
+			for (int32 VertexIndex = 0; VertexIndex < Geometry.Positions.Num(); ++VertexIndex)
+			{
+				Vertices.Emplace(Geometry.Positions[VertexIndex], FVector2f::ZeroVector, Geometry.Colors[VertexIndex]);
+			}
+
+			// Initializes the vertex buffers and the vertex factory on the render thread
+			VertexBuffers.InitFromDynamicVertex(&VertexFactory, Vertices);
+
+			IndexBuffer.Indices = Geometry.Indices;
+			BeginInitResource(&IndexBuffer);
+		}
+
+		~FLayerBuffers()
+		{
+			VertexBuffers.PositionVertexBuffer.ReleaseResource();
+			VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+			VertexBuffers.ColorVertexBuffer.ReleaseResource();
+			IndexBuffer.ReleaseResource();
+			VertexFactory.ReleaseResource();
+		}
+	};
+
+	UMaterialInterface* Material;
+	FMaterialRelevance MaterialRelevance;
+	TUniquePtr<FLayerBuffers> Layers[NumDungeonDebugLayers];
+	uint8 VisibleLayers;
+};
+
+// ========== Component ==========
+
+UDungeonDebugComponent::UDungeonDebugComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// Purely visual: no collision, shadows or navigation
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	SetGenerateOverlapEvents(false);
+	CastShadow = false;
+	SetCanEverAffectNavigation(false);
+	SetHiddenInGame(true);
+
+	// Room meshes are placed from the actor location without its rotation or scale; the overlay follows them
+	SetUsingAbsoluteRotation(true);
+	SetUsingAbsoluteScale(true);
+
+	bDrawGrid = true;
+	bDrawCellStates = true;
+	bDrawWalls = true;
+	bDrawDoorways = true;
+	bDrawSnapPoints = true;
+	bDrawForcedPlacements = true;
+
+	LineThickness = 2.0f;
+	WallHeight = 200.0f;
+
+	UnoccupiedCellColor = FColor::Green;
+	OccupiedCellColor = FColor::Red;
+	ReservedCellColor = FColor::Yellow;
+	ExcludedCellColor = FColor::Black;
+	WallColor = FColor::Blue;
+	DoorwayColor = FColor::Cyan;
+	SnapPointColor = FColor::Orange;
+	ForcedPlacementColor = FColor::Magenta;
+
+	LocalBounds.Init();
+}
+
+void UDungeonDebugComponent::SetRoomLayout(const FRoomGrid& Grid, float CellSize, TConstArrayView<const TMap<FIntPoint, FMeshPlacementData>*> ForcedPlacements, TConstArrayView<FIntPoint> SnapPoints)
+{
+	DUNGEONGEN_SCOPE(SetDebugOverlayLayout);
+
+	TArray<FLayoutCell> Cells;
+	Cells.Reserve(Grid.Num());
+	Grid.ForEachCellIndex([&Grid, &Cells](int32 Index)
+	{
+		FLayoutCell& Cell = Cells.AddDefaulted_GetRef();
+		Cell.GridCoord = Grid.ToCoord(Index);
+		Cell.State = Grid.GetCellState(Index);
+		Cell.WallMask = Grid.GetWallMask(Index);
+		Cell.DoorwayMask = Grid.GetDoorwayMask(Index);
+	});
+
+	TArray<FIntRect> Footprints;
+	for (const TMap<FIntPoint, FMeshPlacementData>* Placements : ForcedPlacements)
+	{
+		if (Placements)
+		{
+			for (const TPair<FIntPoint, FMeshPlacementData>& Placement : *Placements)
+			{
+				Footprints.Emplace(Placement.Key, Placement.Key + FIntPoint(Placement.Value.CellsX, Placement.Value.CellsY));
+			}
+		}
+	}
+
+	TArray<FIntPoint> NewSnapPoints(SnapPoints);
+
+	// The same layout again (incremental regeneration that changed nothing visible, refreshes) keeps the uploaded buffers
+	if (CellSize == LayoutCellSize && Cells == LayoutCells && Footprints == LayoutFootprints && NewSnapPoints == LayoutSnapPoints)
+	{
+		return;
+	}
+
+	LayoutCells = MoveTemp(Cells);
+	LayoutFootprints = MoveTemp(Footprints);
+	LayoutSnapPoints = MoveTemp(NewSnapPoints);
+	LayoutCellSize = CellSize;
+
+	RebuildGeometry();
+}
+
+void UDungeonDebugComponent::ClearRoomLayout()
+{
+	if (LayoutCells.Num() == 0 && LayoutFootprints.Num() == 0 && LayoutSnapPoints.Num() == 0)
+	{
+		return;
+	}
+
+	LayoutCells.Empty();
+	LayoutFootprints.Empty();
+	LayoutSnapPoints.Empty();
+	LayoutCellSize = 0.0f;
+
+	RebuildGeometry();
+}
+
+void UDungeonDebugComponent::SetLayerVisible(EDungeonDebugLayer Layer, bool bVisible)
+{
+	switch (Layer)
+	{
+	case EDungeonDebugLayer::Grid:
+		bDrawGrid = bVisible;
+		break;
+	case EDungeonDebugLayer::CellStates:
+		bDrawCellStates = bVisible;
+		break;
+	case EDungeonDebugLayer::Walls:
+		bDrawWalls = bVisible;
+		break;
+	case EDungeonDebugLayer::Doorways:
+		bDrawDoorways = bVisible;
+		break;
+	case EDungeonDebugLayer::SnapPoints:
+		bDrawSnapPoints = bVisible;
+		break;
+	case EDungeonDebugLayer::ForcedPlacements:
+		bDrawForcedPlacements = bVisible;
+		break;
+	default:
+		return;
+	}
+
+	PushVisibleLayers();
+}
+
+bool UDungeonDebugComponent::IsLayerVisible(EDungeonDebugLayer Layer) const
+{
+	return (GetVisibleLayerMask() & (1 << static_cast<int32>(Layer))) != 0;
+}
+
+FPrimitiveSceneProxy* UDungeonDebugComponent::CreateSceneProxy()
+{
+	UMaterialInterface* Material = GetOverlayMaterial();
+	if (!Material || !LocalBounds.IsValid)
+	{
+		return nullptr;
+	}
+
+	return new FDungeonDebugSceneProxy(this, Material);
+}
+
+FBoxSphereBounds UDungeonDebugComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (!LocalBounds.IsValid)
+	{
+		return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0f);
+	}
+
+	return FBoxSphereBounds(LocalBounds).TransformBy(LocalToWorld);
+}
+
+void UDungeonDebugComponent::GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const
+{
+	if (UMaterialInterface* Material = GetOverlayMaterial())
+	{
+		OutMaterials.Add(Material);
+	}
+}
+
+void UDungeonDebugComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	SIZE_T LayoutBytes = LayoutCells.GetAllocatedSize() + LayoutFootprints.GetAllocatedSize() + LayoutSnapPoints.GetAllocatedSize();
+	for (const FDungeonDebugLayerGeometry& Geometry : LayerGeometry)
+	{
+		LayoutBytes += Geometry.GetAllocatedSize();
+	}
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(LayoutBytes);
+}
+
+#if WITH_EDITOR
+void UDungeonDebugComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.Property == nullptr)
+	{
+		return;
+	}
+
+	const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+
+	// Layer toggles reach the proxy directly; only appearance changes need new geometry
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, bDrawGrid) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, bDrawCellStates) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, bDrawWalls) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, bDrawDoorways) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, bDrawSnapPoints) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, bDrawForcedPlacements))
+	{
+		PushVisibleLayers();
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, LineThickness) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, WallHeight) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, UnoccupiedCellColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, OccupiedCellColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, ReservedCellColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, ExcludedCellColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, WallColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, DoorwayColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, SnapPointColor) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UDungeonDebugComponent, ForcedPlacementColor))
+	{
+		RebuildGeometry();
+	}
+}
+#endif
+
+void UDungeonDebugComponent::RebuildGeometry()
+{
+	DUNGEONGEN_SCOPE(BuildDebugOverlay);
+
+	for (FDungeonDebugLayerGeometry& Geometry : LayerGeometry)
+	{
+		Geometry.Reset();
+	}
+
+	// Nothing would be drawn: drop the proxy and build when a layer is shown again
+	bGeometryDeferred = GetVisibleLayerMask() == 0;
+	if (bGeometryDeferred)
+	{
+		LocalBounds.Init();
+		UpdateBounds();
+		MarkRenderStateDirty();
+		return;
+	}
+
+	const float CellSize = LayoutCellSize;
+	const float HalfCell = CellSize * 0.5f;
+
+	FDungeonDebugLayerGeometry& GridLayer = LayerGeometry[static_cast<int32>(EDungeonDebugLayer::Grid)];
+	FDungeonDebugLayerGeometry& CellStateLayer = LayerGeometry[static_cast<int32>(EDungeonDebugLayer::CellStates)];
+	FDungeonDebugLayerGeometry& WallLayer = LayerGeometry[static_cast<int32>(EDungeonDebugLayer::Walls)];
+	FDungeonDebugLayerGeometry& DoorwayLayer = LayerGeometry[static_cast<int32>(EDungeonDebugLayer::Doorways)];
+	FDungeonDebugLayerGeometry& SnapPointLayer = LayerGeometry[static_cast<int32>(EDungeonDebugLayer::SnapPoints)];
+	FDungeonDebugLayerGeometry& ForcedPlacementLayer = LayerGeometry[static_cast<int32>(EDungeonDebugLayer::ForcedPlacements)];
+
+	// Neighbour lookup for building shared grid edges once
+	TSet<FIntPoint> CellCoords;
+	CellCoords.Reserve(LayoutCells.Num());
+	for (const FLayoutCell& Cell : LayoutCells)
+	{
+		CellCoords.Add(Cell.GridCoord);
+	}
+
+	const FVector3f GridLift(0.0f, 0.0f, 1.0f);
+	const FVector3f WallTop(0.0f, 0.0f, WallHeight);
+	const FVector3f DoorwayTop(0.0f, 0.0f, WallHeight * 0.8f);
+
+	for (const FLayoutCell& Cell : LayoutCells)
+	{
+		const FVector3f CellOrigin(Cell.GridCoord.X * CellSize, Cell.GridCoord.Y * CellSize, 0.0f);
+		FVector3f Corners[4];
+		DungeonDebugGeometry::GetCellCorners(CellOrigin, CellSize, Corners);
+
+		DungeonDebugGeometry::ForEachOwnedGridEdge(Cell.GridCoord, CellCoords, [&](int32 StartCorner, int32 EndCorner)
+		{
+			GridLayer.AddLine(Corners[StartCorner] + GridLift, Corners[EndCorner] + GridLift, FColor::White, LineThickness);
+		});
+
+		// Inset quad slightly above the floor
+		const FVector3f Center = CellOrigin + FVector3f(HalfCell, HalfCell, 7.0f);
+		const float Inset = HalfCell * 0.8f;
+		CellStateLayer.AddQuad(Center + FVector3f(-Inset, -Inset, 0.0f), Center + FVector3f(Inset, -Inset, 0.0f),
+			Center + FVector3f(Inset, Inset, 0.0f), Center + FVector3f(-Inset, Inset, 0.0f), GetColorForCellState(Cell.State));
+
+		// Wall base and top edge
+		DungeonDebugGeometry::ForEachMaskedEdge(Cell.WallMask, [&](int32 StartCorner, int32 EndCorner)
+		{
+			WallLayer.AddLine(Corners[StartCorner], Corners[EndCorner], WallColor, LineThickness);
+			WallLayer.AddLine(Corners[StartCorner] + WallTop, Corners[EndCorner] + WallTop, WallColor, LineThickness);
+		});
+
+		// Doorway frame over the middle of the edge
+		DungeonDebugGeometry::ForEachMaskedEdge(Cell.DoorwayMask, [&](int32 StartCorner, int32 EndCorner)
+		{
+			const FVector3f FrameStart = FMath::Lerp(Corners[StartCorner], Corners[EndCorner], 0.2f);
+			const FVector3f FrameEnd = FMath::Lerp(Corners[StartCorner], Corners[EndCorner], 0.8f);
+			DoorwayLayer.AddLine(FrameStart, FrameStart + DoorwayTop, DoorwayColor, LineThickness);
+			DoorwayLayer.AddLine(FrameEnd, FrameEnd + DoorwayTop, DoorwayColor, LineThickness);
+			DoorwayLayer.AddLine(FrameStart + DoorwayTop, FrameEnd + DoorwayTop, DoorwayColor, LineThickness);
+		});
+	}
+
+	// Snap points as a post with a floor cross at the cell center
+	for (const FIntPoint& SnapPoint : LayoutSnapPoints)
+	{
+		const FVector3f Center((SnapPoint.X + 0.5f) * CellSize, (SnapPoint.Y + 0.5f) * CellSize, 0.0f);
+		const float Arm = HalfCell * 0.5f;
+		SnapPointLayer.AddLine(Center, Center + WallTop * 1.25f, SnapPointColor, LineThickness * 2.0f);
+		SnapPointLayer.AddLine(Center + FVector3f(-Arm, 0.0f, 2.0f), Center + FVector3f(Arm, 0.0f, 2.0f), SnapPointColor, LineThickness * 2.0f);
+		SnapPointLayer.AddLine(Center + FVector3f(0.0f, -Arm, 2.0f), Center + FVector3f(0.0f, Arm, 2.0f), SnapPointColor, LineThickness * 2.0f);
+	}
+
+	for (const FIntRect& Footprint : LayoutFootprints)
+	{
+		ForcedPlacementLayer.AddBox(FVector3f(Footprint.Min.X * CellSize, Footprint.Min.Y * CellSize, 0.0f),
+			FVector3f(Footprint.Max.X * CellSize, Footprint.Max.Y * CellSize, 20.0f), ForcedPlacementColor, LineThickness * 1.5f);
+	}
+
+	LocalBounds.Init();
+	for (const FDungeonDebugLayerGeometry& Geometry : LayerGeometry)
+	{
+		for (const FVector3f& Position : Geometry.Positions)
+		{
+			LocalBounds += FVector(Position);
+		}
+	}
+
+	// New proxy with freshly uploaded buffers
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+void UDungeonDebugComponent::PushVisibleLayers()
+{
+	if (bGeometryDeferred && GetVisibleLayerMask() != 0)
+	{
+		// The new proxy picks up the layer toggles itself
+		RebuildGeometry();
+		return;
+	}
+
+	if (FDungeonDebugSceneProxy* DebugProxy = static_cast<FDungeonDebugSceneProxy*>(SceneProxy))
+	{
+		const uint8 VisibleLayers = GetVisibleLayerMask();
+		ENQUEUE_RENDER_COMMAND(SetDungeonDebugLayers)([DebugProxy, VisibleLayers](FRHICommandListImmediate& RHICmdList)
+		{
+			DebugProxy->SetVisibleLayers_RenderThread(VisibleLayers);
+		});
+	}
+}
+
+uint8 UDungeonDebugComponent::GetVisibleLayerMask() const
+{
+	const bool bLayerToggles[NumDungeonDebugLayers] = { bDrawGrid, bDrawCellStates, bDrawWalls, bDrawDoorways, bDrawSnapPoints, bDrawForcedPlacements };
+
+	uint8 LayerMask = 0;
+	for (int32 LayerIndex = 0; LayerIndex < NumDungeonDebugLayers; ++LayerIndex)
+	{
+		LayerMask |= bLayerToggles[LayerIndex] ? (1 << LayerIndex) : 0;
+	}
+	return LayerMask;
+}
+
+UMaterialInterface* UDungeonDebugComponent::GetOverlayMaterial() const
+{
+	return GEngine ? GEngine->VertexColorMaterial.Get() : nullptr;
+}
+
+FColor UDungeonDebugComponent::GetColorForCellState(ECellState State) const
+{
+	switch (State)
+	{
+	case ECellState::Unoccupied:
+		return UnoccupiedCellColor;
+	case ECellState::Occupied:
+		return OccupiedCellColor;
+	case ECellState::Reserved:
+		return ReservedCellColor;
+	case ECellState::Excluded:
+		return ExcludedCellColor;
+	default:
+		return FColor::White;
+	}
+}
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/RoomGrid.h"
+
+/** Cell edge layout shared by the UDebugHelpers line batch and the UDungeonDebugComponent overlay */
+namespace DungeonDebugGeometry
+{
+	/** Cell corners in the order SW, SE, NE, NW, as offsets in cells from the cell origin */
+	inline constexpr int32 CornerOffsets[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+	/** The two corners the edge of each EWallDirection runs between */
+	inline constexpr int32 EdgeCorners[4][2] = { { 3, 2 }, { 1, 2 }, { 0, 1 }, { 0, 3 } };
+
+	/** Corners of the cell whose SW corner is CellOrigin (FVector or FVector3f) */
+	template<typename VectorType>
+	void GetCellCorners(const VectorType& CellOrigin, float CellSize, VectorType (&OutCorners)[4])
+	{
+		for (int32 Corner = 0; Corner < 4; ++Corner)
+		{
+			OutCorners[Corner] = CellOrigin + VectorType(CornerOffsets[Corner][0] * CellSize, CornerOffsets[Corner][1] * CellSize, 0.0f);
+		}
+	}
+
+	/**
+	 * Calls AddEdge(StartCorner, EndCorner) for the grid edges a cell draws, so shared edges are drawn once:
+	 * its south and west edges always, its north and east edges only on the room boundary
+	 */
+	template<typename FuncType>
+	void ForEachOwnedGridEdge(const FIntPoint& GridCoord, const TSet<FIntPoint>& CellCoords, FuncType&& AddEdge)
+	{
+		const int32 (&South)[2] = EdgeCorners[static_cast<int32>(EWallDirection::South)];
+		const int32 (&West)[2] = EdgeCorners[static_cast<int32>(EWallDirection::West)];
+		const int32 (&North)[2] = EdgeCorners[static_cast<int32>(EWallDirection::North)];
+		const int32 (&East)[2] = EdgeCorners[static_cast<int32>(EWallDirection::East)];
+
+		AddEdge(South[0], South[1]);
+		AddEdge(West[0], West[1]);
+		if (!CellCoords.Contains(GridCoord + FIntPoint(0, 1)))
+		{
+			AddEdge(North[0], North[1]);
+		}
+		if (!CellCoords.Contains(GridCoord + FIntPoint(1, 0)))
+		{
+			AddEdge(East[0], East[1]);
+		}
+	}
+
+	/** Calls AddEdge(StartCorner, EndCorner) for every edge set in a wall or doorway mask */
+	template<typename FuncType>
+	void ForEachMaskedEdge(uint8 EdgeMask, FuncType&& AddEdge)
+	{
+		for (int32 Direction = 0; Direction < 4; ++Direction)
+		{
+			if (EdgeMask & FRoomGrid::GetEdgeBit(static_cast<EWallDirection>(Direction)))
+			{
+				AddEdge(EdgeCorners[Direction][0], EdgeCorners[Direction][1]);
+			}
+		}
+	}
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+#include "Rooms/MasterRoom.h"
+#include "DungeonManager/DungeonManager.h"
+#include "Generation/RoomBuildCache.h"
+#include "Types/RoomMemoryStats.h"
+
+namespace DungeonGenMemoryReport
+{
+	/** Rooms summed under one floor or room data asset */
+	struct FRoomGroup
+	{
+		int32 NumRooms = 0;
+		FRoomMemoryStats Stats;
+	};
+
+	double ToKB(SIZE_T Bytes)
+	{
+		return Bytes / 1024.0;
+	}
+
+	void LogGroups(FOutputDevice& Ar, const TCHAR* Title, TMap<FString, FRoomGroup>& Groups)
+	{
+		// Most expensive first, so the room types worth optimizing lead the list
+		Groups.ValueSort([](const FRoomGroup& A, const FRoomGroup& B)
+		{
+			return A.Stats.GetTotalBytes() > B.Stats.GetTotalBytes();
+		});
+
+		Ar.Logf(TEXT("%s:"), Title);
+		Ar.Logf(TEXT("  %-32s %6s %8s %10s %10s %10s %10s"), TEXT("Name"), TEXT("Rooms"), TEXT("Cells"), TEXT("Instances"), TEXT("InstKB"), TEXT("AvgKB"), TEXT("TotalKB"));
+		for (const TPair<FString, FRoomGroup>& Group : Groups)
+		{
+			const FRoomMemoryStats& Stats = Group.Value.Stats;
+			Ar.Logf(TEXT("  %-32s %6d %8d %10d %10.1f %10.1f %10.1f"), *Group.Key, Group.Value.NumRooms, Stats.NumCells, Stats.NumInstances,
+				ToKB(Stats.InstanceBytes), ToKB(Stats.GetTotalBytes()) / FMath::Max(Group.Value.NumRooms, 1), ToKB(Stats.GetTotalBytes()));
+		}
+	}
+
+	void DumpMemory(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		TMap<FString, FRoomGroup> Floors;
+		TMap<FString, FRoomGroup> RoomTypes;
+		FRoomMemoryStats Total;
+		int32 NumRooms = 0;
+
+		Ar.Logf(TEXT("DungeonGen memory in %s"), *World->GetName());
+		Ar.Logf(TEXT("Rooms:"));
+		Ar.Logf(TEXT("  %-32s %-24s %5s %6s %6s %6s %9s %8s %8s %8s %8s %8s %8s %9s"), TEXT("Room"), TEXT("RoomData"), TEXT("Floor"), TEXT("Cells"),
+			TEXT("Comps"), TEXT("Pooled"), TEXT("Instances"), TEXT("GridKB"), TEXT("PlanKB"), TEXT("BookKB"), TEXT("CompKB"), TEXT("InstKB"), TEXT("DebugKB"), TEXT("TotalKB"));
+
+		for (TActorIterator<AMasterRoom> It(World); It; ++It)
+		{
+			const AMasterRoom* Room = *It;
+			const FRoomMemoryStats Stats = Room->GetMemoryStats();
+			const FString RoomDataName = Room->RoomData.IsNull() ? FString(TEXT("None")) : Room->RoomData.GetAssetName();
+
+			// Rooms placed by a dungeon manager are grouped by floor; standalone and pooled rooms are not on one
+			const ADungeonManager* Manager = Cast<ADungeonManager>(Room->GetOwner());
+			const int32 FloorIndex = Manager ? Manager->GetRoomFloorIndex(Room) : INDEX_NONE;
+			const FString FloorName = FloorIndex != INDEX_NONE ? FString::Printf(TEXT("%s floor %d"), *Manager->GetName(), FloorIndex) : FString(TEXT("No floor"));
+
+			Ar.Logf(TEXT("  %-32s %-24s %5s %6d %6d %6d %9d %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %9.1f"), *Room->GetName(), *RoomDataName,
+				FloorIndex != INDEX_NONE ? *FString::FromInt(FloorIndex) : TEXT("-"), Stats.NumCells, Stats.NumComponents, Stats.NumPooledComponents,
+				Stats.NumInstances, ToKB(Stats.GridBytes), ToKB(Stats.PlanBytes), ToKB(Stats.BookkeepingBytes), ToKB(Stats.ComponentBytes),
+				ToKB(Stats.InstanceBytes), ToKB(Stats.DebugBytes), ToKB(Stats.GetTotalBytes()));
+
+			for (FRoomGroup* Group : { &Floors.FindOrAdd(FloorName), &RoomTypes.FindOrAdd(RoomDataName) })
+			{
+				++Group->NumRooms;
+				Group->Stats += Stats;
+			}
+			Total += Stats;
+			++NumRooms;
+		}
+
+		LogGroups(Ar, TEXT("Floors"), Floors);
+		LogGroups(Ar, TEXT("Room data"), RoomTypes);
+
+		for (TActorIterator<ADungeonManager> It(World); It; ++It)
+		{
+			Ar.Logf(TEXT("Dungeon manager %s: %.1f KB (seed data, streaming index and room lists)"), *It->GetName(),
+				ToKB(It->GetResourceSizeBytes(EResourceSizeMode::Exclusive)));
+		}
+
+		const FRoomBuildCache& BuildCache = FRoomBuildCache::Get();
+		Ar.Logf(TEXT("Room build cache: %d plans, %.1f KB"), BuildCache.Num(), ToKB(BuildCache.GetAllocatedSize()));
+		Ar.Logf(TEXT("Total: %d rooms, %.1f KB (%.1f KB instance data)"), NumRooms, ToKB(Total.GetTotalBytes()), ToKB(Total.InstanceBytes));
+	}
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpMemoryCommand(
+		TEXT("DungeonGen.DumpMemory"),
+		TEXT("Dumps the memory held by every generated room, summed per floor and per room data asset"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpMemory));
+}
@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Debugging/DungeonGenProfiling.h"
+
+UE_TRACE_CHANNEL_DEFINE(DungeonGenChannel);
+
+CSV_DEFINE_CATEGORY_MODULE(GHCLAUDEDUNGEONGEN_API, DungeonGen, true);
+
+// Underscores become the tag hierarchy: DungeonGen/Solver, DungeonGen/Rooms, DungeonGen/BuildCache
+LLM_DEFINE_TAG(DungeonGen);
+LLM_DEFINE_TAG(DungeonGen_Solver);
+LLM_DEFINE_TAG(DungeonGen_Rooms);
+LLM_DEFINE_TAG(DungeonGen_BuildCache);
+
+DEFINE_STAT(STAT_DungeonGen_RoomsSolved);
+DEFINE_STAT(STAT_DungeonGen_RoomsCommitted);
+DEFINE_STAT(STAT_DungeonGen_CellsProcessed);
+DEFINE_STAT(STAT_DungeonGen_InstancesSpawned);
+DEFINE_STAT(STAT_DungeonGen_AssetsLoaded);
+DEFINE_STAT(STAT_DungeonGen_RejectedForcedPlacements);
@@ -2,13 +2,49 @@
 
 
 #include "DungeonManager/DungeonManager.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+#include "Rooms/MasterRoom.h"
+#include "Data/Room/RoomData.h"
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/RoomBuildCache.h"
+#include "Generation/WeightedAliasSampler.h"
+#include "Generation/DungeonSeed.h"
+#include "Debugging/DungeonGenProfiling.h"
+#include "Libraries/DungeonGenLibrary.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
 
 // Sets default values
 ADungeonManager::ADungeonManager()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Layout and spawning are event driven, nothing to tick
+	PrimaryActorTick.bCanEverTick = false;
 
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootSceneComponent"));
+
+	RoomClass = AMasterRoom::StaticClass();
+	RoomsPerFloor = 20;
+	NumFloors = 1;
+	MasterSeed = 0;
+	bUseRandomSeed = true;
+	GlobalCellSize = 100.0f;
+	RoomSpacing = 1;
+	FloorHeight = 1000.0f;
+	MaxPlacementAttempts = 32;
+	SpatialHashBucketSize = 16;
+	bUseRoomBuildCache = true;
+	bPersistRoomBuildCache = false;
+
+	bStreamRooms = false;
+	StreamInRadius = 5000.0f;
+	StreamOutRadius = 7500.0f;
+	StreamingUpdateInterval = 0.25f;
+	MaxRoomsStreamedInPerUpdate = 4;
+	MaxPooledRooms = 8;
 }
 
 // Called when the game starts or when spawned
@@ -18,10 +54,656 @@ void ADungeonManager::BeginPlay()
 	
 }
 
-// Called every frame
-void ADungeonManager::Tick(float DeltaTime)
+void ADungeonManager::GenerateDungeon()
+{
+	DUNGEONGEN_SCOPE(GenerateDungeon);
+	LLM_SCOPE_BYTAG(DungeonGen);
+
+	// Initialize seed
+	if (bUseRandomSeed)
+	{
+		MasterSeed = FDungeonSeed::MakeRandomSeed();
+	}
+
+	FDungeonSeedData NewSeedData;
+	NewSeedData.MasterSeed = MasterSeed;
+	NewSeedData.RoomsPerFloor = RoomsPerFloor;
+
+	// Every floor seed is derived directly from the master seed, so floors can be laid out independently
+	for (int32 FloorIndex = 0; FloorIndex < NumFloors; ++FloorIndex)
+	{
+		FFloorSeedData& FloorSeedData = NewSeedData.FloorSeeds.AddDefaulted_GetRef();
+		if (!LayoutFloor(FloorIndex, FDungeonSeed::DeriveFloorSeed(MasterSeed, FloorIndex), FloorSeedData))
+		{
+			return;
+		}
+	}
+
+	GenerateFromSeedData(NewSeedData);
+}
+
+void ADungeonManager::GenerateFromSeedData(const FDungeonSeedData& SeedData)
+{
+	DUNGEONGEN_SCOPE(GenerateFromSeedData);
+	LLM_SCOPE_BYTAG(DungeonGen);
+
+	ClearDungeon();
+	CurrentSeedData = SeedData;
+	++GenerationRequestId;
+
+	// In streaming mode nothing is spawned up front
+	UWorld* World = GetWorld();
+	if (bStreamRooms && World && World->IsGameWorld())
+	{
+		BeginStreaming();
+		OnDungeonGenerated.Broadcast(this);
+		return;
+	}
+
+	// Spawn every room and gather its solver input on the game thread (asset resolution touches UObjects)
+	TArray<TWeakObjectPtr<AMasterRoom>> Rooms;
+	TArray<FRoomLayoutInput> LayoutInputs;
+
+	for (const FFloorSeedData& FloorSeedData : CurrentSeedData.FloorSeeds)
+	{
+		for (const FRoomSeedData& RoomSeedData : FloorSeedData.RoomSeeds)
+		{
+			AMasterRoom* Room = SpawnRoom(RoomSeedData, FloorSeedData.FloorIndex);
+
+			FRoomLayoutInput LayoutInput;
+			if (Room && Room->PrepareLayoutInput(LayoutInput))
+			{
+				Rooms.Add(Room);
+				LayoutInputs.Add(MoveTemp(LayoutInput));
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ADungeonManager::GenerateFromSeedData - Spawned %d rooms on %d floors (master seed %d), solving %d layouts"),
+		SpawnedRooms.Num(), CurrentSeedData.FloorSeeds.Num(), CurrentSeedData.MasterSeed, LayoutInputs.Num());
+
+	LaunchRoomSolves(MoveTemp(LayoutInputs), [Rooms = MoveTemp(Rooms)](ADungeonManager& Manager, const TArray<FRoomLayoutInput>& SolvedInputs, const TArray<FRoomBuildPlan>& Plans)
+	{
+		Manager.CommitRoomPlans(Rooms, SolvedInputs, Plans);
+	});
+}
+
+bool ADungeonManager::GenerateFromDungeonCode(const FString& Code)
 {
-	Super::Tick(DeltaTime);
+	FDungeonSeedData DecodedSeedData;
+	if (!UDungeonGenLibrary::DecodeDungeonCode(Code, DecodedSeedData))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADungeonManager::GenerateFromDungeonCode - Invalid dungeon code '%s'"), *Code);
+		return false;
+	}
 
+	// The code only carries the inputs, the layout itself is regenerated
+	MasterSeed = DecodedSeedData.MasterSeed;
+	NumFloors = DecodedSeedData.FloorSeeds.Num();
+	RoomsPerFloor = DecodedSeedData.RoomsPerFloor;
+	bUseRandomSeed = false;
+
+	GenerateDungeon();
+	return true;
+}
+
+FString ADungeonManager::GetDungeonCode() const
+{
+	return UDungeonGenLibrary::EncodeDungeonCode(CurrentSeedData);
+}
+
+void ADungeonManager::LaunchRoomSolves(TArray<FRoomLayoutInput>&& LayoutInputs, TFunction<void(ADungeonManager&, const TArray<FRoomLayoutInput>&, const TArray<FRoomBuildPlan>&)>&& OnSolved)
+{
+	TWeakObjectPtr<ADungeonManager> WeakThis(this);
+	const int32 RequestId = GenerationRequestId;
+	const bool bUseCache = bUseRoomBuildCache;
+	const bool bUseDiskStore = bPersistRoomBuildCache;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, RequestId, LayoutInputs = MoveTemp(LayoutInputs), OnSolved = MoveTemp(OnSolved), bUseCache, bUseDiskStore]() mutable
+	{
+		DUNGEONGEN_SCOPE(SolveRooms);
+
+		// Pure solves, one per room - each only reads its own input, so any thread count gives the same plans
+		TArray<FRoomBuildPlan> Plans;
+		Plans.SetNum(LayoutInputs.Num());
+
+		ParallelFor(LayoutInputs.Num(), [&LayoutInputs, &Plans, bUseCache, bUseDiskStore](int32 Index)
+		{
+			// Cache hits skip the solve and go straight to instancing on commit
+			Plans[Index] = bUseCache ? FRoomBuildCache::Get().FindOrSolve(LayoutInputs[Index], bUseDiskStore) : FRoomLayoutSolver::Solve(LayoutInputs[Index]);
+		});
+
+		// The inputs travel back with the plans so each room records what it was built from
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, OnSolved = MoveTemp(OnSolved), LayoutInputs = MoveTemp(LayoutInputs), Plans = MoveTemp(Plans)]()
+		{
+			ADungeonManager* Manager = WeakThis.Get();
+			if (!Manager || Manager->GenerationRequestId != RequestId)
+			{
+				// Manager destroyed or generation superseded
+				return;
+			}
+
+			OnSolved(*Manager, LayoutInputs, Plans);
+		});
+	});
+}
+
+void ADungeonManager::CommitRoomPlans(const TArray<TWeakObjectPtr<AMasterRoom>>& Rooms, const TArray<FRoomLayoutInput>& LayoutInputs, const TArray<FRoomBuildPlan>& Plans)
+{
+	DUNGEONGEN_SCOPE(CommitRoomPlans);
+	LLM_SCOPE_BYTAG(DungeonGen);
+
+	for (int32 Index = 0; Index < Rooms.Num(); ++Index)
+	{
+		AMasterRoom* Room = Rooms[Index].Get();
+		if (Room && Plans[Index].bSucceeded)
+		{
+			Room->CommitBuildPlan(Plans[Index], LayoutInputs[Index]);
+		}
+	}
+
+	OnDungeonGenerated.Broadcast(this);
+}
+
+void ADungeonManager::ClearDungeon()
+{
+	// Drop any in-flight parallel solve
+	++GenerationRequestId;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(StreamingTimerHandle);
+	}
+
+	for (AMasterRoom* Room : SpawnedRooms)
+	{
+		if (IsValid(Room))
+		{
+			Room->Destroy();
+		}
+	}
+
+	for (AMasterRoom* Room : PooledRooms)
+	{
+		if (IsValid(Room))
+		{
+			Room->Destroy();
+		}
+	}
+
+	SpawnedRooms.Empty();
+	PooledRooms.Empty();
+	StreamedRooms.Empty();
+	StreamingIndex.Reset(SpatialHashBucketSize);
+	ResidentRoomIndices.Empty();
+	LoadingRoomIndices.Empty();
+}
+
+bool ADungeonManager::LayoutFloor(int32 FloorIndex, int32 FloorSeed, FFloorSeedData& OutFloorSeedData) const
+{
+	DUNGEONGEN_SCOPE(LayoutFloor);
+
+	OutFloorSeedData = FFloorSeedData();
+	OutFloorSeedData.FloorIndex = FloorIndex;
+	OutFloorSeedData.FloorSeed = FloorSeed;
+
+	// Resolve the room pool once
+	TArray<const URoomData*> Candidates;
+	TArray<FName> CandidateNames;
+	for (const TSoftObjectPtr<URoomData>& RoomDataPtr : RoomPool)
+	{
+		if (const URoomData* LoadedRoomData = RoomDataPtr.LoadSynchronous())
+		{
+			Candidates.Add(LoadedRoomData);
+			CandidateNames.Add(FName(*RoomDataPtr.ToSoftObjectPath().ToString()));
+		}
+	}
+
+	const FWeightedAliasSampler RoomSampler = FWeightedAliasSampler::FromItems(MakeConstArrayView(Candidates), [](const URoomData* Candidate)
+	{
+		return Candidate->AllowedShapes.Num() > 0 ? Candidate->RoomSelectionWeight : 0.0f;
+	});
+
+	if (RoomSampler.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADungeonManager::LayoutFloor - RoomPool has no loadable RoomData with shapes and a positive RoomSelectionWeight!"));
+		return false;
+	}
+
+	FDungeonSpatialHash SpatialHash(SpatialHashBucketSize);
+	int32 NumSkippedRooms = 0;
+
+	for (int32 RoomIndex = 0; RoomIndex < RoomsPerFloor; ++RoomIndex)
+	{
+		// Each room draws from its own derived stream, so a rejected placement never shifts the rooms after it
+		FRandomStream PlacementStream(FDungeonSeed::Derive(FloorSeed, EDungeonSeedDomain::RoomPlacement, RoomIndex));
+
+		// Pick the room and its seed, then preview the footprint that seed will generate
+		const int32 CandidateIndex = RoomSampler.Sample(PlacementStream);
+		const URoomData* Candidate = Candidates[CandidateIndex];
+		const int32 RoomSeed = FDungeonSeed::DeriveRoomSeed(FloorSeed, RoomIndex);
+
+		const FIntPoint Size = GetRoomFootprintSize(*Candidate, RoomSeed);
+
+		// The first room anchors the floor at the manager's origin
+		bool bPlaced = SpatialHash.Num() == 0;
+		FIntPoint Location = FIntPoint::ZeroValue;
+
+		// Otherwise attach to a random placed room on a random side, sharing at least one cell of edge with it
+		for (int32 Attempt = 0; !bPlaced && Attempt < MaxPlacementAttempts; ++Attempt)
+		{
+			const FIntRect& Parent = SpatialHash.GetFootprint(PlacementStream.RandHelper(SpatialHash.Num()));
+
+			switch (PlacementStream.RandHelper(4))
+			{
+			case 0: // North
+				Location = FIntPoint(PlacementStream.RandRange(Parent.Min.X - Size.X + 1, Parent.Max.X - 1), Parent.Max.Y + RoomSpacing);
+				break;
+			case 1: // East
+				Location = FIntPoint(Parent.Max.X + RoomSpacing, PlacementStream.RandRange(Parent.Min.Y - Size.Y + 1, Parent.Max.Y - 1));
+				break;
+			case 2: // South
+				Location = FIntPoint(PlacementStream.RandRange(Parent.Min.X - Size.X + 1, Parent.Max.X - 1), Parent.Min.Y - RoomSpacing - Size.Y);
+				break;
+			default: // West
+				Location = FIntPoint(Parent.Min.X - RoomSpacing - Size.X, PlacementStream.RandRange(Parent.Min.Y - Size.Y + 1, Parent.Max.Y - 1));
+				break;
+			}
+
+			// Broad phase: only rooms sharing a bucket with the spacing-inflated footprint are tested
+			const FIntRect SpacedFootprint(Location - FIntPoint(RoomSpacing, RoomSpacing), Location + Size + FIntPoint(RoomSpacing, RoomSpacing));
+			bPlaced = !SpatialHash.Overlaps(SpacedFootprint);
+		}
+
+		if (!bPlaced)
+		{
+			++NumSkippedRooms;
+			continue;
+		}
+
+		SpatialHash.Add(FIntRect(Location, Location + Size));
+
+		FRoomSeedData& RoomSeedData = OutFloorSeedData.RoomSeeds.AddDefaulted_GetRef();
+		RoomSeedData.RoomSeed = RoomSeed;
+		RoomSeedData.Location = Location;
+		RoomSeedData.Rotation = 0;
+		RoomSeedData.RoomDataAssetName = CandidateNames[CandidateIndex];
+	}
+
+	if (NumSkippedRooms > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADungeonManager::LayoutFloor - Floor %d: %d of %d rooms found no free position after %d attempts"),
+			FloorIndex, NumSkippedRooms, RoomsPerFloor, MaxPlacementAttempts);
+	}
+
+	return true;
+}
+
+AMasterRoom* ADungeonManager::SpawnRoom(const FRoomSeedData& RoomSeedData, int32 FloorIndex)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	const FTransform SpawnTransform = GetRoomTransform(RoomSeedData, FloorIndex);
+
+	// Configure before construction: the recorded seed, and no self-generation (the manager solves all rooms together)
+	AMasterRoom* Room = World->SpawnActorDeferred<AMasterRoom>(RoomClass ? RoomClass.Get() : AMasterRoom::StaticClass(), SpawnTransform, this);
+	if (!Room)
+	{
+		return nullptr;
+	}
+
+	Room->RoomData = TSoftObjectPtr<URoomData>(FSoftObjectPath(RoomSeedData.RoomDataAssetName.ToString()));
+	Room->GenerationSeed = RoomSeedData.RoomSeed;
+	Room->bUseRandomSeed = false;
+	Room->bGenerateOnSpawn = false;
+	Room->FinishSpawning(SpawnTransform);
+
+	SpawnedRooms.Add(Room);
+	return Room;
+}
+
+FTransform ADungeonManager::GetRoomTransform(const FRoomSeedData& RoomSeedData, int32 FloorIndex) const
+{
+	const FVector RoomLocation = GetActorLocation() + FVector(RoomSeedData.Location.X * GlobalCellSize, RoomSeedData.Location.Y * GlobalCellSize, FloorIndex * FloorHeight);
+	return FTransform(FRotator(0.0f, RoomSeedData.Rotation, 0.0f), RoomLocation);
 }
 
+int32 ADungeonManager::GetRoomFloorIndex(const AMasterRoom* Room) const
+{
+	if (!Room || !SpawnedRooms.Contains(Room))
+	{
+		return INDEX_NONE;
+	}
+
+	// Inverse of GetRoomTransform
+	return FloorHeight > 0.0f ? FMath::RoundToInt((Room->GetActorLocation().Z - GetActorLocation().Z) / FloorHeight) : 0;
+}
+
+void ADungeonManager::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	SIZE_T SeedDataBytes = CurrentSeedData.FloorSeeds.GetAllocatedSize();
+	for (const FFloorSeedData& FloorSeedData : CurrentSeedData.FloorSeeds)
+	{
+		SeedDataBytes += FloorSeedData.RoomSeeds.GetAllocatedSize() + FloorSeedData.HallwaySeeds.GetAllocatedSize() + FloorSeedData.DoorwayPositions.GetAllocatedSize();
+	}
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(SeedDataBytes + SpawnedRooms.GetAllocatedSize() + PooledRooms.GetAllocatedSize()
+		+ StreamedRooms.GetAllocatedSize() + StreamingIndex.GetAllocatedSize() + ResidentRoomIndices.GetAllocatedSize() + LoadingRoomIndices.GetAllocatedSize());
+
+	// Rooms are actors of their own, so they only join the estimated total
+	if (CumulativeResourceSize.GetResourceMode() == EResourceSizeMode::EstimatedTotal)
+	{
+		for (TArray<AMasterRoom*>* Rooms : { &SpawnedRooms, &PooledRooms })
+		{
+			for (AMasterRoom* Room : *Rooms)
+			{
+				if (IsValid(Room))
+				{
+					Room->GetResourceSizeEx(CumulativeResourceSize);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint ADungeonManager::GetRoomFootprintSize(const URoomData& RoomDataAsset, int32 RoomSeed) const
+{
+	FRoomShapeDefinition Shape;
+	FRoomLayoutSolver::SelectShapeForSeed(RoomSeed, RoomDataAsset.AllowedShapes, Shape);
+
+	// Convert the shape's bounding box from the room's cells to global cells
+	const FIntPoint RoomExtents = FRoomLayoutSolver::GetShapeGridExtents(Shape);
+	const float CellScale = RoomDataAsset.GridConfig.CellSize / GlobalCellSize;
+	return FIntPoint(
+		FMath::Max(FMath::CeilToInt(RoomExtents.X * CellScale), 1),
+		FMath::Max(FMath::CeilToInt(RoomExtents.Y * CellScale), 1));
+}
+
+// ========== Streaming ==========
+
+void ADungeonManager::BeginStreaming()
+{
+	StreamingIndex.Reset(SpatialHashBucketSize);
+
+	// Only room definitions are loaded here - each is resolved once, however many rooms use it
+	TMap<FName, const URoomData*> RoomDataByName;
+
+	for (int32 FloorSeedIndex = 0; FloorSeedIndex < CurrentSeedData.FloorSeeds.Num(); ++FloorSeedIndex)
+	{
+		const FFloorSeedData& FloorSeedData = CurrentSeedData.FloorSeeds[FloorSeedIndex];
+		for (int32 RoomIndex = 0; RoomIndex < FloorSeedData.RoomSeeds.Num(); ++RoomIndex)
+		{
+			const FRoomSeedData& RoomSeedData = FloorSeedData.RoomSeeds[RoomIndex];
+
+			const URoomData*& RoomDataAsset = RoomDataByName.FindOrAdd(RoomSeedData.RoomDataAssetName);
+			if (!RoomDataAsset)
+			{
+				RoomDataAsset = TSoftObjectPtr<URoomData>(FSoftObjectPath(RoomSeedData.RoomDataAssetName.ToString())).LoadSynchronous();
+			}
+
+			if (!RoomDataAsset)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ADungeonManager::BeginStreaming - Could not load room data '%s', room skipped"), *RoomSeedData.RoomDataAssetName.ToString());
+				continue;
+			}
+
+			const FIntPoint Size = GetRoomFootprintSize(*RoomDataAsset, RoomSeedData.RoomSeed);
+			const float FloorZ = FloorSeedData.FloorIndex * FloorHeight;
+
+			FStreamedRoom& StreamedRoom = StreamedRooms.AddDefaulted_GetRef();
+			StreamedRoom.FloorIndex = FloorSeedIndex;
+			StreamedRoom.RoomIndex = RoomIndex;
+			StreamedRoom.LocalBounds = FBox(
+				FVector(RoomSeedData.Location.X * GlobalCellSize, RoomSeedData.Location.Y * GlobalCellSize, FloorZ),
+				FVector((RoomSeedData.Location.X + Size.X) * GlobalCellSize, (RoomSeedData.Location.Y + Size.Y) * GlobalCellSize, FloorZ + FloorHeight));
+
+			StreamingIndex.Add(FIntRect(RoomSeedData.Location, RoomSeedData.Location + Size));
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ADungeonManager::BeginStreaming - Indexed %d rooms on %d floors (master seed %d)"),
+		StreamedRooms.Num(), CurrentSeedData.FloorSeeds.Num(), CurrentSeedData.MasterSeed);
+
+	GetWorldTimerManager().SetTimer(StreamingTimerHandle, this, &ADungeonManager::UpdateStreaming, StreamingUpdateInterval, true, 0.0f);
+}
+
+void ADungeonManager::UpdateStreaming()
+{
+	DUNGEONGEN_SCOPE(UpdateStreaming);
+	LLM_SCOPE_BYTAG(DungeonGen);
+
+	if (StreamedRooms.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FVector> SourceLocations;
+	GatherStreamingSourceLocations(SourceLocations);
+
+	auto DistanceSquaredToNearestSource = [&SourceLocations](const FBox& Bounds)
+	{
+		float MinDistanceSquared = TNumericLimits<float>::Max();
+		for (const FVector& SourceLocation : SourceLocations)
+		{
+			MinDistanceSquared = FMath::Min(MinDistanceSquared, static_cast<float>(Bounds.ComputeSquaredDistanceToPoint(SourceLocation)));
+		}
+		return MinDistanceSquared;
+	};
+
+	// Stream out: resident and still loading rooms beyond the outer radius of every source (the gap between the radii is the hysteresis band)
+	const float OutRadius = FMath::Max(StreamOutRadius, StreamInRadius);
+	for (TArray<int32>* RoomIndices : { &ResidentRoomIndices, &LoadingRoomIndices })
+	{
+		for (int32 ListIndex = RoomIndices->Num() - 1; ListIndex >= 0; --ListIndex)
+		{
+			const int32 StreamedRoomIndex = (*RoomIndices)[ListIndex];
+			if (!StreamedRooms[StreamedRoomIndex].Room.IsValid() || DistanceSquaredToNearestSource(StreamedRooms[StreamedRoomIndex].LocalBounds) > FMath::Square(OutRadius))
+			{
+				ReleaseStreamedRoom(StreamedRoomIndex);
+				RoomIndices->RemoveAtSwap(ListIndex);
+			}
+		}
+	}
+
+	// Stream in: only rooms whose footprint lies within the inner radius's cell range are looked at
+	const int32 RadiusInCells = FMath::CeilToInt(StreamInRadius / GlobalCellSize);
+	TArray<int32> CandidateIndices;
+	for (const FVector& SourceLocation : SourceLocations)
+	{
+		const FIntPoint SourceCell(FMath::FloorToInt(SourceLocation.X / GlobalCellSize), FMath::FloorToInt(SourceLocation.Y / GlobalCellSize));
+		StreamingIndex.Query(FIntRect(SourceCell - FIntPoint(RadiusInCells, RadiusInCells), SourceCell + FIntPoint(RadiusInCells + 1, RadiusInCells + 1)), CandidateIndices);
+	}
+
+	TArray<TPair<float, int32>> RoomsToStreamIn;
+	for (int32 StreamedRoomIndex : CandidateIndices)
+	{
+		// Also skips duplicates found through more than one source
+		if (StreamedRooms[StreamedRoomIndex].Room.IsValid() || RoomsToStreamIn.ContainsByPredicate([StreamedRoomIndex](const TPair<float, int32>& Pending) { return Pending.Value == StreamedRoomIndex; }))
+		{
+			continue;
+		}
+
+		const float DistanceSquared = DistanceSquaredToNearestSource(StreamedRooms[StreamedRoomIndex].LocalBounds);
+		if (DistanceSquared <= FMath::Square(StreamInRadius))
+		{
+			RoomsToStreamIn.Emplace(DistanceSquared, StreamedRoomIndex);
+		}
+	}
+
+	if (RoomsToStreamIn.Num() == 0)
+	{
+		return;
+	}
+
+	// Nearest rooms first, the rest wait for the next update
+	RoomsToStreamIn.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	RoomsToStreamIn.SetNum(FMath::Min(RoomsToStreamIn.Num(), MaxRoomsStreamedInPerUpdate));
+
+	for (const TPair<float, int32>& Pending : RoomsToStreamIn)
+	{
+		AMasterRoom* Room = AcquireStreamedRoom(Pending.Value);
+		if (!Room)
+		{
+			continue;
+		}
+
+		LoadingRoomIndices.Add(Pending.Value);
+
+		// Stream the room's assets before touching them, so neither the solver input nor the commit loads from disk on the game thread
+		const int32 StreamedRoomIndex = Pending.Value;
+		const int32 StreamSerial = StreamedRooms[StreamedRoomIndex].StreamSerial;
+		const int32 RequestId = GenerationRequestId;
+		Room->LoadRoomAssetsAsync(FStreamableDelegate::CreateWeakLambda(this, [this, StreamedRoomIndex, StreamSerial, RequestId]()
+		{
+			OnStreamedRoomAssetsLoaded(StreamedRoomIndex, StreamSerial, RequestId);
+		}));
+	}
+}
+
+void ADungeonManager::OnStreamedRoomAssetsLoaded(int32 StreamedRoomIndex, int32 StreamSerial, int32 RequestId)
+{
+	if (RequestId != GenerationRequestId || !StreamedRooms.IsValidIndex(StreamedRoomIndex) || StreamedRooms[StreamedRoomIndex].StreamSerial != StreamSerial)
+	{
+		// Dungeon cleared or room streamed out (and maybe back in) while its assets were loading
+		return;
+	}
+
+	AMasterRoom* Room = StreamedRooms[StreamedRoomIndex].Room.Get();
+	if (!Room || LoadingRoomIndices.RemoveSingleSwap(StreamedRoomIndex) == 0)
+	{
+		return;
+	}
+
+	ResidentRoomIndices.Add(StreamedRoomIndex);
+
+	// Assets are resident now, so resolving the context only finds them
+	FRoomLayoutInput LayoutInput;
+	if (!Room->PrepareLayoutInput(LayoutInput))
+	{
+		return;
+	}
+
+	TArray<FRoomLayoutInput> LayoutInputs;
+	LayoutInputs.Add(MoveTemp(LayoutInput));
+
+	LaunchRoomSolves(MoveTemp(LayoutInputs), [StreamedRoomIndex, StreamSerial](ADungeonManager& Manager, const TArray<FRoomLayoutInput>& SolvedInputs, const TArray<FRoomBuildPlan>& Plans)
+	{
+		Manager.CommitStreamedRoomPlans({ StreamedRoomIndex }, { StreamSerial }, SolvedInputs, Plans);
+	});
+}
+
+void ADungeonManager::GatherStreamingSourceLocations(TArray<FVector>& OutLocations) const
+{
+	const FVector ManagerLocation = GetActorLocation();
+
+	if (UWorld* World = GetWorld())
+	{
+		for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		{
+			if (const APlayerController* PlayerController = Iterator->Get())
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				OutLocations.Add(ViewLocation - ManagerLocation);
+			}
+		}
+	}
+
+	for (const AActor* Source : StreamingSources)
+	{
+		if (IsValid(Source))
+		{
+			OutLocations.Add(Source->GetActorLocation() - ManagerLocation);
+		}
+	}
+}
+
+AMasterRoom* ADungeonManager::AcquireStreamedRoom(int32 StreamedRoomIndex)
+{
+	FStreamedRoom& StreamedRoom = StreamedRooms[StreamedRoomIndex];
+	const FFloorSeedData& FloorSeedData = CurrentSeedData.FloorSeeds[StreamedRoom.FloorIndex];
+	const FRoomSeedData& RoomSeedData = FloorSeedData.RoomSeeds[StreamedRoom.RoomIndex];
+
+	AMasterRoom* Room = nullptr;
+	while (!Room && PooledRooms.Num() > 0)
+	{
+		Room = PooledRooms.Pop(EAllowShrinking::No);
+		Room = IsValid(Room) ? Room : nullptr;
+	}
+
+	if (Room)
+	{
+		// Reuse a pooled actor: same configuration SpawnRoom applies before construction
+		Room->RoomData = TSoftObjectPtr<URoomData>(FSoftObjectPath(RoomSeedData.RoomDataAssetName.ToString()));
+		Room->GenerationSeed = RoomSeedData.RoomSeed;
+		Room->SetActorTransform(GetRoomTransform(RoomSeedData, FloorSeedData.FloorIndex));
+		Room->SetActorHiddenInGame(false);
+		Room->SetActorEnableCollision(true);
+		SpawnedRooms.Add(Room);
+	}
+	else
+	{
+		Room = SpawnRoom(RoomSeedData, FloorSeedData.FloorIndex);
+	}
+
+	StreamedRoom.Room = Room;
+	++StreamedRoom.StreamSerial;
+	return Room;
+}
+
+void ADungeonManager::ReleaseStreamedRoom(int32 StreamedRoomIndex)
+{
+	FStreamedRoom& StreamedRoom = StreamedRooms[StreamedRoomIndex];
+	AMasterRoom* Room = StreamedRoom.Room.Get();
+
+	StreamedRoom.Room.Reset();
+	++StreamedRoom.StreamSerial;
+
+	if (!Room)
+	{
+		return;
+	}
+
+	SpawnedRooms.RemoveSingleSwap(Room);
+	Room->CleanupRoom();
+
+	if (PooledRooms.Num() < MaxPooledRooms)
+	{
+		Room->SetActorHiddenInGame(true);
+		Room->SetActorEnableCollision(false);
+		PooledRooms.Add(Room);
+	}
+	else
+	{
+		Room->Destroy();
+	}
+}
+
+void ADungeonManager::CommitStreamedRoomPlans(const TArray<int32>& StreamedRoomIndices, const TArray<int32>& StreamSerials, const TArray<FRoomLayoutInput>& LayoutInputs, const TArray<FRoomBuildPlan>& Plans)
+{
+	DUNGEONGEN_SCOPE(CommitStreamedRoomPlans);
+	LLM_SCOPE_BYTAG(DungeonGen);
+
+	for (int32 Index = 0; Index < StreamedRoomIndices.Num(); ++Index)
+	{
+		const FStreamedRoom& StreamedRoom = StreamedRooms[StreamedRoomIndices[Index]];
+		if (StreamedRoom.StreamSerial != StreamSerials[Index])
+		{
+			// Streamed out (and maybe back in) since the solve was launched
+			continue;
+		}
+
+		AMasterRoom* Room = StreamedRoom.Room.Get();
+		if (Room && Plans[Index].bSucceeded)
+		{
+			Room->CommitBuildPlan(Plans[Index], LayoutInputs[Index]);
+		}
+	}
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DungeonManager/DungeonSpatialHash.h"
+
+FDungeonSpatialHash::FDungeonSpatialHash(int32 InBucketSize)
+{
+	Reset(InBucketSize);
+}
+
+void FDungeonSpatialHash::Reset(int32 InBucketSize)
+{
+	BucketSize = FMath::Max(InBucketSize, 1);
+	Footprints.Reset();
+	Buckets.Reset();
+}
+
+int32 FDungeonSpatialHash::Add(const FIntRect& Footprint)
+{
+	const int32 Index = Footprints.Add(Footprint);
+
+	const FIntPoint MinBucket = ToBucket(Footprint.Min);
+	const FIntPoint MaxBucket = ToBucket(Footprint.Max - FIntPoint(1, 1));
+
+	for (int32 Y = MinBucket.Y; Y <= MaxBucket.Y; ++Y)
+	{
+		for (int32 X = MinBucket.X; X <= MaxBucket.X; ++X)
+		{
+			Buckets.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+		}
+	}
+
+	return Index;
+}
+
+bool FDungeonSpatialHash::Overlaps(const FIntRect& Footprint) const
+{
+	const FIntPoint MinBucket = ToBucket(Footprint.Min);
+	const FIntPoint MaxBucket = ToBucket(Footprint.Max - FIntPoint(1, 1));
+
+	for (int32 Y = MinBucket.Y; Y <= MaxBucket.Y; ++Y)
+	{
+		for (int32 X = MinBucket.X; X <= MaxBucket.X; ++X)
+		{
+			const TArray<int32, TInlineAllocator<4>>* Bucket = Buckets.Find(FIntPoint(X, Y));
+			if (!Bucket)
+			{
+				continue;
+			}
+
+			for (int32 Index : *Bucket)
+			{
+				if (Intersects(Footprint, Footprints[Index]))
+				{
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void FDungeonSpatialHash::Query(const FIntRect& Region, TArray<int32>& OutIndices) const
+{
+	const FIntPoint MinBucket = ToBucket(Region.Min);
+	const FIntPoint MaxBucket = ToBucket(Region.Max - FIntPoint(1, 1));
+
+	for (int32 Y = MinBucket.Y; Y <= MaxBucket.Y; ++Y)
+	{
+		for (int32 X = MinBucket.X; X <= MaxBucket.X; ++X)
+		{
+			const FIntPoint BucketCoord(X, Y);
+			const TArray<int32, TInlineAllocator<4>>* Bucket = Buckets.Find(BucketCoord);
+			if (!Bucket)
+			{
+				continue;
+			}
+
+			for (int32 Index : *Bucket)
+			{
+				const FIntRect& Other = Footprints[Index];
+				if (!Intersects(Region, Other))
+				{
+					continue;
+				}
+
+				// A footprint spanning several buckets is only reported from the bucket holding the first cell of the intersection
+				const FIntPoint FirstSharedCell(FMath::Max(Region.Min.X, Other.Min.X), FMath::Max(Region.Min.Y, Other.Min.Y));
+				if (ToBucket(FirstSharedCell) == BucketCoord)
+				{
+					OutIndices.Add(Index);
+				}
+			}
+		}
+	}
+}
+
+SIZE_T FDungeonSpatialHash::GetAllocatedSize() const
+{
+	SIZE_T Size = Footprints.GetAllocatedSize() + Buckets.GetAllocatedSize();
+	for (const auto& Bucket : Buckets)
+	{
+		// Only buckets that outgrew their inline storage allocate
+		Size += Bucket.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+FIntPoint FDungeonSpatialHash::ToBucket(const FIntPoint& Cell) const
+{
+	auto FloorDivide = [this](int32 Value)
+	{
+		return Value >= 0 ? Value / BucketSize : (Value - BucketSize + 1) / BucketSize;
+	};
+
+	return FIntPoint(FloorDivide(Cell.X), FloorDivide(Cell.Y));
+}
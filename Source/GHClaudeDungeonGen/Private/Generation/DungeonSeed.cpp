@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generation/DungeonSeed.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+int32 FDungeonSeed::MakeRandomSeed()
+{
+	// A per-process counter keeps seeds distinct even when requested within the same clock tick
+	static std::atomic<uint64> Counter(0);
+	const uint64 Hash = Mix(FPlatformTime::Cycles64() ^ Mix(Counter.fetch_add(1, std::memory_order_relaxed) + 0x9E3779B97F4A7C15ull));
+	return static_cast<int32>(static_cast<uint32>(Hash ^ (Hash >> 32)));
+}
@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generation/FloorTilingSolver.h"
+
+void FFloorTilingSolver::Solve(const FRoomGrid& Grid, TConstArrayView<FMeshPlacementData> Tiles, FRandomStream& RandomStream, TArray<FFloorTilePlacement>& OutPlacements)
+{
+	if (Tiles.Num() == 0 || Grid.Num() == 0)
+	{
+		return;
+	}
+
+	FFloorTilingSolver Solver(Tiles, Grid.GetSize(), RandomStream);
+	if (Solver.Options.Num() == 0)
+	{
+		return;
+	}
+
+	// Split the free region into maximal rectangles on a scratch copy: taken cells leave the Unoccupied state
+	FRoomGrid Remaining = Grid;
+
+	Grid.ForEachCellIndex([&](int32 CellIndex)
+	{
+		if (Remaining.GetCellState(CellIndex) != ECellState::Unoccupied)
+		{
+			return;
+		}
+
+		const FIntPoint BottomLeftCell = Grid.ToCoord(CellIndex);
+
+		// Grow right as far as the row allows, then up while the whole span stays free
+		int32 Width = 1;
+		while (Remaining.IsRectInState(FIntPoint(BottomLeftCell.X + Width, BottomLeftCell.Y), FIntPoint(1, 1), ECellState::Unoccupied))
+		{
+			++Width;
+		}
+
+		int32 Height = 1;
+		while (Remaining.IsRectInState(FIntPoint(BottomLeftCell.X, BottomLeftCell.Y + Height), FIntPoint(Width, 1), ECellState::Unoccupied))
+		{
+			++Height;
+		}
+
+		Remaining.SetRectState(BottomLeftCell, FIntPoint(Width, Height), ECellState::Occupied);
+		Solver.EmitRect(BottomLeftCell, Width, Height, OutPlacements);
+	});
+}
+
+bool FFloorTilingSolver::CanRotate(const FMeshPlacementData& TileData)
+{
+	return TileData.bAllowRotation
+		&& (TileData.PivotType == EMeshPivotType::CenterXY || TileData.PivotType == EMeshPivotType::BottomCenter);
+}
+
+FFloorTilingSolver::FFloorTilingSolver(TConstArrayView<FMeshPlacementData> InTiles, const FIntPoint& InMaxRectSize, FRandomStream& InRandomStream)
+	: Tiles(InTiles)
+	, RandomStream(InRandomStream)
+	, MaxRectSize(InMaxRectSize)
+	, UncoveredCellCost(int64(InMaxRectSize.X) * InMaxRectSize.Y + 1)
+{
+	BuildOptions();
+	Memo.SetNum((MaxRectSize.X + 1) * (MaxRectSize.Y + 1));
+}
+
+void FFloorTilingSolver::BuildOptions()
+{
+	auto AddVariant = [this](const FIntPoint& Size, int32 TileIndex, bool bRotated)
+	{
+		FFootprintOption* Option = Options.FindByPredicate([&Size](const FFootprintOption& Candidate) { return Candidate.Size == Size; });
+		if (!Option)
+		{
+			Option = &Options.AddDefaulted_GetRef();
+			Option->Size = Size;
+		}
+		Option->TileIndices.Add(TileIndex);
+		Option->RotatedFlags.Add(bRotated);
+	};
+
+	for (int32 TileIndex = 0; TileIndex < Tiles.Num(); ++TileIndex)
+	{
+		const FMeshPlacementData& TileData = Tiles[TileIndex];
+		if (TileData.Mesh.IsNull() || TileData.SelectionWeight <= 0.0f || TileData.CellsX < 1 || TileData.CellsY < 1)
+		{
+			continue;
+		}
+
+		AddVariant(FIntPoint(TileData.CellsX, TileData.CellsY), TileIndex, false);
+
+		// Square tiles are rotated in place when emitted, only non-square ones gain a second footprint
+		if (TileData.CellsX != TileData.CellsY && CanRotate(TileData))
+		{
+			AddVariant(FIntPoint(TileData.CellsY, TileData.CellsX), TileIndex, true);
+		}
+	}
+
+	// Largest area first, then widest, so ties in the search resolve the same way every time
+	Options.Sort([](const FFootprintOption& A, const FFootprintOption& B)
+	{
+		const int32 AreaA = A.Size.X * A.Size.Y;
+		const int32 AreaB = B.Size.X * B.Size.Y;
+		return AreaA != AreaB ? AreaA > AreaB : A.Size.X > B.Size.X;
+	});
+
+	for (FFootprintOption& Option : Options)
+	{
+		Option.Sampler = FWeightedAliasSampler::FromItems(MakeConstArrayView(Option.TileIndices), [this](int32 TileIndex)
+		{
+			return Tiles[TileIndex].SelectionWeight;
+		});
+	}
+}
+
+const FFloorTilingSolver::FPackResult& FFloorTilingSolver::Evaluate(int32 Width, int32 Height)
+{
+	FPackResult& Result = Memo[Height * (MaxRectSize.X + 1) + Width];
+	if (Result.Cost != INDEX_NONE)
+	{
+		return Result;
+	}
+
+	// Nothing placed: every cell stays uncovered
+	int64 BestCost = (Width == 0 || Height == 0) ? 0 : UncoveredCellCost * Width * Height;
+	int32 BestOption = INDEX_NONE;
+	bool bBestSplitRightFirst = true;
+
+	for (int32 OptionIndex = 0; OptionIndex < Options.Num() && BestCost > 0; ++OptionIndex)
+	{
+		const FIntPoint& Size = Options[OptionIndex].Size;
+		if (Size.X > Width || Size.Y > Height)
+		{
+			continue;
+		}
+
+		// Fill the bottom-left block with as many copies as fit, then pack the two leftover strips
+		const int32 BlockWidth = (Width / Size.X) * Size.X;
+		const int32 BlockHeight = (Height / Size.Y) * Size.Y;
+		const int64 BlockCost = (Width / Size.X) * (Height / Size.Y);
+
+		const int64 RightFirstCost = BlockCost + Evaluate(Width - BlockWidth, Height).Cost + Evaluate(BlockWidth, Height - BlockHeight).Cost;
+		const int64 TopFirstCost = BlockCost + Evaluate(Width, Height - BlockHeight).Cost + Evaluate(Width - BlockWidth, BlockHeight).Cost;
+
+		if (RightFirstCost < BestCost)
+		{
+			BestCost = RightFirstCost;
+			BestOption = OptionIndex;
+			bBestSplitRightFirst = true;
+		}
+		if (TopFirstCost < BestCost)
+		{
+			BestCost = TopFirstCost;
+			BestOption = OptionIndex;
+			bBestSplitRightFirst = false;
+		}
+	}
+
+	// The memo is sized up front, so Result is still valid after the recursive calls
+	Result.Cost = BestCost;
+	Result.OptionIndex = BestOption;
+	Result.bSplitRightFirst = bBestSplitRightFirst;
+	return Result;
+}
+
+void FFloorTilingSolver::EmitRect(const FIntPoint& BottomLeftCell, int32 Width, int32 Height, TArray<FFloorTilePlacement>& OutPlacements)
+{
+	if (Width == 0 || Height == 0)
+	{
+		return;
+	}
+
+	const FPackResult& Result = Evaluate(Width, Height);
+	if (Result.OptionIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FFootprintOption& Option = Options[Result.OptionIndex];
+	const bool bSplitRightFirst = Result.bSplitRightFirst;
+	const int32 BlockWidth = (Width / Option.Size.X) * Option.Size.X;
+	const int32 BlockHeight = (Height / Option.Size.Y) * Option.Size.Y;
+
+	for (int32 Y = 0; Y < BlockHeight; Y += Option.Size.Y)
+	{
+		for (int32 X = 0; X < BlockWidth; X += Option.Size.X)
+		{
+			EmitTile(Option, BottomLeftCell + FIntPoint(X, Y), OutPlacements);
+		}
+	}
+
+	if (bSplitRightFirst)
+	{
+		EmitRect(BottomLeftCell + FIntPoint(BlockWidth, 0), Width - BlockWidth, Height, OutPlacements);
+		EmitRect(BottomLeftCell + FIntPoint(0, BlockHeight), BlockWidth, Height - BlockHeight, OutPlacements);
+	}
+	else
+	{
+		EmitRect(BottomLeftCell + FIntPoint(0, BlockHeight), Width, Height - BlockHeight, OutPlacements);
+		EmitRect(BottomLeftCell + FIntPoint(BlockWidth, 0), Width - BlockWidth, BlockHeight, OutPlacements);
+	}
+}
+
+void FFloorTilingSolver::EmitTile(const FFootprintOption& Option, const FIntPoint& BottomLeftCell, TArray<FFloorTilePlacement>& OutPlacements)
+{
+	const int32 Variant = Option.Sampler.Sample(RandomStream);
+	const int32 TileIndex = Option.TileIndices[Variant];
+	const bool bRotated = Option.RotatedFlags[Variant];
+	const FMeshPlacementData& TileData = Tiles[TileIndex];
+
+	// Orientations that keep the footprint: a quarter turn is only free for square tiles
+	TArray<float, TInlineAllocator<4>> Yaws;
+	Yaws.Add(bRotated ? 90.0f : 0.0f);
+	if (CanRotate(TileData))
+	{
+		if (TileData.CellsX == TileData.CellsY)
+		{
+			Yaws.Add(90.0f);
+			Yaws.Add(270.0f);
+		}
+		if (TileData.bAllow180Rotation)
+		{
+			Yaws.Add(Yaws[0] + 180.0f);
+		}
+	}
+
+	FFloorTilePlacement& Placement = OutPlacements.AddDefaulted_GetRef();
+	Placement.TileIndex = TileIndex;
+	Placement.BottomLeftCell = BottomLeftCell;
+	Placement.Footprint = Option.Size;
+	Placement.Yaw = Yaws.Num() > 1 ? Yaws[RandomStream.RandHelper(Yaws.Num())] : Yaws[0];
+}
@@ -0,0 +1,484 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generation/RoomBuildCache.h"
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/DungeonSeed.h"
+#include "Debugging/DungeonGenProfiling.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/DungeonGenArchive.h"
+
+// Per-entry header byte
+static constexpr uint8 EntryContainerMask = 0x03;			// ERoomContainer
+static constexpr uint8 EntryQuadrantShift = 2;				// Bits 2-3: yaw / 90 when the rotation is exactly FRotator(0, Quadrant * 90, 0)
+static constexpr uint8 EntryFreeRotationFlag = 0x10;		// Any other rotation, stored as a full quaternion
+static constexpr uint8 EntryScaleFlag = 0x20;				// Non-unit scale, stored as a full vector
+static constexpr uint8 EntryDoubleLocationFlag = 0x40;		// Location needs double precision (otherwise three floats)
+
+// Per-slot grid byte
+static constexpr uint8 CellExistsFlag = 0x80;				// Low bits hold the ECellState, an edge mask byte follows
+
+// ========== Key ==========
+
+template <typename ValueType>
+static void HashValue(FXxHash64Builder& Builder, const ValueType& Value)
+{
+	static_assert(TIsTriviallyCopyable<ValueType>::Value, "Only plain values can be hashed bytewise");
+	Builder.Update(&Value, sizeof(ValueType));
+}
+
+static void HashPath(FXxHash64Builder& Builder, const FSoftObjectPath& Path)
+{
+	const FString PathString = Path.ToString();
+	HashValue(Builder, PathString.Len());
+	Builder.Update(*PathString, PathString.Len() * sizeof(TCHAR));
+}
+
+static void HashPlacement(FXxHash64Builder& Builder, const FMeshPlacementData& Placement)
+{
+	HashPath(Builder, Placement.Mesh.ToSoftObjectPath());
+	HashValue(Builder, Placement.PivotType);
+	HashValue(Builder, Placement.CustomPivotOffset);
+	HashValue(Builder, Placement.CellsX);
+	HashValue(Builder, Placement.CellsY);
+	HashValue(Builder, Placement.SelectionWeight);
+	HashValue(Builder, Placement.bAllowRotation);
+	HashValue(Builder, Placement.bAllow180Rotation);
+}
+
+static void HashPlacements(FXxHash64Builder& Builder, const TArray<FMeshPlacementData>& Placements)
+{
+	HashValue(Builder, Placements.Num());
+	for (const FMeshPlacementData& Placement : Placements)
+	{
+		HashPlacement(Builder, Placement);
+	}
+}
+
+static void HashForcedPlacements(FXxHash64Builder& Builder, const TMap<FIntPoint, FMeshPlacementData>& Placements)
+{
+	// Map order follows insertion and removal history; the same placements must produce the same key
+	TArray<const TPair<FIntPoint, FMeshPlacementData>*> SortedPlacements;
+	SortedPlacements.Reserve(Placements.Num());
+	for (const TPair<FIntPoint, FMeshPlacementData>& Placement : Placements)
+	{
+		SortedPlacements.Add(&Placement);
+	}
+	SortedPlacements.Sort([](const TPair<FIntPoint, FMeshPlacementData>& A, const TPair<FIntPoint, FMeshPlacementData>& B)
+	{
+		return A.Key.Y != B.Key.Y ? A.Key.Y < B.Key.Y : A.Key.X < B.Key.X;
+	});
+
+	HashValue(Builder, Placements.Num());
+	for (const TPair<FIntPoint, FMeshPlacementData>* Placement : SortedPlacements)
+	{
+		HashValue(Builder, Placement->Key);
+		HashPlacement(Builder, Placement->Value);
+	}
+}
+
+static void HashShape(FXxHash64Builder& Builder, const FRoomShapeDefinition& Shape)
+{
+	HashValue(Builder, Shape.ShapeType);
+	HashValue(Builder, Shape.RectWidth);
+	HashValue(Builder, Shape.RectHeight);
+	HashValue(Builder, Shape.CustomLayoutWidth);
+	HashValue(Builder, Shape.CustomLayoutHeight);
+	HashValue(Builder, Shape.CustomCellLayout.Num());
+	Builder.Update(Shape.CustomCellLayout.GetData(), Shape.CustomCellLayout.Num() * sizeof(int32));
+}
+
+// ========== Blob Format ==========
+
+static void SerializePathTable(FArchive& Ar, TArray<FSoftObjectPath>& Paths)
+{
+	int32 NumPaths = Paths.Num();
+	if (!DungeonGenArchive::SerializeCount(Ar, NumPaths))
+	{
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Paths.SetNum(NumPaths);
+	}
+
+	for (FSoftObjectPath& Path : Paths)
+	{
+		FString PathString = Ar.IsSaving() ? Path.ToString() : FString();
+		Ar << PathString;
+		if (Ar.IsLoading())
+		{
+			Path.SetPath(PathString);
+		}
+	}
+}
+
+/** Bounds, then one byte per slot (existence and state) and one edge mask byte per existing cell */
+static void SerializeGrid(FArchive& Ar, FRoomGrid& Grid)
+{
+	FIntPoint MinCoord = Grid.GetMinCoord();
+	FIntPoint Size = Grid.GetSize();
+	DungeonGenArchive::SerializeVarInt(Ar, MinCoord.X);
+	DungeonGenArchive::SerializeVarInt(Ar, MinCoord.Y);
+	DungeonGenArchive::SerializeCount(Ar, Size.X);
+	DungeonGenArchive::SerializeCount(Ar, Size.Y);
+
+	if (Ar.IsError() || static_cast<int64>(Size.X) * Size.Y > DungeonGenArchive::MaxCount)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Grid.Initialize(MinCoord, Size);
+	}
+
+	const int32 NumSlots = Size.X * Size.Y;
+	for (int32 Index = 0; Index < NumSlots && !Ar.IsError(); ++Index)
+	{
+		const FIntPoint GridCoord = Grid.ToCoord(Index);
+
+		uint8 SlotByte = 0;
+		uint8 EdgeMask = 0;
+		if (Ar.IsSaving() && Grid.Contains(GridCoord))
+		{
+			SlotByte = CellExistsFlag | static_cast<uint8>(Grid.GetCellState(Index));
+			EdgeMask = static_cast<uint8>(Grid.GetWallMask(Index) | (Grid.GetDoorwayMask(Index) << 4));
+		}
+
+		Ar << SlotByte;
+		if (!(SlotByte & CellExistsFlag))
+		{
+			continue;
+		}
+		Ar << EdgeMask;
+
+		if (Ar.IsLoading())
+		{
+			Grid.AddCell(GridCoord);
+			Grid.SetCellState(Index, static_cast<ECellState>(SlotByte & 0x03));
+			Grid.SetWallMask(Index, EdgeMask & 0x0F);
+			Grid.SetDoorwayMask(Index, EdgeMask >> 4);
+		}
+	}
+}
+
+/** True if every component survives a round trip through float */
+static bool IsFloatExact(const FVector& Vector)
+{
+	return static_cast<double>(static_cast<float>(Vector.X)) == Vector.X
+		&& static_cast<double>(static_cast<float>(Vector.Y)) == Vector.Y
+		&& static_cast<double>(static_cast<float>(Vector.Z)) == Vector.Z;
+}
+
+/** Rotation the solver builds for a quarter turn (FRotator -> FQuat, so a decoded transform is bit-identical) */
+static FQuat GetQuadrantRotation(int32 Quadrant)
+{
+	return FRotator(0.0f, Quadrant * 90.0f, 0.0f).Quaternion();
+}
+
+static void SerializeEntry(FArchive& Ar, FRoomBuildPlanEntry& Entry, FIntPoint& PreviousCell)
+{
+	FVector Location = Entry.LocalTransform.GetLocation();
+	FQuat Rotation = Entry.LocalTransform.GetRotation();
+	FVector Scale = Entry.LocalTransform.GetScale3D();
+
+	uint8 Header = 0;
+	if (Ar.IsSaving())
+	{
+		Header = static_cast<uint8>(Entry.Container) & EntryContainerMask;
+
+		int32 Quadrant = 0;
+		while (Quadrant < 4 && !(Rotation == GetQuadrantRotation(Quadrant)))
+		{
+			++Quadrant;
+		}
+		Header |= Quadrant < 4 ? static_cast<uint8>(Quadrant << EntryQuadrantShift) : EntryFreeRotationFlag;
+		Header |= Scale == FVector::OneVector ? 0 : EntryScaleFlag;
+		Header |= IsFloatExact(Location) ? 0 : EntryDoubleLocationFlag;
+	}
+
+	Ar << Header;
+
+	// Mesh and material handles (material shifted by one so INDEX_NONE packs as 0)
+	int32 MaterialHandle = Entry.MaterialIndex + 1;
+	DungeonGenArchive::SerializeCount(Ar, Entry.MeshIndex);
+	DungeonGenArchive::SerializeCount(Ar, MaterialHandle);
+
+	// Cells as a delta from the previous entry (entries are solved in scan order)
+	FIntPoint CellDelta = Entry.BottomLeftCell - PreviousCell;
+	DungeonGenArchive::SerializeVarInt(Ar, CellDelta.X);
+	DungeonGenArchive::SerializeVarInt(Ar, CellDelta.Y);
+	DungeonGenArchive::SerializeCount(Ar, Entry.Footprint.X);
+	DungeonGenArchive::SerializeCount(Ar, Entry.Footprint.Y);
+
+	if (Header & EntryDoubleLocationFlag)
+	{
+		Ar << Location.X << Location.Y << Location.Z;
+	}
+	else
+	{
+		FVector3f CompactLocation(Location);
+		Ar << CompactLocation.X << CompactLocation.Y << CompactLocation.Z;
+		Location = FVector(CompactLocation);
+	}
+
+	if (Header & EntryFreeRotationFlag)
+	{
+		Ar << Rotation.X << Rotation.Y << Rotation.Z << Rotation.W;
+	}
+	else if (Ar.IsLoading())
+	{
+		Rotation = GetQuadrantRotation((Header >> EntryQuadrantShift) & 0x03);
+	}
+
+	if (Header & EntryScaleFlag)
+	{
+		Ar << Scale.X << Scale.Y << Scale.Z;
+	}
+	else if (Ar.IsLoading())
+	{
+		Scale = FVector::OneVector;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Entry.Container = static_cast<ERoomContainer>(Header & EntryContainerMask);
+		Entry.MaterialIndex = MaterialHandle - 1;
+		Entry.BottomLeftCell = PreviousCell + CellDelta;
+		Entry.LocalTransform = FTransform(Rotation, Location, Scale);
+	}
+	PreviousCell = Entry.BottomLeftCell;
+}
+
+void FRoomBuildCache::SerializePlan(FArchive& Ar, FRoomBuildPlan& Plan)
+{
+	uint8 Version = FormatVersion;
+	Ar << Version;
+	if (Version != FormatVersion)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	uint32 Seed = static_cast<uint32>(Plan.Seed);
+	Ar << Seed;
+	Plan.Seed = static_cast<int32>(Seed);
+	DungeonGenArchive::SerializeCount(Ar, Plan.NumRejectedForcedPlacements);
+
+	SerializePathTable(Ar, Plan.MeshPaths);
+	SerializePathTable(Ar, Plan.MaterialPaths);
+	SerializeGrid(Ar, Plan.Grid);
+
+	int32 NumEntries = Plan.Entries.Num();
+	if (!DungeonGenArchive::SerializeCount(Ar, NumEntries))
+	{
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Plan.Entries.SetNum(NumEntries);
+	}
+
+	FIntPoint PreviousCell = FIntPoint::ZeroValue;
+	for (FRoomBuildPlanEntry& Entry : Plan.Entries)
+	{
+		SerializeEntry(Ar, Entry, PreviousCell);
+		if (Ar.IsError())
+		{
+			return;
+		}
+
+		// Handles must point into the tables
+		if (Ar.IsLoading() && (!Plan.MeshPaths.IsValidIndex(Entry.MeshIndex)
+			|| (Entry.MaterialIndex != INDEX_NONE && !Plan.MaterialPaths.IsValidIndex(Entry.MaterialIndex))))
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+
+	// Only successful plans are ever cached
+	Plan.bSucceeded = !Ar.IsError();
+}
+
+// ========== Cache ==========
+
+FRoomBuildCache& FRoomBuildCache::Get()
+{
+	static FRoomBuildCache Cache;
+	return Cache;
+}
+
+FRoomBuildCache::FRoomBuildCache()
+	: Blobs(DefaultMaxEntries)
+	, NumHits(0)
+	, NumMisses(0)
+{
+}
+
+FRoomBuildPlan FRoomBuildCache::FindOrSolve(const FRoomLayoutInput& Input, bool bUseDiskStore)
+{
+	const uint64 Key = MakeKey(Input);
+
+	FRoomBuildPlan Plan;
+	if (Find(Key, bUseDiskStore, Plan) && Plan.Seed == Input.Seed)
+	{
+		NumHits.fetch_add(1, std::memory_order_relaxed);
+		return Plan;
+	}
+
+	NumMisses.fetch_add(1, std::memory_order_relaxed);
+	Plan = FRoomLayoutSolver::Solve(Input);
+	Add(Key, Plan, bUseDiskStore);
+	return Plan;
+}
+
+uint64 FRoomBuildCache::MakeKey(const FRoomLayoutInput& Input)
+{
+	// Every field of FRoomLayoutInput the solver reads must be fed in here
+	FXxHash64Builder Builder;
+	HashValue(Builder, FDungeonSeed::GeneratorVersion);
+	HashValue(Builder, FormatVersion);
+	HashValue(Builder, Input.Seed);
+	HashValue(Builder, Input.bUseShapeOverride);
+	if (Input.bUseShapeOverride)
+	{
+		HashShape(Builder, Input.ShapeOverride);
+	}
+	else
+	{
+		HashValue(Builder, Input.AllowedShapes.Num());
+		for (const FRoomShapeDefinition& Shape : Input.AllowedShapes)
+		{
+			HashShape(Builder, Shape);
+		}
+	}
+
+	HashValue(Builder, Input.CellSize);
+	HashPlacements(Builder, Input.FloorTiles);
+	HashPlacements(Builder, Input.WallSegments);
+	HashPlacements(Builder, Input.InnerCorners);
+	HashPlacements(Builder, Input.OuterCorners);
+	HashPlacements(Builder, Input.CeilingTiles);
+	HashValue(Builder, Input.CeilingHeightOffset);
+	HashPath(Builder, Input.FloorMaterial.ToSoftObjectPath());
+	HashPath(Builder, Input.WallMaterial.ToSoftObjectPath());
+	HashPath(Builder, Input.CeilingMaterial.ToSoftObjectPath());
+	HashForcedPlacements(Builder, Input.ForcedFloorPlacements);
+	HashForcedPlacements(Builder, Input.ForcedWallPlacements);
+	HashForcedPlacements(Builder, Input.ForcedCeilingPlacements);
+
+	return Builder.Finalize().Hash;
+}
+
+bool FRoomBuildCache::Find(uint64 Key, bool bUseDiskStore, FRoomBuildPlan& OutPlan)
+{
+	DUNGEONGEN_SCOPE(BuildCacheFind);
+	LLM_SCOPE_BYTAG(DungeonGen_BuildCache);
+
+	TArray<uint8> Blob;
+	{
+		FScopeLock Lock(&Mutex);
+		if (const TArray<uint8>* CachedBlob = Blobs.FindAndTouch(Key))
+		{
+			Blob = *CachedBlob;
+		}
+	}
+
+	if (Blob.Num() > 0)
+	{
+		return ReadBlob(Blob, OutPlan);
+	}
+
+	if (!bUseDiskStore || !FFileHelper::LoadFileToArray(Blob, *GetDiskPath(Key), FILEREAD_Silent) || !ReadBlob(Blob, OutPlan))
+	{
+		return false;
+	}
+
+	// Promote the disk entry so the next lookup stays in memory
+	FScopeLock Lock(&Mutex);
+	Blobs.Add(Key, MoveTemp(Blob));
+	return true;
+}
+
+void FRoomBuildCache::Add(uint64 Key, const FRoomBuildPlan& Plan, bool bUseDiskStore)
+{
+	DUNGEONGEN_SCOPE(BuildCacheAdd);
+	LLM_SCOPE_BYTAG(DungeonGen_BuildCache);
+
+	if (!Plan.bSucceeded)
+	{
+		return;
+	}
+
+	TArray<uint8> Blob;
+	FMemoryWriter Writer(Blob);
+	SerializePlan(Writer, const_cast<FRoomBuildPlan&>(Plan));	// Saving only reads the plan
+
+	if (bUseDiskStore)
+	{
+		// Write to a unique file first so concurrent solves of the same room never leave a torn entry
+		const FString DiskPath = GetDiskPath(Key);
+		const FString TempPath = FPaths::CreateTempFilename(*FPaths::GetPath(DiskPath), TEXT("RoomBuild"), TEXT(".tmp"));
+		if (FFileHelper::SaveArrayToFile(Blob, *TempPath) && !IFileManager::Get().Move(*DiskPath, *TempPath, true))
+		{
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+		}
+	}
+
+	FScopeLock Lock(&Mutex);
+	Blobs.Add(Key, MoveTemp(Blob));
+}
+
+void FRoomBuildCache::Empty(int32 MaxEntries)
+{
+	FScopeLock Lock(&Mutex);
+	Blobs.Empty(FMath::Max(MaxEntries, 1));
+}
+
+int32 FRoomBuildCache::Num() const
+{
+	FScopeLock Lock(&Mutex);
+	return Blobs.Num();
+}
+
+SIZE_T FRoomBuildCache::GetAllocatedSize() const
+{
+	FScopeLock Lock(&Mutex);
+
+	SIZE_T Size = 0;
+	for (TLruCache<uint64, TArray<uint8>>::TConstIterator It(Blobs); It; ++It)
+	{
+		Size += It.Value().GetAllocatedSize();
+	}
+	return Size;
+}
+
+FString FRoomBuildCache::GetDiskPath(uint64 Key)
+{
+	return FPaths::ProjectSavedDir() / TEXT("DungeonGen/RoomBuildCache") / FString::Printf(TEXT("%016llx.bin"), Key);
+}
+
+bool FRoomBuildCache::ReadBlob(const TArray<uint8>& Blob, FRoomBuildPlan& OutPlan)
+{
+	FMemoryReader Reader(Blob);
+	FRoomBuildPlan Plan;
+	SerializePlan(Reader, Plan);
+
+	if (Reader.IsError() || !Reader.AtEnd())
+	{
+		return false;
+	}
+
+	OutPlan = MoveTemp(Plan);
+	return true;
+}
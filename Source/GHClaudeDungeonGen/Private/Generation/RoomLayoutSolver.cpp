@@ -0,0 +1,1000 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/WeightedAliasSampler.h"
+#include "Generation/FloorTilingSolver.h"
+#include "Generation/DungeonSeed.h"
+#include "Debugging/DungeonGenProfiling.h"
+#include "UObject/Class.h"
+#include "HAL/PlatformTime.h"
+
+FRoomBuildPlan FRoomLayoutSolver::Solve(const FRoomLayoutInput& Input, FRoomLayoutSolveTimings* OutTimings)
+{
+	return Run(Input, nullptr, FIntRect(), OutTimings);
+}
+
+FRoomBuildPlan FRoomLayoutSolver::SolveIncremental(const FRoomLayoutInput& Input, const FRoomBuildPlan& PreviousPlan, const FIntRect& DirtyRegion)
+{
+	return Run(Input, &PreviousPlan, DirtyRegion);
+}
+
+FRoomBuildPlan FRoomLayoutSolver::Run(const FRoomLayoutInput& Input, const FRoomBuildPlan* PreviousPlan, const FIntRect& DirtyRegion, FRoomLayoutSolveTimings* OutTimings)
+{
+	DUNGEONGEN_SCOPE(Solve);
+	LLM_SCOPE_BYTAG(DungeonGen_Solver);
+
+	FRoomBuildPlan Plan;
+	Plan.Seed = Input.Seed;
+
+	FRoomLayoutSolver Solver(Input, Plan);
+	Solver.PreviousPlan = PreviousPlan;
+	Solver.DirtyRegion = DirtyRegion;
+
+	// The clock is only read when timings were requested
+	double PassStartTime = OutTimings ? FPlatformTime::Seconds() : 0.0;
+	auto EndPass = [OutTimings, &PassStartTime](double FRoomLayoutSolveTimings::* PassSeconds)
+	{
+		if (OutTimings)
+		{
+			const double Now = FPlatformTime::Seconds();
+			OutTimings->*PassSeconds = Now - PassStartTime;
+			PassStartTime = Now;
+		}
+	};
+
+	// Select shape definition
+	FRoomShapeDefinition SelectedShape;
+	Solver.BeginPass(EDungeonSeedDomain::Shape);
+	if (!Solver.SelectShape(SelectedShape))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRoomLayoutSolver::Solve - No allowed shapes defined in RoomData!"));
+		return Plan;
+	}
+	EndPass(&FRoomLayoutSolveTimings::ShapeSeconds);
+
+	// Initialize grid based on selected shape
+	Solver.InitializeGrid(SelectedShape);
+	EndPass(&FRoomLayoutSolveTimings::GridSeconds);
+
+	// Apply forced placements first (they take priority)
+	Solver.ApplyForcedPlacements();
+	EndPass(&FRoomLayoutSolveTimings::ForcedPlacementSeconds);
+
+	// Solve room components (each pass draws from its own derived stream)
+	Solver.BeginPass(EDungeonSeedDomain::FloorTiles);
+	Solver.SolveFloor();
+	EndPass(&FRoomLayoutSolveTimings::FloorSeconds);
+	Solver.BeginPass(EDungeonSeedDomain::Walls);
+	Solver.SolveWalls();
+	EndPass(&FRoomLayoutSolveTimings::WallSeconds);
+	Solver.BeginPass(EDungeonSeedDomain::Ceiling);
+	Solver.SolveCeiling();
+	EndPass(&FRoomLayoutSolveTimings::CeilingSeconds);
+
+	DUNGEONGEN_COUNTER_ADD(RoomsSolved, 1);
+	DUNGEONGEN_COUNTER_ADD(CellsProcessed, Plan.Grid.Num());
+	DUNGEONGEN_COUNTER_ADD(RejectedForcedPlacements, Plan.NumRejectedForcedPlacements);
+
+	Plan.bSucceeded = true;
+	return Plan;
+}
+
+FIntPoint FRoomLayoutSolver::GetShapeGridExtents(const FRoomShapeDefinition& ShapeDefinition)
+{
+	switch (ShapeDefinition.ShapeType)
+	{
+	case ERoomShape::Custom:
+		return FIntPoint(ShapeDefinition.CustomLayoutWidth, ShapeDefinition.CustomLayoutHeight);
+
+	case ERoomShape::LShape:
+		return FIntPoint(ShapeDefinition.RectWidth + FMath::Max(1, ShapeDefinition.RectWidth / 2), ShapeDefinition.RectHeight);
+
+	case ERoomShape::TShape:
+		return FIntPoint(ShapeDefinition.RectWidth, ShapeDefinition.RectHeight + FMath::Max(1, ShapeDefinition.RectHeight / 3));
+
+	default:
+		return FIntPoint(ShapeDefinition.RectWidth, ShapeDefinition.RectHeight);
+	}
+}
+
+FRoomLayoutSolver::FRoomLayoutSolver(const FRoomLayoutInput& InInput, FRoomBuildPlan& OutPlan)
+	: Input(InInput)
+	, Plan(OutPlan)
+	, Grid(OutPlan.Grid)
+	, RandomStream(InInput.Seed)
+{
+}
+
+void FRoomLayoutSolver::BeginPass(EDungeonSeedDomain Pass)
+{
+	RandomStream.Initialize(FDungeonSeed::Derive(Input.Seed, Pass));
+}
+
+bool FRoomLayoutSolver::ResolveShape(const FRoomLayoutInput& Input, FRoomShapeDefinition& OutShape)
+{
+	if (Input.bUseShapeOverride)
+	{
+		OutShape = Input.ShapeOverride;
+		return true;
+	}
+	return SelectShapeForSeed(Input.Seed, Input.AllowedShapes, OutShape);
+}
+
+bool FRoomLayoutSolver::FindDirtyRegion(const FRoomLayoutInput& PreviousInput, const FRoomLayoutInput& Input, const FRoomBuildPlan& PreviousPlan, FIntRect& OutDirtyRegion)
+{
+	OutDirtyRegion = FIntRect();
+
+	// Kept tiles reuse their previous transforms, so anything that moves every tile needs a full solve
+	if (!PreviousPlan.bSucceeded || PreviousInput.Seed != Input.Seed || PreviousInput.CellSize != Input.CellSize
+		|| PreviousInput.CeilingHeightOffset != Input.CeilingHeightOffset)
+	{
+		return false;
+	}
+
+	FRoomShapeDefinition PreviousShape;
+	FRoomShapeDefinition Shape;
+	if (!ResolveShape(PreviousInput, PreviousShape) || !ResolveShape(Input, Shape))
+	{
+		return false;
+	}
+
+	const FIntPoint Extents = GetShapeGridExtents(Shape);
+	const UScriptStruct* ShapeStruct = FRoomShapeDefinition::StaticStruct();
+	const UScriptStruct* PlacementStruct = FMeshPlacementData::StaticStruct();
+
+	bool bHasDirtyCells = false;
+	auto AddDirtyRect = [&OutDirtyRegion, &bHasDirtyCells](const FIntPoint& BottomLeftCell, const FIntPoint& Footprint)
+	{
+		const FIntRect Rect(BottomLeftCell, BottomLeftCell + Footprint);
+		OutDirtyRegion = bHasDirtyCells ? FIntRect(OutDirtyRegion.Min.ComponentMin(Rect.Min), OutDirtyRegion.Max.ComponentMax(Rect.Max)) : Rect;
+		bHasDirtyCells = true;
+	};
+
+	// Shape: only a custom layout of the same size can change cell by cell
+	if (!ShapeStruct->CompareScriptStruct(&PreviousShape, &Shape, PPF_None))
+	{
+		const int32 NumLayoutCells = Shape.CustomLayoutWidth * Shape.CustomLayoutHeight;
+		if (Shape.ShapeType != ERoomShape::Custom || PreviousShape.ShapeType != ERoomShape::Custom || Extents != GetShapeGridExtents(PreviousShape)
+			|| Shape.CustomCellLayout.Num() != NumLayoutCells || PreviousShape.CustomCellLayout.Num() != NumLayoutCells)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < NumLayoutCells; ++Index)
+		{
+			if (Shape.CustomCellLayout[Index] != PreviousShape.CustomCellLayout[Index])
+			{
+				AddDirtyRect(FIntPoint(Index % Shape.CustomLayoutWidth, Index / Shape.CustomLayoutWidth), FIntPoint(1, 1));
+			}
+		}
+	}
+
+	// Forced placements: the old and new footprint of every added, removed or edited entry
+	auto AddChangedForcedPlacements = [&](const TMap<FIntPoint, FMeshPlacementData>& PreviousPlacements, const TMap<FIntPoint, FMeshPlacementData>& Placements)
+	{
+		for (const auto& Placement : Placements)
+		{
+			const FMeshPlacementData* PreviousData = PreviousPlacements.Find(Placement.Key);
+			if (!PreviousData || !PlacementStruct->CompareScriptStruct(PreviousData, &Placement.Value, PPF_None))
+			{
+				AddDirtyRect(Placement.Key, FIntPoint(Placement.Value.CellsX, Placement.Value.CellsY));
+				if (PreviousData)
+				{
+					AddDirtyRect(Placement.Key, FIntPoint(PreviousData->CellsX, PreviousData->CellsY));
+				}
+			}
+		}
+
+		for (const auto& PreviousPlacement : PreviousPlacements)
+		{
+			if (!Placements.Contains(PreviousPlacement.Key))
+			{
+				AddDirtyRect(PreviousPlacement.Key, FIntPoint(PreviousPlacement.Value.CellsX, PreviousPlacement.Value.CellsY));
+			}
+		}
+	};
+
+	AddChangedForcedPlacements(PreviousInput.ForcedFloorPlacements, Input.ForcedFloorPlacements);
+	AddChangedForcedPlacements(PreviousInput.ForcedWallPlacements, Input.ForcedWallPlacements);
+	AddChangedForcedPlacements(PreviousInput.ForcedCeilingPlacements, Input.ForcedCeilingPlacements);
+
+	// Tile entries: the cells of every tile whose entry was edited or removed. A new mesh could go anywhere, so it dirties the whole room
+	auto AddChangedTiles = [&](const TArray<FMeshPlacementData>& PreviousTiles, const TArray<FMeshPlacementData>& Tiles, ERoomContainer Container)
+	{
+		auto ContainsIdentical = [PlacementStruct](const TArray<FMeshPlacementData>& Candidates, const FMeshPlacementData& TileData)
+		{
+			return Candidates.ContainsByPredicate([PlacementStruct, &TileData](const FMeshPlacementData& Candidate)
+			{
+				return PlacementStruct->CompareScriptStruct(&Candidate, &TileData, PPF_None);
+			});
+		};
+
+		for (const FMeshPlacementData& TileData : Tiles)
+		{
+			if (!ContainsIdentical(PreviousTiles, TileData)
+				&& !PreviousTiles.ContainsByPredicate([&TileData](const FMeshPlacementData& Candidate) { return Candidate.Mesh == TileData.Mesh; }))
+			{
+				return false;
+			}
+		}
+
+		TSet<FSoftObjectPath> ChangedMeshPaths;
+		for (const FMeshPlacementData& PreviousTileData : PreviousTiles)
+		{
+			if (!ContainsIdentical(Tiles, PreviousTileData))
+			{
+				ChangedMeshPaths.Add(PreviousTileData.Mesh.ToSoftObjectPath());
+			}
+		}
+
+		for (const FRoomBuildPlanEntry& Entry : PreviousPlan.Entries)
+		{
+			if (Entry.Container == Container && ChangedMeshPaths.Contains(PreviousPlan.MeshPaths[Entry.MeshIndex]))
+			{
+				AddDirtyRect(Entry.BottomLeftCell, Entry.Footprint);
+			}
+		}
+		return true;
+	};
+
+	if (!AddChangedTiles(PreviousInput.FloorTiles, Input.FloorTiles, ERoomContainer::Floor)
+		|| !AddChangedTiles(PreviousInput.CeilingTiles, Input.CeilingTiles, ERoomContainer::Ceiling))
+	{
+		return false;
+	}
+
+	// Wall and material changes need no dirty cells: walls are always solved in full, and kept tiles take the current materials
+
+	if (bHasDirtyCells)
+	{
+		// One cell of neighbourhood, so tiles touching the change can re-tile around it
+		OutDirtyRegion = FIntRect(
+			(OutDirtyRegion.Min - FIntPoint(1, 1)).ComponentMax(FIntPoint::ZeroValue),
+			(OutDirtyRegion.Max + FIntPoint(1, 1)).ComponentMin(Extents));
+	}
+
+	return true;
+}
+
+bool FRoomLayoutSolver::SelectShape(FRoomShapeDefinition& OutShape)
+{
+	DUNGEONGEN_SCOPE(SelectShape);
+
+	if (Input.bUseShapeOverride)
+	{
+		OutShape = Input.ShapeOverride;
+		return true;
+	}
+
+	return PickShape(RandomStream, Input.AllowedShapes, OutShape);
+}
+
+bool FRoomLayoutSolver::SelectShapeForSeed(int32 Seed, const TArray<FRoomShapeDefinition>& AllowedShapes, FRoomShapeDefinition& OutShape)
+{
+	// The shape pass has its own derived stream, so it can be reproduced without solving the room
+	FRandomStream ShapeStream(FDungeonSeed::Derive(Seed, EDungeonSeedDomain::Shape));
+	return PickShape(ShapeStream, AllowedShapes, OutShape);
+}
+
+bool FRoomLayoutSolver::PickShape(FRandomStream& Stream, const TArray<FRoomShapeDefinition>& AllowedShapes, FRoomShapeDefinition& OutShape)
+{
+	if (AllowedShapes.Num() > 0)
+	{
+		// Pick a random allowed shape
+		int32 ShapeIndex = Stream.RandRange(0, AllowedShapes.Num() - 1);
+		OutShape = AllowedShapes[ShapeIndex];
+		return true;
+	}
+
+	return false;
+}
+
+void FRoomLayoutSolver::InitializeGrid(const FRoomShapeDefinition& ShapeDefinition)
+{
+	DUNGEONGEN_SCOPE(InitializeGrid);
+
+	// Allocate the dense bounding box for this shape up front
+	Grid.Initialize(FIntPoint::ZeroValue, GetShapeGridExtents(ShapeDefinition));
+
+	// World positions are derived from coordinates on demand, so only the cell itself is recorded
+	auto AddCell = [this](int32 X, int32 Y)
+	{
+		Grid.AddCell(FIntPoint(X, Y));
+	};
+
+	// Generate grid based on shape type
+	switch (ShapeDefinition.ShapeType)
+	{
+	case ERoomShape::Rectangle:
+		{
+			// Simple rectangular grid
+			for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
+			{
+				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+		}
+		break;
+
+	case ERoomShape::Custom:
+		{
+			// Custom shape from layout array
+			if (ShapeDefinition.CustomCellLayout.Num() == ShapeDefinition.CustomLayoutWidth * ShapeDefinition.CustomLayoutHeight)
+			{
+				for (int32 Y = 0; Y < ShapeDefinition.CustomLayoutHeight; ++Y)
+				{
+					for (int32 X = 0; X < ShapeDefinition.CustomLayoutWidth; ++X)
+					{
+						int32 Index = Y * ShapeDefinition.CustomLayoutWidth + X;
+						if (ShapeDefinition.CustomCellLayout[Index] == 1)
+						{
+							AddCell(X, Y);
+						}
+					}
+				}
+			}
+		}
+		break;
+
+	case ERoomShape::LShape:
+		{
+			// L-Shape: Main rectangle + one extension
+			// Main section
+			for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
+			{
+				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+			// Extension (simplified - extends from bottom-right)
+			// In a full implementation, this would use FShapeTemplate
+			// For now, extend by half the width to the right
+			int32 ExtensionWidth = FMath::Max(1, ShapeDefinition.RectWidth / 2);
+			int32 ExtensionHeight = FMath::Max(1, ShapeDefinition.RectHeight / 2);
+			for (int32 Y = 0; Y < ExtensionHeight; ++Y)
+			{
+				for (int32 X = ShapeDefinition.RectWidth; X < ShapeDefinition.RectWidth + ExtensionWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+		}
+		break;
+
+	case ERoomShape::TShape:
+		{
+			// T-Shape: Main rectangle + extensions on two opposite sides
+			// Main section
+			for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
+			{
+				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+			// Top extension
+			int32 ExtensionWidth = FMath::Max(1, ShapeDefinition.RectWidth / 3);
+			int32 ExtensionHeight = FMath::Max(1, ShapeDefinition.RectHeight / 3);
+			int32 ExtensionStartX = (ShapeDefinition.RectWidth - ExtensionWidth) / 2;
+			for (int32 Y = ShapeDefinition.RectHeight; Y < ShapeDefinition.RectHeight + ExtensionHeight; ++Y)
+			{
+				for (int32 X = ExtensionStartX; X < ExtensionStartX + ExtensionWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+		}
+		break;
+
+	case ERoomShape::UShape:
+		{
+			// U-Shape: Main rectangle + extensions on three sides
+			// Main section (bottom bar of U)
+			for (int32 Y = 0; Y < ShapeDefinition.RectHeight / 3; ++Y)
+			{
+				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+			// Left vertical extension
+			int32 ExtensionWidth = ShapeDefinition.RectWidth / 3;
+			for (int32 Y = ShapeDefinition.RectHeight / 3; Y < ShapeDefinition.RectHeight; ++Y)
+			{
+				for (int32 X = 0; X < ExtensionWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+			// Right vertical extension
+			for (int32 Y = ShapeDefinition.RectHeight / 3; Y < ShapeDefinition.RectHeight; ++Y)
+			{
+				for (int32 X = ShapeDefinition.RectWidth - ExtensionWidth; X < ShapeDefinition.RectWidth; ++X)
+				{
+					AddCell(X, Y);
+				}
+			}
+		}
+		break;
+
+	default:
+		// Default to rectangle for any unknown shape type
+		UE_LOG(LogTemp, Warning, TEXT("FRoomLayoutSolver::InitializeGrid - Unknown shape type, defaulting to rectangle"));
+		for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
+		{
+			for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
+			{
+				AddCell(X, Y);
+			}
+		}
+		break;
+	}
+}
+
+bool FRoomLayoutSolver::ApplyForcedPlacements()
+{
+	DUNGEONGEN_SCOPE(ApplyForcedPlacements);
+
+	auto ApplyPlacements = [this](const TMap<FIntPoint, FMeshPlacementData>& Placements, ERoomContainer Container, const TCHAR* PlacementKind)
+	{
+		for (const auto& Placement : Placements)
+		{
+			const FIntPoint& BottomLeftCell = Placement.Key;
+			const FMeshPlacementData& PlacementData = Placement.Value;
+
+			// Check for overlaps
+			if (CheckFootprintOverlap(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("FRoomLayoutSolver::ApplyForcedPlacements - Forced %s placement at (%d, %d) overlaps existing placement. Rejecting."),
+					PlacementKind, BottomLeftCell.X, BottomLeftCell.Y);
+				++Plan.NumRejectedForcedPlacements;
+				continue;
+			}
+
+			// Reserve cells and place mesh
+			if (ReserveCellsForFootprint(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
+			{
+				TryPlaceMultiCellMesh(BottomLeftCell, PlacementData, Container, true);
+			}
+		}
+	};
+
+	ApplyPlacements(Input.ForcedFloorPlacements, ERoomContainer::Floor, TEXT("floor"));
+	ApplyPlacements(Input.ForcedWallPlacements, ERoomContainer::Wall, TEXT("wall"));
+	ApplyPlacements(Input.ForcedCeilingPlacements, ERoomContainer::Ceiling, TEXT("ceiling"));
+
+	return Plan.NumRejectedForcedPlacements == 0;
+}
+
+void FRoomLayoutSolver::SolveFloor()
+{
+	DUNGEONGEN_SCOPE(SolveFloor);
+
+	if (Input.FloorTiles.Num() == 0)
+	{
+		return;
+	}
+
+	// An incremental solve keeps the previous tiles outside the dirty region
+	KeepPreviousEntries(ERoomContainer::Floor, Grid, ECellState::Unoccupied, ECellState::Occupied);
+
+	// Cover every free cell (forced placements are already occupied) with the fewest tiles
+	TArray<FFloorTilePlacement> TilePlacements;
+	FFloorTilingSolver::Solve(Grid, Input.FloorTiles, RandomStream, TilePlacements);
+
+	for (const FFloorTilePlacement& TilePlacement : TilePlacements)
+	{
+		// Pivot offsets follow the footprint as placed (rotation only happens for footprint-centered pivots)
+		FMeshPlacementData OrientedTile = Input.FloorTiles[TilePlacement.TileIndex];
+		OrientedTile.CellsX = TilePlacement.Footprint.X;
+		OrientedTile.CellsY = TilePlacement.Footprint.Y;
+
+		FVector BasePosition = GetLocalPositionForCell(TilePlacement.BottomLeftCell);
+		FVector PivotOffset = CalculatePivotOffset(OrientedTile);
+		AddEntry(OrientedTile.Mesh, ERoomContainer::Floor, FTransform(FRotator(0.0f, TilePlacement.Yaw, 0.0f), BasePosition + PivotOffset),
+			TilePlacement.BottomLeftCell, TilePlacement.Footprint);
+
+		// Mark cells as occupied
+		Grid.SetRectState(TilePlacement.BottomLeftCell, TilePlacement.Footprint, ECellState::Occupied);
+	}
+}
+
+void FRoomLayoutSolver::SolveWalls()
+{
+	DUNGEONGEN_SCOPE(SolveWalls);
+
+	if (Input.WallSegments.Num() == 0 && Input.InnerCorners.Num() == 0 && Input.OuterCorners.Num() == 0)
+	{
+		return;
+	}
+
+	// First, detect which cells need walls (cells at the edge of the room)
+	// If neighbor doesn't exist or is unoccupied, we need a wall
+	auto NeedsWall = [this](const FIntPoint& NeighborCoord)
+	{
+		return !IsInteriorCell(NeighborCoord);
+	};
+
+	Grid.ForEachCellIndex([&](int32 CellIndex)
+	{
+		// Only consider occupied cells
+		if (Grid.GetCellState(CellIndex) != ECellState::Occupied)
+		{
+			return;
+		}
+
+		// Check each direction to see if we need a wall
+		const FIntPoint CellCoord = Grid.ToCoord(CellIndex);
+		uint8 WallMask = 0;
+
+		if (NeedsWall(FIntPoint(CellCoord.X, CellCoord.Y + 1)))
+		{
+			WallMask |= FRoomGrid::GetEdgeBit(EWallDirection::North);
+		}
+		if (NeedsWall(FIntPoint(CellCoord.X + 1, CellCoord.Y)))
+		{
+			WallMask |= FRoomGrid::GetEdgeBit(EWallDirection::East);
+		}
+		if (NeedsWall(FIntPoint(CellCoord.X, CellCoord.Y - 1)))
+		{
+			WallMask |= FRoomGrid::GetEdgeBit(EWallDirection::South);
+		}
+		if (NeedsWall(FIntPoint(CellCoord.X - 1, CellCoord.Y)))
+		{
+			WallMask |= FRoomGrid::GetEdgeBit(EWallDirection::West);
+		}
+
+		Grid.SetWallMask(CellIndex, WallMask);
+	});
+
+	// Merge exposed edges into straight runs, then cover each run with as few segments as possible
+	TArray<FWallRun> WallRuns;
+	ExtractWallRuns(WallRuns);
+	PlaceWallRuns(WallRuns);
+
+	// Corner pieces go on the outline's convex and concave vertices
+	PlaceWallCorners();
+}
+
+void FRoomLayoutSolver::ExtractWallRuns(TArray<FWallRun>& OutRuns) const
+{
+	const FIntPoint MinCoord = Grid.GetMinCoord();
+	const FIntPoint GridSize = Grid.GetSize();
+
+	auto HasExposedEdge = [this](const FIntPoint& CellCoord, EWallDirection Direction)
+	{
+		const int32 CellIndex = Grid.FindIndex(CellCoord);
+		return CellIndex != INDEX_NONE
+			&& Grid.GetCellState(CellIndex) == ECellState::Occupied
+			&& Grid.HasWall(CellIndex, Direction)
+			&& !Grid.HasDoorway(CellIndex, Direction);
+	};
+
+	// Walks one line of cells and emits a run for every contiguous stretch of exposed edges
+	auto ScanLine = [&](EWallDirection Direction, const FIntPoint& LineStart, const FIntPoint& Step, int32 LineLength)
+	{
+		int32 RunStart = INDEX_NONE;
+		for (int32 Offset = 0; Offset <= LineLength; ++Offset)
+		{
+			const bool bExposed = Offset < LineLength && HasExposedEdge(LineStart + Step * Offset, Direction);
+			if (bExposed && RunStart == INDEX_NONE)
+			{
+				RunStart = Offset;
+			}
+			else if (!bExposed && RunStart != INDEX_NONE)
+			{
+				FWallRun& Run = OutRuns.AddDefaulted_GetRef();
+				Run.Direction = Direction;
+				Run.StartCell = LineStart + Step * RunStart;
+				Run.Length = Offset - RunStart;
+				RunStart = INDEX_NONE;
+			}
+		}
+	};
+
+	// North and south edges run along X, east and west edges along Y
+	for (int32 Y = MinCoord.Y; Y < MinCoord.Y + GridSize.Y; ++Y)
+	{
+		ScanLine(EWallDirection::North, FIntPoint(MinCoord.X, Y), FIntPoint(1, 0), GridSize.X);
+		ScanLine(EWallDirection::South, FIntPoint(MinCoord.X, Y), FIntPoint(1, 0), GridSize.X);
+	}
+
+	for (int32 X = MinCoord.X; X < MinCoord.X + GridSize.X; ++X)
+	{
+		ScanLine(EWallDirection::East, FIntPoint(X, MinCoord.Y), FIntPoint(0, 1), GridSize.Y);
+		ScanLine(EWallDirection::West, FIntPoint(X, MinCoord.Y), FIntPoint(0, 1), GridSize.Y);
+	}
+}
+
+void FRoomLayoutSolver::PlaceWallRuns(const TArray<FWallRun>& WallRuns)
+{
+	// Group usable segments by length along the wall (CellsX), longest first
+	struct FSegmentGroup
+	{
+		int32 Length = 1;
+		TArray<FMeshPlacementData> Segments;
+		FWeightedAliasSampler Sampler;
+	};
+
+	TArray<FSegmentGroup> SegmentGroups;
+	for (const FMeshPlacementData& SegmentData : Input.WallSegments)
+	{
+		if (SegmentData.Mesh.IsNull() || SegmentData.SelectionWeight <= 0.0f)
+		{
+			continue;
+		}
+
+		const int32 Length = FMath::Max(SegmentData.CellsX, 1);
+		FSegmentGroup* Group = SegmentGroups.FindByPredicate([Length](const FSegmentGroup& Candidate) { return Candidate.Length == Length; });
+		if (!Group)
+		{
+			Group = &SegmentGroups.AddDefaulted_GetRef();
+			Group->Length = Length;
+		}
+		Group->Segments.Add(SegmentData);
+	}
+
+	if (SegmentGroups.Num() == 0)
+	{
+		return;
+	}
+
+	SegmentGroups.Sort([](const FSegmentGroup& A, const FSegmentGroup& B) { return A.Length > B.Length; });
+	for (FSegmentGroup& Group : SegmentGroups)
+	{
+		Group.Sampler = FWeightedAliasSampler::FromPlacements(Group.Segments);
+	}
+
+	const float CellSize = Input.CellSize;
+
+	for (const FWallRun& Run : WallRuns)
+	{
+		const bool bAlongX = Run.Direction == EWallDirection::North || Run.Direction == EWallDirection::South;
+		const FIntPoint Step = bAlongX ? FIntPoint(1, 0) : FIntPoint(0, 1);
+
+		// Edge line of the run relative to its first cell, and yaw facing out of the room
+		FVector EdgeOffset = FVector::ZeroVector;
+		float RotationYaw = 0.0f;
+
+		switch (Run.Direction)
+		{
+		case EWallDirection::North:
+			EdgeOffset = FVector(0.0f, CellSize, 0.0f);
+			RotationYaw = 0.0f;
+			break;
+		case EWallDirection::East:
+			EdgeOffset = FVector(CellSize, 0.0f, 0.0f);
+			RotationYaw = 90.0f;
+			break;
+		case EWallDirection::South:
+			RotationYaw = 180.0f;
+			break;
+		case EWallDirection::West:
+			RotationYaw = 270.0f;
+			break;
+		}
+
+		// Greedily cover the run with the longest segment that still fits
+		int32 Offset = 0;
+		while (Offset < Run.Length)
+		{
+			const int32 Remaining = Run.Length - Offset;
+			const FSegmentGroup* Group = SegmentGroups.FindByPredicate([Remaining](const FSegmentGroup& Candidate) { return Candidate.Length <= Remaining; });
+			if (!Group)
+			{
+				// Only segments longer than the rest of the run are available
+				break;
+			}
+
+			const FMeshPlacementData& SegmentData = Group->Segments[Group->Sampler.Sample(RandomStream)];
+			const FIntPoint SegmentStart = Run.StartCell + Step * Offset;
+
+			// Segments are centered on the span of edges they cover
+			const FVector AlongOffset = FVector(Step.X, Step.Y, 0.0f) * (Group->Length * CellSize * 0.5f);
+			const FVector Position = GetLocalPositionForCell(SegmentStart) + EdgeOffset + AlongOffset;
+
+			AddEntry(SegmentData.Mesh, ERoomContainer::Wall, FTransform(FRotator(0.0f, RotationYaw, 0.0f), Position),
+				SegmentStart, bAlongX ? FIntPoint(Group->Length, 1) : FIntPoint(1, Group->Length));
+
+			Offset += Group->Length;
+		}
+	}
+}
+
+void FRoomLayoutSolver::PlaceWallCorners()
+{
+	auto MakeCornerSampler = [](const TArray<FMeshPlacementData>& Corners)
+	{
+		return FWeightedAliasSampler::FromItems(MakeArrayView(Corners), [](const FMeshPlacementData& CornerData)
+		{
+			return CornerData.Mesh.IsNull() ? 0.0f : CornerData.SelectionWeight;
+		});
+	};
+
+	const FWeightedAliasSampler InnerSampler = MakeCornerSampler(Input.InnerCorners);
+	const FWeightedAliasSampler OuterSampler = MakeCornerSampler(Input.OuterCorners);
+	if (InnerSampler.IsEmpty() && OuterSampler.IsEmpty())
+	{
+		return;
+	}
+
+	// Cells around a vertex, in yaw order: yaw 0 faces +X+Y (north-east) and each 90 degrees turns one quadrant
+	static const FIntPoint QuadrantOffsets[4] = { FIntPoint(0, 0), FIntPoint(-1, 0), FIntPoint(-1, -1), FIntPoint(0, -1) };
+
+	auto PlaceCorner = [&](const TArray<FMeshPlacementData>& Corners, const FWeightedAliasSampler& Sampler, const FIntPoint& Vertex, int32 Quadrant)
+	{
+		if (Sampler.IsEmpty())
+		{
+			return;
+		}
+
+		const FMeshPlacementData& CornerData = Corners[Sampler.Sample(RandomStream)];
+		AddEntry(CornerData.Mesh, ERoomContainer::Wall, FTransform(FRotator(0.0f, Quadrant * 90.0f, 0.0f), GetLocalPositionForCell(Vertex)),
+			Vertex + QuadrantOffsets[Quadrant], FIntPoint(1, 1));
+	};
+
+	// Vertices of the outline lie on the lattice around the bounding box
+	const FIntPoint MinCoord = Grid.GetMinCoord();
+	const FIntPoint MaxVertex = MinCoord + Grid.GetSize();
+
+	for (int32 Y = MinCoord.Y; Y <= MaxVertex.Y; ++Y)
+	{
+		for (int32 X = MinCoord.X; X <= MaxVertex.X; ++X)
+		{
+			const FIntPoint Vertex(X, Y);
+
+			uint8 InteriorMask = 0;
+			for (int32 Quadrant = 0; Quadrant < 4; ++Quadrant)
+			{
+				if (IsInteriorCell(Vertex + QuadrantOffsets[Quadrant]))
+				{
+					InteriorMask |= 1 << Quadrant;
+				}
+			}
+
+			const int32 NumInterior = FMath::CountBits(InteriorMask);
+			if (NumInterior == 1)
+			{
+				// Convex vertex: one interior cell, the corner faces into it
+				PlaceCorner(Input.OuterCorners, OuterSampler, Vertex, FMath::CountTrailingZeros(InteriorMask));
+			}
+			else if (NumInterior == 3)
+			{
+				// Concave vertex: one exterior cell, the corner faces away from it
+				const int32 ExteriorQuadrant = FMath::CountTrailingZeros(~InteriorMask & 0x0F);
+				PlaceCorner(Input.InnerCorners, InnerSampler, Vertex, (ExteriorQuadrant + 2) % 4);
+			}
+			else if (InteriorMask == 0x05 || InteriorMask == 0x0A)
+			{
+				// Two cells touching only at this vertex: a convex corner for each
+				for (int32 Quadrant = 0; Quadrant < 4; ++Quadrant)
+				{
+					if (InteriorMask & (1 << Quadrant))
+					{
+						PlaceCorner(Input.OuterCorners, OuterSampler, Vertex, Quadrant);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool FRoomLayoutSolver::IsInteriorCell(const FIntPoint& GridCoord) const
+{
+	const int32 CellIndex = Grid.FindIndex(GridCoord);
+	return CellIndex != INDEX_NONE && Grid.GetCellState(CellIndex) != ECellState::Unoccupied;
+}
+
+void FRoomLayoutSolver::SolveCeiling()
+{
+	DUNGEONGEN_SCOPE(SolveCeiling);
+
+	if (Input.CeilingTiles.Num() == 0)
+	{
+		return;
+	}
+
+	const float CeilingHeight = Input.CeilingHeightOffset;
+
+	// Track ceiling coverage on a scratch copy of the grid: covered cells leave the Occupied state,
+	// so a multi-cell tile fits wherever the copy still reports its whole footprint as Occupied
+	FRoomGrid CoverageGrid = Grid;
+	KeepPreviousEntries(ERoomContainer::Ceiling, CoverageGrid, ECellState::Occupied, ECellState::Reserved);
+
+	// Sort multi-cell ceiling tiles by footprint size (largest first)
+	TArray<FMeshPlacementData> MultiCellTiles = Input.CeilingTiles.FilterByPredicate([](const FMeshPlacementData& TileData)
+	{
+		return TileData.CellsX > 1 || TileData.CellsY > 1;
+	});
+	MultiCellTiles.Sort([](const FMeshPlacementData& A, const FMeshPlacementData& B) {
+		int32 AreaA = A.CellsX * A.CellsY;
+		int32 AreaB = B.CellsX * B.CellsY;
+		return AreaA > AreaB;
+	});
+
+	// Cells no multi-cell tile covers get a weighted single-cell tile
+	const FWeightedAliasSampler SingleCellSampler = FWeightedAliasSampler::FromItems(MakeArrayView(Input.CeilingTiles), [](const FMeshPlacementData& TileData)
+	{
+		return (TileData.CellsX == 1 && TileData.CellsY == 1 && !TileData.Mesh.IsNull()) ? TileData.SelectionWeight : 0.0f;
+	});
+
+	auto PlaceCeilingTile = [&](const FIntPoint& CellCoord, const FMeshPlacementData& TileData)
+	{
+		// Place the ceiling tile at height offset, with pivot offset
+		const FIntPoint Footprint(TileData.CellsX, TileData.CellsY);
+		FVector BasePosition = GetLocalPositionForCell(CellCoord, CeilingHeight);
+		FVector PivotOffset = CalculatePivotOffset(TileData);
+		AddEntry(TileData.Mesh, ERoomContainer::Ceiling, FTransform(BasePosition + PivotOffset), CellCoord, Footprint);
+
+		// Mark cells as covered
+		CoverageGrid.SetRectState(CellCoord, Footprint, ECellState::Reserved);
+	};
+
+	// Place ceiling tiles on all occupied floor cells
+	Grid.ForEachCellIndex([&](int32 CellIndex)
+	{
+		// Only place ceiling on cells with floor tiles that no multi-cell tile has covered yet
+		if (CoverageGrid.GetCellState(CellIndex) != ECellState::Occupied)
+		{
+			return;
+		}
+
+		const FIntPoint CellCoord = Grid.ToCoord(CellIndex);
+
+		// Try to place largest multi-cell tile that fits
+		for (const FMeshPlacementData& TileData : MultiCellTiles)
+		{
+			if (!TileData.Mesh.IsNull() && CoverageGrid.IsRectInState(CellCoord, FIntPoint(TileData.CellsX, TileData.CellsY), ECellState::Occupied))
+			{
+				PlaceCeilingTile(CellCoord, TileData);
+				return;
+			}
+		}
+
+		// Otherwise fill the cell with a weighted single-cell tile
+		if (!SingleCellSampler.IsEmpty())
+		{
+			PlaceCeilingTile(CellCoord, Input.CeilingTiles[SingleCellSampler.Sample(RandomStream)]);
+		}
+	});
+}
+
+void FRoomLayoutSolver::KeepPreviousEntries(ERoomContainer Container, FRoomGrid& TargetGrid, ECellState FreeState, ECellState TakenState)
+{
+	if (!PreviousPlan)
+	{
+		return;
+	}
+
+	for (const FRoomBuildPlanEntry& Entry : PreviousPlan->Entries)
+	{
+		const FIntRect EntryRect(Entry.BottomLeftCell, Entry.BottomLeftCell + Entry.Footprint);
+		const bool bInDirtyRegion = EntryRect.Min.X < DirtyRegion.Max.X && DirtyRegion.Min.X < EntryRect.Max.X
+			&& EntryRect.Min.Y < DirtyRegion.Max.Y && DirtyRegion.Min.Y < EntryRect.Max.Y;
+
+		// Forced placements were already re-applied, so their cells are no longer free
+		if (Entry.Container != Container || bInDirtyRegion || !TargetGrid.IsRectInState(Entry.BottomLeftCell, Entry.Footprint, FreeState))
+		{
+			continue;
+		}
+
+		AddEntry(TSoftObjectPtr<UStaticMesh>(PreviousPlan->MeshPaths[Entry.MeshIndex]), Container, Entry.LocalTransform, Entry.BottomLeftCell, Entry.Footprint);
+		TargetGrid.SetRectState(Entry.BottomLeftCell, Entry.Footprint, TakenState);
+	}
+}
+
+bool FRoomLayoutSolver::TryPlaceMultiCellMesh(const FIntPoint& BottomLeftCell, const FMeshPlacementData& PlacementData, ERoomContainer Container, bool bConsumeReservation)
+{
+	// Validate placement
+	if (!Grid.Contains(BottomLeftCell) || PlacementData.Mesh.IsNull())
+	{
+		return false;
+	}
+
+	// Cells must be free, or reserved for exactly this placement
+	const ECellState RequiredState = bConsumeReservation ? ECellState::Reserved : ECellState::Unoccupied;
+	const FIntPoint Footprint(PlacementData.CellsX, PlacementData.CellsY);
+
+	// Check if footprint fits
+	if (!Grid.IsRectInState(BottomLeftCell, Footprint, RequiredState))
+	{
+		return false;
+	}
+
+	// Calculate position with pivot offset
+	FVector BasePosition = GetLocalPositionForCell(BottomLeftCell);
+	FVector PivotOffset = CalculatePivotOffset(PlacementData);
+	AddEntry(PlacementData.Mesh, Container, FTransform(BasePosition + PivotOffset), BottomLeftCell, Footprint);
+
+	// Mark cells as occupied
+	Grid.SetRectState(BottomLeftCell, Footprint, ECellState::Occupied);
+
+	return true;
+}
+
+bool FRoomLayoutSolver::ReserveCellsForFootprint(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY)
+{
+	const FIntPoint Footprint(FootprintX, FootprintY);
+
+	// Check all cells in footprint
+	if (!Grid.IsRectInState(BottomLeftCell, Footprint, ECellState::Unoccupied))
+	{
+		return false;
+	}
+
+	// Reserve all cells
+	Grid.SetRectState(BottomLeftCell, Footprint, ECellState::Reserved);
+	return true;
+}
+
+bool FRoomLayoutSolver::CheckFootprintOverlap(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY) const
+{
+	// Out of bounds, missing, occupied or reserved cells all count as overlap
+	return !Grid.IsRectInState(BottomLeftCell, FIntPoint(FootprintX, FootprintY), ECellState::Unoccupied);
+}
+
+FVector FRoomLayoutSolver::CalculatePivotOffset(const FMeshPlacementData& PlacementData) const
+{
+	const float CellSize = Input.CellSize;
+	FVector Offset = FVector::ZeroVector;
+
+	switch (PlacementData.PivotType)
+	{
+	case EMeshPivotType::CenterXY:
+		// Center of the footprint
+		Offset.X = (PlacementData.CellsX * CellSize) * 0.5f;
+		Offset.Y = (PlacementData.CellsY * CellSize) * 0.5f;
+		break;
+
+	case EMeshPivotType::BottomBackCenter:
+		// Center X, back Y (toward room interior)
+		Offset.X = (PlacementData.CellsX * CellSize) * 0.5f;
+		Offset.Y = 0.0f;
+		break;
+
+	case EMeshPivotType::BottomCenter:
+		// Center X and Y, bottom Z
+		Offset.X = (PlacementData.CellsX * CellSize) * 0.5f;
+		Offset.Y = (PlacementData.CellsY * CellSize) * 0.5f;
+		break;
+
+	case EMeshPivotType::Custom:
+		Offset = PlacementData.CustomPivotOffset;
+		break;
+	}
+
+	return Offset;
+}
+
+FVector FRoomLayoutSolver::GetLocalPositionForCell(const FIntPoint& GridCoord, float ZOffset) const
+{
+	return FVector(GridCoord.X * Input.CellSize, GridCoord.Y * Input.CellSize, ZOffset);
+}
+
+void FRoomLayoutSolver::AddEntry(const TSoftObjectPtr<UStaticMesh>& Mesh, ERoomContainer Container, const FTransform& LocalTransform, const FIntPoint& BottomLeftCell, const FIntPoint& Footprint)
+{
+	FRoomBuildPlanEntry& Entry = Plan.Entries.AddDefaulted_GetRef();
+	Entry.MeshIndex = Plan.AddMeshPath(Mesh.ToSoftObjectPath());
+	Entry.Container = Container;
+	Entry.LocalTransform = LocalTransform;
+	Entry.BottomLeftCell = BottomLeftCell;
+	Entry.Footprint = Footprint;
+
+	switch (Container)
+	{
+	case ERoomContainer::Floor:
+		Entry.MaterialIndex = Plan.AddMaterialPath(Input.FloorMaterial.ToSoftObjectPath());
+		break;
+	case ERoomContainer::Wall:
+		Entry.MaterialIndex = Plan.AddMaterialPath(Input.WallMaterial.ToSoftObjectPath());
+		break;
+	case ERoomContainer::Ceiling:
+		Entry.MaterialIndex = Plan.AddMaterialPath(Input.CeilingMaterial.ToSoftObjectPath());
+		break;
+	default:
+		break;
+	}
+}
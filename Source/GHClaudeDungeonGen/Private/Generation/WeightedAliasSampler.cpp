@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generation/WeightedAliasSampler.h"
+
+FWeightedAliasSampler FWeightedAliasSampler::FromPlacements(TConstArrayView<FMeshPlacementData> Placements)
+{
+	return FromItems(Placements, [](const FMeshPlacementData& Placement) { return Placement.SelectionWeight; });
+}
+
+void FWeightedAliasSampler::Build(TConstArrayView<float> Weights)
+{
+	Probabilities.Reset();
+	Aliases.Reset();
+
+	const int32 NumItems = Weights.Num();
+
+	double TotalWeight = 0.0;
+	int32 HeaviestItem = 0;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		TotalWeight += FMath::Max(Weights[Index], 0.0f);
+		if (Weights[Index] > Weights[HeaviestItem])
+		{
+			HeaviestItem = Index;
+		}
+	}
+
+	if (NumItems == 0 || TotalWeight <= 0.0)
+	{
+		return;
+	}
+
+	// Scale weights so the average column holds exactly 1
+	TArray<double> ScaledWeights;
+	ScaledWeights.SetNumUninitialized(NumItems);
+
+	TArray<int32> SmallItems;
+	TArray<int32> LargeItems;
+	SmallItems.Reserve(NumItems);
+	LargeItems.Reserve(NumItems);
+
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		ScaledWeights[Index] = FMath::Max(Weights[Index], 0.0f) * NumItems / TotalWeight;
+		(ScaledWeights[Index] < 1.0 ? SmallItems : LargeItems).Add(Index);
+	}
+
+	Probabilities.SetNumZeroed(NumItems);
+	Aliases.SetNumUninitialized(NumItems);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		Aliases[Index] = Index;
+	}
+
+	// Pair each under-full column with an over-full item that tops it up
+	while (SmallItems.Num() > 0 && LargeItems.Num() > 0)
+	{
+		const int32 Small = SmallItems.Pop(EAllowShrinking::No);
+		const int32 Large = LargeItems.Last();
+
+		Probabilities[Small] = static_cast<float>(ScaledWeights[Small]);
+		Aliases[Small] = Large;
+
+		ScaledWeights[Large] = (ScaledWeights[Large] + ScaledWeights[Small]) - 1.0;
+		if (ScaledWeights[Large] < 1.0)
+		{
+			LargeItems.Pop(EAllowShrinking::No);
+			SmallItems.Add(Large);
+		}
+	}
+
+	// Whatever is left is full up to rounding error, except zero-weight items which must never be kept
+	for (int32 Index : LargeItems)
+	{
+		Probabilities[Index] = 1.0f;
+	}
+	for (int32 Index : SmallItems)
+	{
+		if (Weights[Index] > 0.0f)
+		{
+			Probabilities[Index] = 1.0f;
+		}
+		else
+		{
+			Aliases[Index] = HeaviestItem;
+		}
+	}
+}
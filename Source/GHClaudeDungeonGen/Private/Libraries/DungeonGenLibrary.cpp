@@ -2,3 +2,191 @@
 
 
 #include "GHClaudeDungeonGen/Public/Libraries/DungeonGenLibrary.h"
+#include "Generation/DungeonSeed.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Crockford base32: no I, L, O or U, so codes survive being read aloud or retyped
+static const TCHAR DungeonCodeAlphabet[] = TEXT("0123456789ABCDEFGHJKMNPQRSTVWXYZ");
+
+/** Characters between the dashes of an encoded code */
+static constexpr int32 DungeonCodeGroupSize = 5;
+
+/** Bytes of CRC32 appended to the payload */
+static constexpr int32 DungeonCodeChecksumSize = 2;
+
+/** Maps a code character to its 5-bit value (INDEX_NONE if invalid), accepting lower case and the usual misreadings */
+static int32 DecodeDungeonCodeCharacter(TCHAR Character)
+{
+	Character = FChar::ToUpper(Character);
+	switch (Character)
+	{
+	case TEXT('O'):
+		return 0;
+	case TEXT('I'):
+	case TEXT('L'):
+		return 1;
+	default:
+		break;
+	}
+
+	for (int32 Value = 0; Value < 32; ++Value)
+	{
+		if (DungeonCodeAlphabet[Value] == Character)
+		{
+			return Value;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FString UDungeonGenLibrary::EncodeDungeonCode(const FDungeonSeedData& SeedData)
+{
+	// The code only carries the generation inputs, so everything else must follow from them
+	for (int32 FloorIndex = 0; FloorIndex < SeedData.FloorSeeds.Num(); ++FloorIndex)
+	{
+		const FFloorSeedData& Floor = SeedData.FloorSeeds[FloorIndex];
+		if (Floor.FloorIndex != FloorIndex || Floor.FloorSeed != FDungeonSeed::DeriveFloorSeed(SeedData.MasterSeed, FloorIndex))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UDungeonGenLibrary::EncodeDungeonCode - Floor %d was not derived from the master seed, no code possible"), FloorIndex);
+			return FString();
+		}
+	}
+
+	if (SeedData.FloorSeeds.Num() == 0 || SeedData.RoomsPerFloor <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UDungeonGenLibrary::EncodeDungeonCode - Seed data has no floors or no RoomsPerFloor, no code possible"));
+		return FString();
+	}
+
+	// Payload: generator version, master seed (fixed width - derived seeds use all 32 bits), then the varint parameters
+	TArray<uint8> Payload;
+	FMemoryWriter Writer(Payload);
+
+	uint32 GeneratorVersion = FDungeonSeed::GeneratorVersion;
+	uint32 Seed = static_cast<uint32>(SeedData.MasterSeed);
+	uint32 NumFloors = SeedData.FloorSeeds.Num();
+	uint32 RoomsPerFloor = SeedData.RoomsPerFloor;
+	Writer.SerializeIntPacked(GeneratorVersion);
+	Writer << Seed;
+	Writer.SerializeIntPacked(NumFloors);
+	Writer.SerializeIntPacked(RoomsPerFloor);
+
+	const uint32 Checksum = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	for (int32 ByteIndex = 0; ByteIndex < DungeonCodeChecksumSize; ++ByteIndex)
+	{
+		Payload.Add(static_cast<uint8>(Checksum >> (8 * ByteIndex)));
+	}
+
+	// 5 bits per character, most significant first, dashes between groups
+	FString Code;
+	uint32 BitBuffer = 0;
+	int32 NumBufferedBits = 0;
+	int32 NumCharacters = 0;
+
+	auto AppendCharacter = [&Code, &NumCharacters](int32 Value)
+	{
+		if (NumCharacters > 0 && NumCharacters % DungeonCodeGroupSize == 0)
+		{
+			Code.AppendChar(TEXT('-'));
+		}
+		Code.AppendChar(DungeonCodeAlphabet[Value & 31]);
+		++NumCharacters;
+	};
+
+	for (uint8 Byte : Payload)
+	{
+		BitBuffer = (BitBuffer << 8) | Byte;
+		NumBufferedBits += 8;
+		while (NumBufferedBits >= 5)
+		{
+			NumBufferedBits -= 5;
+			AppendCharacter(static_cast<int32>(BitBuffer >> NumBufferedBits));
+		}
+	}
+
+	if (NumBufferedBits > 0)
+	{
+		AppendCharacter(static_cast<int32>(BitBuffer << (5 - NumBufferedBits)));
+	}
+
+	return Code;
+}
+
+bool UDungeonGenLibrary::DecodeDungeonCode(const FString& Code, FDungeonSeedData& OutSeedData)
+{
+	// Unpack the 5-bit characters back into bytes (trailing padding bits are dropped)
+	TArray<uint8> Payload;
+	uint32 BitBuffer = 0;
+	int32 NumBufferedBits = 0;
+
+	for (TCHAR Character : Code)
+	{
+		if (Character == TEXT('-') || FChar::IsWhitespace(Character))
+		{
+			continue;
+		}
+
+		const int32 Value = DecodeDungeonCodeCharacter(Character);
+		if (Value == INDEX_NONE)
+		{
+			return false;
+		}
+
+		BitBuffer = (BitBuffer << 5) | static_cast<uint32>(Value);
+		NumBufferedBits += 5;
+		if (NumBufferedBits >= 8)
+		{
+			NumBufferedBits -= 8;
+			Payload.Add(static_cast<uint8>(BitBuffer >> NumBufferedBits));
+		}
+	}
+
+	if (Payload.Num() <= DungeonCodeChecksumSize)
+	{
+		return false;
+	}
+
+	// Verify the checksum before trusting any field
+	const int32 PayloadSize = Payload.Num() - DungeonCodeChecksumSize;
+	const uint32 Checksum = FCrc::MemCrc32(Payload.GetData(), PayloadSize);
+	for (int32 ByteIndex = 0; ByteIndex < DungeonCodeChecksumSize; ++ByteIndex)
+	{
+		if (Payload[PayloadSize + ByteIndex] != static_cast<uint8>(Checksum >> (8 * ByteIndex)))
+		{
+			return false;
+		}
+	}
+
+	Payload.SetNum(PayloadSize);
+	FMemoryReader Reader(Payload);
+
+	uint32 GeneratorVersion = 0;
+	uint32 Seed = 0;
+	uint32 NumFloors = 0;
+	uint32 RoomsPerFloor = 0;
+	Reader.SerializeIntPacked(GeneratorVersion);
+	Reader << Seed;
+	Reader.SerializeIntPacked(NumFloors);
+	Reader.SerializeIntPacked(RoomsPerFloor);
+
+	// A code from another generator version would lay out a different dungeon
+	if (Reader.IsError() || !Reader.AtEnd() || GeneratorVersion != FDungeonSeed::GeneratorVersion
+		|| NumFloors == 0 || NumFloors > 1024 || RoomsPerFloor == 0 || RoomsPerFloor > MAX_int32)
+	{
+		return false;
+	}
+
+	OutSeedData = FDungeonSeedData();
+	OutSeedData.MasterSeed = static_cast<int32>(Seed);
+	OutSeedData.RoomsPerFloor = static_cast<int32>(RoomsPerFloor);
+	OutSeedData.FloorSeeds.SetNum(NumFloors);
+	for (int32 FloorIndex = 0; FloorIndex < OutSeedData.FloorSeeds.Num(); ++FloorIndex)
+	{
+		OutSeedData.FloorSeeds[FloorIndex].FloorIndex = FloorIndex;
+		OutSeedData.FloorSeeds[FloorIndex].FloorSeed = FDungeonSeed::DeriveFloorSeed(OutSeedData.MasterSeed, FloorIndex);
+	}
+
+	return true;
+}
@@ -3,26 +3,26 @@
 #include "Rooms/MasterRoom.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "Data/Room/RoomData.h"
-#include "Debugging/DebugHelpers.h"
-#include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Materials/MaterialInterface.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Tasks/Task.h"
 #include "Debugging/DebugHelpers.h"
+#include "Debugging/DungeonDebugComponent.h"
+#include "Debugging/DungeonGenProfiling.h"
 #include "Data/Room/RoomData.h"
 #include "Data/Room/FloorData.h"
 #include "Data/Room/WallData.h"
 #include "Data/Room/CeilingData.h"
-#include "Components/SceneComponent.h"
-#include "Components/StaticMeshComponent.h"
-#include "Engine/StaticMesh.h"
 #include "Data/Room/DoorData.h"
-#include "Components/SceneComponent.h"
-#include "Components/StaticMeshComponent.h"
-#include "Engine/StaticMesh.h"
-#include "Engine/World.h"
-
-// Constants
-static constexpr float SELECTION_WEIGHT_SCALE = 100.0f; // SelectionWeight is 0-100, normalized to 0-1
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/RoomBuildCache.h"
+#include "Generation/DungeonSeed.h"
+#include "UObject/UObjectGlobals.h"
 
 AMasterRoom::AMasterRoom()
 {
@@ -45,80 +45,35 @@ AMasterRoom::AMasterRoom()
 	CeilingContainer = CreateDefaultSubobject<USceneComponent>(TEXT("CeilingContainer"));
 	CeilingContainer->SetupAttachment(RootSceneComponent);
 
-	// Create debug helpers component
+	// Create debug helpers component (its debug draw toggle also switches the overlay)
 	DebugHelpers = CreateDefaultSubobject<UDebugHelpers>(TEXT("DebugHelpers"));
+	DebugHelpers->OnDebugDrawToggled.AddUObject(this, &AMasterRoom::RefreshDebugVisualization);
+
+	// Create debug overlay component
+	DebugOverlay = CreateDefaultSubobject<UDungeonDebugComponent>(TEXT("DebugOverlay"));
+	DebugOverlay->SetupAttachment(RootSceneComponent);
 
 	// Initialize properties
 	bUseRandomSeed = true;
 	GenerationSeed = 0;
 	bUseShapeOverride = false;
+	bGenerateOnSpawn = true;
+	bUseBuildCache = true;
+	bPersistBuildCache = false;
+	bUseInstancedMeshes = true;
+	bUseHierarchicalInstancing = false;
+	MaxPooledComponents = 512;
 	bIsGenerated = false;
 }
 
-void AMasterRoom::GenerateRoom()
-{
-	// Cleanup any existing generation
-	CleanupRoom();
-
-	// Validate RoomData
-	if (RoomData.IsNull())
-	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::GenerateRoom - RoomData is null!"));
-		return;
-	}
-
-	// Load RoomData if not already loaded
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::GenerateRoom - Failed to load RoomData!"));
-	// Initialize default values
-	GenerationSeed = 12345;
-	GenerationSeed = 0;
-	bUseRandomSeed = true;
-	bOverrideShape = false;
-	bIsGenerated = false;
-
-	// Initialize component hierarchy
-	InitializeComponents();
-}
-
-void AMasterRoom::InitializeComponents()
-{
-	// Create root scene component
-	RoomRoot = CreateDefaultSubobject<USceneComponent>(TEXT("RoomRoot"));
-	RootComponent = RoomRoot;
-	// Create root component
-	RoomRoot = CreateDefaultSubobject<USceneComponent>(TEXT("RoomRoot"));
-	SetRootComponent(RoomRoot);
-
-	// Create container components
-	FloorContainer = CreateDefaultSubobject<USceneComponent>(TEXT("FloorContainer"));
-	FloorContainer->SetupAttachment(RoomRoot);
-
-	WallContainer = CreateDefaultSubobject<USceneComponent>(TEXT("WallContainer"));
-	WallContainer->SetupAttachment(RoomRoot);
-
-	CeilingContainer = CreateDefaultSubobject<USceneComponent>(TEXT("CeilingContainer"));
-	CeilingContainer->SetupAttachment(RoomRoot);
-
-	DoorwayContainer = CreateDefaultSubobject<USceneComponent>(TEXT("DoorwayContainer"));
-	DoorwayContainer->SetupAttachment(RoomRoot);
-
-	// Create debug helper component
-	DebugHelper = CreateDefaultSubobject<UDebugHelpers>(TEXT("DebugHelper"));
-}
-
 void AMasterRoom::BeginPlay()
 {
 	Super::BeginPlay();
-	
-	// Auto-generate at runtime if RoomData is set
-	if (!RoomData.IsNull() && !bIsGenerated)
-	// Generate room at runtime if not already generated
-	if (!bIsGenerated)
+
+	// Auto-generate at runtime if RoomData is set (layout is solved off the game thread)
+	if (bGenerateOnSpawn && !RoomData.IsNull() && !bIsGenerated)
 	{
-		GenerateRoom();
+		GenerateRoomAsync();
 	}
 }
 
@@ -128,2137 +83,1106 @@ void AMasterRoom::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedE
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
 	// Auto-regenerate in editor when properties change
-	// Regenerate room when properties change in editor
 	if (PropertyChangedEvent.Property != nullptr)
 	{
-		const FName PropertyName = PropertyChangedEvent.Property->GetFName();
-		
-		// Regenerate on key property changes
-		// Regenerate if relevant properties changed
+		// Member name, so edits inside a forced placement or the shape's cell layout count as well
+		const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+
+		// Regenerate on key property changes (only the cells affected by the edit are rebuilt when possible)
 		if (PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, RoomData) ||
 			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, GenerationSeed) ||
 			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, bUseRandomSeed) ||
-			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, bOverrideShape) ||
-			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, ShapeOverride))
+			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, bUseShapeOverride) ||
+			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, ShapeOverride) ||
+			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, ForcedFloorPlacements) ||
+			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, ForcedWallPlacements) ||
+			PropertyName == GET_MEMBER_NAME_CHECKED(AMasterRoom, ForcedCeilingPlacements))
 		{
 			if (!RoomData.IsNull())
 			{
-				GenerateRoom();
+				RegenerateIncremental();
 			}
 		}
 	}
 }
-			GenerateRoom();
-		}
-	}
+
+void AMasterRoom::PostEditImport()
+{
+	Super::PostEditImport();
+
+	// Pasted rooms are imported from text, which restores the grid's arrays but not its derived state
+	RuntimeGrid.RebuildDerivedState();
 }
 
 void AMasterRoom::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
-	
-	// Generate room preview in editor
-	GenerateRoom();
+
+	// Follow edits to the data assets this room is built from
+	if (!ObjectPropertyChangedHandle.IsValid())
+	{
+		ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &AMasterRoom::OnObjectPropertyChanged);
+	}
+
+	// Generate room preview in editor (a no-op delta when nothing changed, e.g. when the actor is moved)
+	if (bGenerateOnSpawn && !RoomData.IsNull())
+	{
+		RegenerateIncremental();
+	}
 }
-#endif
 
-void AMasterRoom::GenerateRoom()
+void AMasterRoom::BeginDestroy()
 {
-	// Clear existing room content
-	ClearRoom();
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	ObjectPropertyChangedHandle.Reset();
 
-	// Check if RoomData is valid
-	if (RoomData.IsNull())
+	Super::BeginDestroy();
+}
+
+void AMasterRoom::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (!Object || !bIsGenerated || !bGenerateOnSpawn || !GetWorld() || GetWorld()->IsGameWorld())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateRoom - RoomData is null"));
 		return;
 	}
 
-	// Load RoomData if needed
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (LoadedRoomData == nullptr)
+	const UObject* ContextAssets[] = { GenerationContext.RoomData, GenerationContext.FloorData, GenerationContext.WallData, GenerationContext.DoorData, GenerationContext.CeilingData };
+	for (const UObject* ContextAsset : ContextAssets)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateRoom - Failed to load RoomData"));
-		return;
+		if (ContextAsset == Object)
+		{
+			RegenerateIncremental();
+			return;
+		}
 	}
+}
+#endif
 
-	// Initialize random stream
+void AMasterRoom::GenerateRoom()
+{
+	DUNGEONGEN_SCOPE(GenerateRoom);
+	LLM_SCOPE_BYTAG(DungeonGen_Rooms);
+	DUNGEONGEN_SCOPE_TEXT(*GetName());
+
+	// Cleanup any existing generation
+	CleanupRoom();
+
+	// A full generation is the only place a random seed is rolled
 	if (bUseRandomSeed)
 	{
-		GenerationSeed = FMath::Rand();
+		GenerationSeed = FDungeonSeed::MakeRandomSeed();
 	}
-	RandomStream.Initialize(GenerationSeed);
 
-	// Select shape definition
-	FRoomShapeDefinition SelectedShape;
-	if (bUseShapeOverride)
-	{
-		SelectedShape = ShapeOverride;
-	}
-	else if (LoadedRoomData->AllowedShapes.Num() > 0)
+	FRoomLayoutInput LayoutInput;
+	if (!PrepareLayoutInput(LayoutInput))
 	{
-		// Pick a random allowed shape
-		int32 ShapeIndex = RandomStream.RandRange(0, LoadedRoomData->AllowedShapes.Num() - 1);
-		SelectedShape = LoadedRoomData->AllowedShapes[ShapeIndex];
-	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::GenerateRoom - No allowed shapes defined in RoomData!"));
 		return;
 	}
 
-	// Initialize grid based on selected shape
-	InitializeGrid(SelectedShape);
+	SolveAndCommit(LayoutInput);
+}
 
-	// Apply forced placements first (they take priority)
-	if (!ApplyForcedPlacements())
+void AMasterRoom::SolveAndCommit(const FRoomLayoutInput& LayoutInput)
+{
+	// Solve (or fetch the baked layout) and commit in one go
+	FRoomBuildPlan Plan = bUseBuildCache ? FRoomBuildCache::Get().FindOrSolve(LayoutInput, bPersistBuildCache) : FRoomLayoutSolver::Solve(LayoutInput);
+	if (!Plan.bSucceeded)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateRoom - Some forced placements were rejected due to overlaps"));
+		return;
 	}
 
-	// Generate room components
-	GenerateFloor();
-	GenerateWalls();
-	GenerateCeiling();
+	CommitBuildPlan(Plan, LayoutInput);
+}
+
+void AMasterRoom::RegenerateIncremental()
+{
+	DUNGEONGEN_SCOPE(RegenerateIncremental);
+	LLM_SCOPE_BYTAG(DungeonGen_Rooms);
+	DUNGEONGEN_SCOPE_TEXT(*GetName());
 
-	// Update debug visualization if enabled
-	if (DebugHelpers && DebugHelpers->bEnableDebugDraw)
+	// Only a committed room knows what it was solved from
+	if (!bIsGenerated || !CommittedPlan.bSucceeded)
 	{
-		DebugHelpers->UpdateDebugVisualization(RuntimeGrid, GetCellSize());
+		GenerateRoom();
+		return;
 	}
 
-	bIsGenerated = true;
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::GenerateRoom - Room generation completed successfully"));
-}
+	FRoomLayoutInput LayoutInput;
+	if (!PrepareLayoutInput(LayoutInput))
+	{
+		return;
+	}
 
-void AMasterRoom::CleanupRoom()
-{
-	// Destroy all child components in containers
-	TArray<USceneComponent*> ContainersToClean = {FloorContainer, WallContainer, DoorContainer, CeilingContainer};
-	
-	for (USceneComponent* Container : ContainersToClean)
+	// Edits keep the seed the room was built with; only GenerateRoom/RegenerateWithNewSeed roll a new one
+	if (bUseRandomSeed)
 	{
-		if (Container)
-		{
-			TArray<USceneComponent*> Children;
-			Container->GetChildrenComponents(false, Children);
-			
-			for (USceneComponent* Child : Children)
-			{
-				if (Child)
-				{
-					Child->DestroyComponent();
-				}
-			}
-		}
+		LayoutInput.Seed = CommittedLayoutInput.Seed;
 	}
 
-	// Clear runtime grid
-	RuntimeGrid.Empty();
+	FIntRect DirtyRegion;
+	if (!FRoomLayoutSolver::FindDirtyRegion(CommittedLayoutInput, LayoutInput, CommittedPlan, DirtyRegion))
+	{
+		// The change affects the whole room: rebuild it from the input resolved above
+		SolveAndCommit(LayoutInput);
+		return;
+	}
 
-	// Clear doorway snap points
-	NorthDoorwaySnapPoints.Empty();
-	EastDoorwaySnapPoints.Empty();
-	SouthDoorwaySnapPoints.Empty();
-	WestDoorwaySnapPoints.Empty();
+	FRoomBuildPlan Plan = FRoomLayoutSolver::SolveIncremental(LayoutInput, CommittedPlan, DirtyRegion);
+	if (!Plan.bSucceeded)
+	{
+		return;
+	}
 
-	bIsGenerated = false;
+	ApplyBuildPlanDelta(Plan, LayoutInput);
 }
 
-void AMasterRoom::GenerateFloor()
+void AMasterRoom::GenerateRoomAsync()
 {
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->FloorData.IsValid())
+	// Validate RoomData
+	if (RoomData.IsNull())
 	{
+		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::GenerateRoomAsync - RoomData is null!"));
 		return;
 	}
 
-	UFloorData* FloorDataAsset = LoadedRoomData->FloorData.LoadSynchronous();
-	if (!FloorDataAsset || FloorDataAsset->FloorTiles.Num() == 0)
+	// Initialize seed on the game thread so the request is reproducible
+	if (bUseRandomSeed)
 	{
-		return;
+		GenerationSeed = FDungeonSeed::MakeRandomSeed();
 	}
 
-	// Sort floor tiles by footprint size (largest first) for weighted multi-cell placement
-	TArray<FMeshPlacementData> SortedTiles = FloorDataAsset->FloorTiles;
-	SortedTiles.Sort([](const FMeshPlacementData& A, const FMeshPlacementData& B) {
-		int32 AreaA = A.CellsX * A.CellsY;
-		int32 AreaB = B.CellsX * B.CellsY;
-		return AreaA > AreaB; // Largest first
-	});
-
-	// Attempt multi-cell placement first (descending size order)
-	for (auto& CellPair : RuntimeGrid)
+	// Stream every referenced asset first, then solve off the game thread
+	const int32 RequestId = ++GenerationRequestId;
+	LoadRoomAssetsAsync(FStreamableDelegate::CreateWeakLambda(this, [this, RequestId]()
 	{
-		FGridCell& Cell = CellPair.Value;
-		
-		// Skip if cell is already occupied or reserved
-		if (Cell.CellState != ECellState::Unoccupied)
+		if (RequestId == GenerationRequestId)
 		{
-			continue;
+			LaunchLayoutSolve(RequestId);
 		}
+	}));
+}
 
-		// Try to place largest possible tile that fits
-		bool bPlaced = false;
-		for (const FMeshPlacementData& TileData : SortedTiles)
-		{
-			// Skip single-cell tiles in multi-cell pass
-			if (TileData.CellsX == 1 && TileData.CellsY == 1)
-			{
-				continue;
-			}
-
-			if (TryPlaceMultiCellMesh(Cell.GridCoordinates, TileData, FloorContainer))
-			{
-				bPlaced = true;
-				break;
-			}
-		}
+void AMasterRoom::LoadRoomAssetsAsync(FStreamableDelegate OnAssetsLoaded)
+{
+	if (RoomData.IsNull())
+	{
+		return;
 	}
 
-	// Fill remaining single cells
-	for (auto& CellPair : RuntimeGrid)
+	// Handles from a previous request are no longer needed once the new ones hold the assets
+	RoomAssetHandles.Reset();
+	const int32 RequestId = GenerationRequestId;
+
+	// Stage 1: RoomData itself
+	RequestAssetStage({ RoomData.ToSoftObjectPath() }, FStreamableDelegate::CreateWeakLambda(this, [this, RequestId, OnAssetsLoaded]()
 	{
-		FGridCell& Cell = CellPair.Value;
-		
-		if (Cell.CellState != ECellState::Unoccupied)
+		URoomData* LoadedRoomData = RoomData.Get();
+		if (RequestId != GenerationRequestId || !LoadedRoomData)
 		{
-			continue;
+			UE_CLOG(!LoadedRoomData, LogTemp, Error, TEXT("AMasterRoom::LoadRoomAssetsAsync - Failed to load RoomData!"));
+			return;
 		}
 
-		// Select a random single-cell tile
-		TArray<FMeshPlacementData> SingleCellTiles;
-		for (const FMeshPlacementData& TileData : FloorDataAsset->FloorTiles)
-		{
-			if (TileData.CellsX == 1 && TileData.CellsY == 1)
-			{
-				SingleCellTiles.Add(TileData);
-			}
-		}
+		// Stage 2: floor, wall, door and ceiling data assets
+		TArray<FSoftObjectPath> ComponentDataPaths;
+		LoadedRoomData->GetComponentDataPaths(ComponentDataPaths);
 
-		if (SingleCellTiles.Num() > 0)
+		RequestAssetStage(MoveTemp(ComponentDataPaths), FStreamableDelegate::CreateWeakLambda(this, [this, RequestId, OnAssetsLoaded]()
 		{
-			// Weight-based selection
-			float TotalWeight = 0.0f;
-			for (const FMeshPlacementData& Tile : SingleCellTiles)
+			const URoomData* ResidentRoomData = RoomData.Get();
+			if (RequestId != GenerationRequestId || !ResidentRoomData)
 			{
-				TotalWeight += Tile.SelectionWeight;
+				return;
 			}
 
-			float RandomValue = RandomStream.FRandRange(0.0f, TotalWeight);
-			float AccumulatedWeight = 0.0f;
+			// Stage 3: every mesh and material, including forced placements, in one batch
+			TArray<FSoftObjectPath> AssetPaths;
+			ResidentRoomData->GetReferencedAssetPaths(AssetPaths);
 
-			for (const FMeshPlacementData& TileData : SingleCellTiles)
+			for (const TMap<FIntPoint, FMeshPlacementData>* ForcedPlacements : { &ForcedFloorPlacements, &ForcedWallPlacements, &ForcedCeilingPlacements })
 			{
-				AccumulatedWeight += TileData.SelectionWeight;
-				if (RandomValue <= AccumulatedWeight)
+				for (const auto& Placement : *ForcedPlacements)
 				{
-					TryPlaceMultiCellMesh(Cell.GridCoordinates, TileData, FloorContainer);
-					break;
+					if (!Placement.Value.Mesh.IsNull())
+					{
+						AssetPaths.AddUnique(Placement.Value.Mesh.ToSoftObjectPath());
+					}
 				}
 			}
-		}
-	}
+
+			RequestAssetStage(MoveTemp(AssetPaths), OnAssetsLoaded);
+		}));
+	}));
 }
 
-void AMasterRoom::GenerateWalls()
+void AMasterRoom::RequestAssetStage(TArray<FSoftObjectPath> AssetPaths, FStreamableDelegate OnStageLoaded)
 {
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->WallData.IsValid())
+	if (AssetPaths.Num() == 0)
 	{
+		OnStageLoaded.ExecuteIfBound();
 		return;
 	}
 
-	UWallData* WallDataAsset = LoadedRoomData->WallData.LoadSynchronous();
-	if (!WallDataAsset || WallDataAsset->WallSegments.Num() == 0)
+	DUNGEONGEN_COUNTER_ADD(AssetsLoaded, AssetPaths.Num());
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetPaths), OnStageLoaded);
+	if (Handle.IsValid())
 	{
-		return;
+		// Keep the streamed assets resident for as long as this room uses them
+		RoomAssetHandles.Add(Handle);
 	}
+}
 
-	// First, detect which cells need walls (cells at the edge of the room)
-	for (auto& CellPair : RuntimeGrid)
+void AMasterRoom::LaunchLayoutSolve(int32 RequestId)
+{
+	// Assets are resident at this point, so resolving the context does not hit the disk
+	FRoomLayoutInput LayoutInput;
+	if (!ResolveGenerationContext() || !BuildLayoutInput(LayoutInput))
 	{
-		FGridCell& Cell = CellPair.Value;
-		
-		// Only consider occupied cells
-		if (Cell.CellState != ECellState::Occupied)
-		{
-			continue;
-		}
-
-		// Check each direction to see if we need a wall
-		FIntPoint NorthNeighbor(Cell.GridCoordinates.X, Cell.GridCoordinates.Y + 1);
-		FIntPoint EastNeighbor(Cell.GridCoordinates.X + 1, Cell.GridCoordinates.Y);
-		FIntPoint SouthNeighbor(Cell.GridCoordinates.X, Cell.GridCoordinates.Y - 1);
-		FIntPoint WestNeighbor(Cell.GridCoordinates.X - 1, Cell.GridCoordinates.Y);
-
-		// If neighbor doesn't exist or is unoccupied, we need a wall
-		const FGridCell* NorthCell = RuntimeGrid.Find(NorthNeighbor);
-		const FGridCell* EastCell = RuntimeGrid.Find(EastNeighbor);
-		const FGridCell* SouthCell = RuntimeGrid.Find(SouthNeighbor);
-		const FGridCell* WestCell = RuntimeGrid.Find(WestNeighbor);
-
-		Cell.bHasNorthWall = !NorthCell || NorthCell->CellState == ECellState::Unoccupied;
-		Cell.bHasEastWall = !EastCell || EastCell->CellState == ECellState::Unoccupied;
-		Cell.bHasSouthWall = !SouthCell || SouthCell->CellState == ECellState::Unoccupied;
-		Cell.bHasWestWall = !WestCell || WestCell->CellState == ECellState::Unoccupied;
+		return;
 	}
 
-	float CellSize = GetCellSize();
-	const FMeshPlacementData& DefaultWallSegment = WallDataAsset->WallSegments[0];
+	TWeakObjectPtr<AMasterRoom> WeakThis(this);
+	const bool bUseCache = bUseBuildCache;
+	const bool bUseDiskStore = bPersistBuildCache;
 
-	for (auto& CellPair : RuntimeGrid)
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, RequestId, LayoutInput = MoveTemp(LayoutInput), bUseCache, bUseDiskStore, RoomName = GetName()]() mutable
 	{
-		FGridCell& Cell = CellPair.Value;
-		
-		// Skip unoccupied cells
-		if (Cell.CellState != ECellState::Occupied)
-		{
-			continue;
-		}
-
-		// Place walls on each edge that needs one
-		auto PlaceWall = [&](EWallDirection Direction, bool bHasWall, bool bHasDoorway, float RotationYaw) {
-			if (!bHasWall || bHasDoorway)
-			{
-				return;
-			}
-
-			if (!DefaultWallSegment.Mesh.IsValid())
-			{
-				return;
-			}
+		DUNGEONGEN_SCOPE_TEXT(*RoomName);
 
-			UStaticMesh* Mesh = DefaultWallSegment.Mesh.LoadSynchronous();
-			if (!Mesh)
-			{
-				return;
-			}
+		// Pure solve on a worker - no UObject access
+		FRoomBuildPlan Plan = bUseCache ? FRoomBuildCache::Get().FindOrSolve(LayoutInput, bUseDiskStore) : FRoomLayoutSolver::Solve(LayoutInput);
 
-			FString ComponentName = FString::Printf(TEXT("Wall_%d_%d_%d"), Cell.GridCoordinates.X, Cell.GridCoordinates.Y, (int32)Direction);
-			UStaticMeshComponent* WallComponent = NewObject<UStaticMeshComponent>(this, FName(*ComponentName));
-			if (!WallComponent)
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, LayoutInput = MoveTemp(LayoutInput), Plan = MoveTemp(Plan)]()
+		{
+			AMasterRoom* Room = WeakThis.Get();
+			if (!Room || Room->GenerationRequestId != RequestId || !Plan.bSucceeded)
 			{
+				// Room destroyed, request superseded or solve failed
 				return;
 			}
 
-			WallComponent->SetStaticMesh(Mesh);
-			WallComponent->SetupAttachment(WallContainer);
-			WallComponent->RegisterComponent();
-
-			// Calculate wall position based on direction
-			FVector BasePosition = GetWorldPositionForCell(Cell.GridCoordinates);
-			FVector WallOffset = FVector::ZeroVector;
-
-			switch (Direction)
-			{
-			case EWallDirection::North:
-				WallOffset = FVector(CellSize * 0.5f, CellSize, 0.0f);
-				break;
-			case EWallDirection::East:
-				WallOffset = FVector(CellSize, CellSize * 0.5f, 0.0f);
-				break;
-			case EWallDirection::South:
-				WallOffset = FVector(CellSize * 0.5f, 0.0f, 0.0f);
-				break;
-			case EWallDirection::West:
-				WallOffset = FVector(0.0f, CellSize * 0.5f, 0.0f);
-				break;
-			}
+			Room->CommitBuildPlan(Plan, LayoutInput);
+		});
+	});
+}
 
-			WallComponent->SetWorldLocation(BasePosition + WallOffset);
-			WallComponent->SetWorldRotation(FRotator(0.0f, RotationYaw, 0.0f));
-		};
+bool AMasterRoom::PrepareLayoutInput(FRoomLayoutInput& OutInput)
+{
+	// Drop any in-flight async solve
+	++GenerationRequestId;
 
-		// Place walls for each direction
-		PlaceWall(EWallDirection::North, Cell.bHasNorthWall, Cell.bHasNorthDoorway, 0.0f);
-		PlaceWall(EWallDirection::East, Cell.bHasEastWall, Cell.bHasEastDoorway, 90.0f);
-		PlaceWall(EWallDirection::South, Cell.bHasSouthWall, Cell.bHasSouthDoorway, 180.0f);
-		PlaceWall(EWallDirection::West, Cell.bHasWestWall, Cell.bHasWestDoorway, 270.0f);
-	}
+	// Resolve all assets once for this generation
+	return ResolveGenerationContext() && BuildLayoutInput(OutInput);
 }
 
-void AMasterRoom::GenerateCeiling()
+bool AMasterRoom::ResolveGenerationContext()
 {
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->CeilingData.IsValid())
+	DUNGEONGEN_SCOPE(ResolveGenerationContext);
+	LLM_SCOPE_BYTAG(DungeonGen_Rooms);
+
+	GenerationContext = FRoomGenerationContext();
+
+	// Validate RoomData
+	if (RoomData.IsNull())
 	{
-		return;
+		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::ResolveGenerationContext - RoomData is null!"));
+		return false;
 	}
 
-	UCeilingData* CeilingDataAsset = LoadedRoomData->CeilingData.LoadSynchronous();
-	if (!CeilingDataAsset || CeilingDataAsset->CeilingTiles.Num() == 0)
+	// Load RoomData if not already loaded (already resident after LoadRoomAssetsAsync)
+	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
+	if (!LoadedRoomData)
 	{
-		return;
+		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::ResolveGenerationContext - Failed to load RoomData!"));
+		return false;
 	}
 
-	float CeilingHeight = CeilingDataAsset->CeilingHeightOffset;
-
-	// Track which cells have been covered by ceiling tiles (important for multi-cell tiles)
-	TSet<FIntPoint> ProcessedCells;
+	GenerationContext.RoomData = LoadedRoomData;
+	GenerationContext.CellSize = LoadedRoomData->GridConfig.CellSize;
+	GenerationContext.FloorData = LoadedRoomData->FloorData.LoadSynchronous();
+	GenerationContext.WallData = LoadedRoomData->WallData.LoadSynchronous();
+	GenerationContext.DoorData = LoadedRoomData->DoorData.LoadSynchronous();
+	GenerationContext.CeilingData = LoadedRoomData->CeilingData.LoadSynchronous();
 
-	// Sort ceiling tiles by footprint size (largest first)
-	TArray<FMeshPlacementData> SortedTiles = CeilingDataAsset->CeilingTiles;
-	SortedTiles.Sort([](const FMeshPlacementData& A, const FMeshPlacementData& B) {
-		int32 AreaA = A.CellsX * A.CellsY;
-		int32 AreaB = B.CellsX * B.CellsY;
-		return AreaA > AreaB;
-	});
+	// Resolve every mesh and material once, including forced placement meshes
+	TArray<FSoftObjectPath> AssetPaths;
+	LoadedRoomData->GetReferencedAssetPaths(AssetPaths);
 
-	// Place ceiling tiles on all occupied floor cells
-	for (auto& CellPair : RuntimeGrid)
+	for (const TMap<FIntPoint, FMeshPlacementData>* ForcedPlacements : { &ForcedFloorPlacements, &ForcedWallPlacements, &ForcedCeilingPlacements })
 	{
-		FGridCell& Cell = CellPair.Value;
-		
-		// Only place ceiling on cells with floor tiles
-		if (Cell.CellState != ECellState::Occupied)
-		{
-			continue;
-		}
-
-		// Skip if already processed by a multi-cell tile
-		if (ProcessedCells.Contains(Cell.GridCoordinates))
-		{
-			continue;
-		}
-
-		// Try to place largest tile that fits
-		bool bPlaced = false;
-		for (const FMeshPlacementData& TileData : SortedTiles)
+		for (const auto& Placement : *ForcedPlacements)
 		{
-			// Check if this tile would fit
-			bool bCanPlace = true;
-			for (int32 Y = 0; Y < TileData.CellsY && bCanPlace; ++Y)
-			{
-				for (int32 X = 0; X < TileData.CellsX && bCanPlace; ++X)
-				{
-					FIntPoint CheckCoord(Cell.GridCoordinates.X + X, Cell.GridCoordinates.Y + Y);
-					const FGridCell* CheckCell = RuntimeGrid.Find(CheckCoord);
-					if (!CheckCell || CheckCell->CellState != ECellState::Occupied || ProcessedCells.Contains(CheckCoord))
-					{
-						bCanPlace = false;
-					}
-				}
-			}
-
-			if (bCanPlace)
+			if (!Placement.Value.Mesh.IsNull())
 			{
-				// Place the ceiling tile at height offset
-				if (TileData.Mesh.IsValid())
-				{
-					UStaticMesh* Mesh = TileData.Mesh.LoadSynchronous();
-					if (Mesh)
-					{
-						FString ComponentName = FString::Printf(TEXT("CeilingMesh_%d_%d"), Cell.GridCoordinates.X, Cell.GridCoordinates.Y);
-						UStaticMeshComponent* MeshComponent = NewObject<UStaticMeshComponent>(this, FName(*ComponentName));
-						if (MeshComponent)
-						{
-							MeshComponent->SetStaticMesh(Mesh);
-							MeshComponent->SetupAttachment(CeilingContainer);
-							MeshComponent->RegisterComponent();
-
-							// Calculate position with pivot offset and ceiling height
-							FVector BasePosition = GetWorldPositionForCell(Cell.GridCoordinates, CeilingHeight);
-							FVector PivotOffset = CalculatePivotOffset(TileData);
-							MeshComponent->SetWorldLocation(BasePosition + PivotOffset);
-
-							// Mark cells as processed
-							for (int32 Y = 0; Y < TileData.CellsY; ++Y)
-							{
-								for (int32 X = 0; X < TileData.CellsX; ++X)
-								{
-									FIntPoint ProcessedCoord(Cell.GridCoordinates.X + X, Cell.GridCoordinates.Y + Y);
-									ProcessedCells.Add(ProcessedCoord);
-								}
-							}
-
-							bPlaced = true;
-							break;
-						}
-					}
-				}
+				AssetPaths.AddUnique(Placement.Value.Mesh.ToSoftObjectPath());
 			}
 		}
 	}
-}
-
-bool AMasterRoom::ApplyForcedPlacements()
-{
-	bool bAllPlacementsSucceeded = true;
 
-	// Apply forced floor placements
-	for (const auto& Placement : ForcedFloorPlacements)
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
 	{
-		const FIntPoint& BottomLeftCell = Placement.Key;
-		const FMeshPlacementData& PlacementData = Placement.Value;
-
-		// Check for overlaps
-		if (CheckFootprintOverlap(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
+		UObject* Asset = AssetPath.TryLoad();
+		if (UStaticMesh* Mesh = Cast<UStaticMesh>(Asset))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::ApplyForcedPlacements - Forced floor placement at (%d, %d) overlaps existing placement. Rejecting."),
-				BottomLeftCell.X, BottomLeftCell.Y);
-			bAllPlacementsSucceeded = false;
-			continue;
+			GenerationContext.Meshes.Add(AssetPath, Mesh);
 		}
-
-		// Reserve cells and place mesh
-		if (ReserveCellsForFootprint(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
+		else if (UMaterialInterface* Material = Cast<UMaterialInterface>(Asset))
 		{
-			TryPlaceMultiCellMesh(BottomLeftCell, PlacementData, FloorContainer);
+			GenerationContext.Materials.Add(AssetPath, Material);
 		}
 	}
 
-	// Apply forced wall placements
-	for (const auto& Placement : ForcedWallPlacements)
+	return true;
+}
+
+bool AMasterRoom::BuildLayoutInput(FRoomLayoutInput& OutInput) const
+{
+	if (!GenerationContext.IsValid())
 	{
-		const FIntPoint& BottomLeftCell = Placement.Key;
-		const FMeshPlacementData& PlacementData = Placement.Value;
+		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::BuildLayoutInput - Generation context has not been resolved!"));
+		return false;
+	}
 
-		if (CheckFootprintOverlap(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::ApplyForcedPlacements - Forced wall placement at (%d, %d) overlaps existing placement. Rejecting."),
-				BottomLeftCell.X, BottomLeftCell.Y);
-			bAllPlacementsSucceeded = false;
-			continue;
-		}
+	OutInput.Seed = GenerationSeed;
+	OutInput.bUseShapeOverride = bUseShapeOverride;
+	OutInput.ShapeOverride = ShapeOverride;
+	OutInput.AllowedShapes = GenerationContext.RoomData->AllowedShapes;
+	OutInput.CellSize = GenerationContext.CellSize;
+	OutInput.ForcedFloorPlacements = ForcedFloorPlacements;
+	OutInput.ForcedWallPlacements = ForcedWallPlacements;
+	OutInput.ForcedCeilingPlacements = ForcedCeilingPlacements;
 
-		if (ReserveCellsForFootprint(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
-		{
-			TryPlaceMultiCellMesh(BottomLeftCell, PlacementData, WallContainer);
-		}
+	if (const UFloorData* FloorDataAsset = GenerationContext.FloorData)
+	{
+		OutInput.FloorTiles = FloorDataAsset->FloorTiles;
+		OutInput.FloorMaterial = FloorDataAsset->DefaultMaterial;
 	}
 
-	// Apply forced ceiling placements
-	for (const auto& Placement : ForcedCeilingPlacements)
+	if (const UWallData* WallDataAsset = GenerationContext.WallData)
 	{
-		const FIntPoint& BottomLeftCell = Placement.Key;
-		const FMeshPlacementData& PlacementData = Placement.Value;
-
-		if (CheckFootprintOverlap(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::ApplyForcedPlacements - Forced ceiling placement at (%d, %d) overlaps existing placement. Rejecting."),
-				BottomLeftCell.X, BottomLeftCell.Y);
-			bAllPlacementsSucceeded = false;
-			continue;
-		}
+		OutInput.WallSegments = WallDataAsset->WallSegments;
+		OutInput.InnerCorners = WallDataAsset->InnerCorners;
+		OutInput.OuterCorners = WallDataAsset->OuterCorners;
+		OutInput.WallMaterial = WallDataAsset->DefaultMaterial;
+	}
 
-		if (ReserveCellsForFootprint(BottomLeftCell, PlacementData.CellsX, PlacementData.CellsY))
-		{
-			TryPlaceMultiCellMesh(BottomLeftCell, PlacementData, CeilingContainer);
-		}
+	if (const UCeilingData* CeilingDataAsset = GenerationContext.CeilingData)
+	{
+		OutInput.CeilingTiles = CeilingDataAsset->CeilingTiles;
+		OutInput.CeilingHeightOffset = CeilingDataAsset->CeilingHeightOffset;
+		OutInput.CeilingMaterial = CeilingDataAsset->DefaultMaterial;
 	}
 
-	return bAllPlacementsSucceeded;
+	return true;
 }
 
-FVector AMasterRoom::GetWorldPositionForCell(const FIntPoint& GridCoord, float ZOffset) const
+void AMasterRoom::CommitBuildPlan(const FRoomBuildPlan& Plan, const FRoomLayoutInput& LayoutInput)
 {
-	float CellSize = GetCellSize();
-	
-	// Calculate world position from grid coordinates
-	// Grid origin is at actor location
-	FVector WorldPos;
-	WorldPos.X = GridCoord.X * CellSize;
-	WorldPos.Y = GridCoord.Y * CellSize;
-	WorldPos.Z = ZOffset;
-	
-	return GetActorLocation() + WorldPos;
-}
-
-bool AMasterRoom::IsValidGridPosition(const FIntPoint& GridCoord) const
-{
-	return RuntimeGrid.Contains(GridCoord);
-}
+	DUNGEONGEN_SCOPE(CommitBuildPlan);
+	LLM_SCOPE_BYTAG(DungeonGen_Rooms);
+	DUNGEONGEN_SCOPE_TEXT(*GetName());
 
-FVector AMasterRoom::CalculatePivotOffset(const FMeshPlacementData& PlacementData) const
-{
-	float CellSize = GetCellSize();
-	FVector Offset = FVector::ZeroVector;
+	CleanupRoom();
 
-	switch (PlacementData.PivotType)
+	// Spawn every planned mesh
+	TArray<int32> EntryIndices;
+	EntryIndices.Reserve(Plan.Entries.Num());
+	for (int32 EntryIndex = 0; EntryIndex < Plan.Entries.Num(); ++EntryIndex)
 	{
-	case EMeshPivotType::CenterXY:
-		// Center of the footprint
-		Offset.X = (PlacementData.CellsX * CellSize) * 0.5f;
-		Offset.Y = (PlacementData.CellsY * CellSize) * 0.5f;
-		break;
-
-	case EMeshPivotType::BottomBackCenter:
-		// Center X, back Y (toward room interior)
-		Offset.X = (PlacementData.CellsX * CellSize) * 0.5f;
-		Offset.Y = 0.0f;
-		break;
-
-	case EMeshPivotType::BottomCenter:
-		// Center X and Y, bottom Z
-		Offset.X = (PlacementData.CellsX * CellSize) * 0.5f;
-		Offset.Y = (PlacementData.CellsY * CellSize) * 0.5f;
-		break;
-
-	case EMeshPivotType::Custom:
-		Offset = PlacementData.CustomPivotOffset;
-		break;
+		EntryIndices.Add(EntryIndex);
 	}
 
-	return Offset;
+	SpawnPlanEntries(Plan, EntryIndices);
+	FinishCommit(Plan, LayoutInput);
 }
 
-bool AMasterRoom::TryPlaceMultiCellMesh(const FIntPoint& BottomLeftCell, const FMeshPlacementData& PlacementData, USceneComponent* ParentContainer)
+void AMasterRoom::ApplyBuildPlanDelta(const FRoomBuildPlan& Plan, const FRoomLayoutInput& LayoutInput)
 {
-	// Validate placement
-	if (!IsValidGridPosition(BottomLeftCell))
-	{
-		return false;
-	}
+	DUNGEONGEN_SCOPE(ApplyBuildPlanDelta);
+	LLM_SCOPE_BYTAG(DungeonGen_Rooms);
 
-	// Check if footprint fits
-	for (int32 Y = 0; Y < PlacementData.CellsY; ++Y)
+	// Entries are matched by mesh, material, container, cells and transform; matching ones are left untouched
+	auto MakeEntryKey = [](const FRoomBuildPlan& SourcePlan, const FRoomBuildPlanEntry& Entry)
 	{
-		for (int32 X = 0; X < PlacementData.CellsX; ++X)
-		{
-			FIntPoint CheckCoord(BottomLeftCell.X + X, BottomLeftCell.Y + Y);
-			if (!IsValidGridPosition(CheckCoord))
-			{
-				return false;
-			}
-
-			FGridCell* Cell = RuntimeGrid.Find(CheckCoord);
-			if (!Cell || Cell->CellState != ECellState::Unoccupied)
-			{
-				return false;
-			}
-		}
-	}
-
-	// Load mesh
-	if (!PlacementData.Mesh.IsValid())
-	{
-		return false;
-	}
-
-	UStaticMesh* Mesh = PlacementData.Mesh.LoadSynchronous();
-	if (!Mesh)
-	{
-		return false;
-	}
+		const FVector Location = Entry.LocalTransform.GetLocation();
+		return FString::Printf(TEXT("%s|%s|%d|%d,%d|%d,%d|%.2f,%.2f,%.2f|%.2f"),
+			*SourcePlan.MeshPaths[Entry.MeshIndex].ToString(),
+			SourcePlan.MaterialPaths.IsValidIndex(Entry.MaterialIndex) ? *SourcePlan.MaterialPaths[Entry.MaterialIndex].ToString() : TEXT(""),
+			static_cast<int32>(Entry.Container), Entry.BottomLeftCell.X, Entry.BottomLeftCell.Y, Entry.Footprint.X, Entry.Footprint.Y,
+			Location.X, Location.Y, Location.Z, Entry.LocalTransform.Rotator().Yaw);
+	};
 
-	// Create static mesh component
-	FString ComponentName = FString::Printf(TEXT("Mesh_%d_%d"), BottomLeftCell.X, BottomLeftCell.Y);
-	UStaticMeshComponent* MeshComponent = NewObject<UStaticMeshComponent>(this, FName(*ComponentName));
-	if (!MeshComponent)
+	// Committed entries by key (a multiset, so identical placements are matched one to one)
+	TMap<FString, TArray<int32>> CommittedEntriesByKey;
+	for (int32 EntryIndex = 0; EntryIndex < CommittedPlan.Entries.Num(); ++EntryIndex)
 	{
-		return false;
+		CommittedEntriesByKey.FindOrAdd(MakeEntryKey(CommittedPlan, CommittedPlan.Entries[EntryIndex])).Add(EntryIndex);
 	}
 
-	MeshComponent->SetStaticMesh(Mesh);
-	MeshComponent->SetupAttachment(ParentContainer);
-	MeshComponent->RegisterComponent();
-
-	// Calculate position with pivot offset
-	FVector BasePosition = GetWorldPositionForCell(BottomLeftCell);
-	FVector PivotOffset = CalculatePivotOffset(PlacementData);
-	MeshComponent->SetWorldLocation(BasePosition + PivotOffset);
-
-	// Mark cells as occupied
-	for (int32 Y = 0; Y < PlacementData.CellsY; ++Y)
+	TArray<int32> AddedEntryIndices;
+	for (int32 EntryIndex = 0; EntryIndex < Plan.Entries.Num(); ++EntryIndex)
 	{
-		for (int32 X = 0; X < PlacementData.CellsX; ++X)
+		TArray<int32>* Matches = CommittedEntriesByKey.Find(MakeEntryKey(Plan, Plan.Entries[EntryIndex]));
+		if (Matches && Matches->Num() > 0)
 		{
-			FIntPoint CellCoord(BottomLeftCell.X + X, BottomLeftCell.Y + Y);
-			if (FGridCell* Cell = RuntimeGrid.Find(CellCoord))
-			{
-				Cell->CellState = ECellState::Occupied;
-				// Store the owning actor (this AMasterRoom) since OccupyingActor is TWeakObjectPtr<AActor>
-				Cell->OccupyingActor = this;
-			}
+			Matches->Pop(EAllowShrinking::No);
 		}
-	}
-
-	return true;
-}
-
-bool AMasterRoom::ReserveCellsForFootprint(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY)
-{
-	// Check all cells in footprint
-	for (int32 Y = 0; Y < FootprintY; ++Y)
-	{
-		for (int32 X = 0; X < FootprintX; ++X)
+		else
 		{
-			FIntPoint CellCoord(BottomLeftCell.X + X, BottomLeftCell.Y + Y);
-			if (!IsValidGridPosition(CellCoord))
-			{
-				return false;
-			}
-
-			FGridCell* Cell = RuntimeGrid.Find(CellCoord);
-			if (!Cell || Cell->CellState != ECellState::Unoccupied)
-			{
-				return false;
-			}
+			AddedEntryIndices.Add(EntryIndex);
 		}
 	}
 
-	// Reserve all cells
-	for (int32 Y = 0; Y < FootprintY; ++Y)
+	// Whatever is left over is no longer part of the room
+	int32 NumRemoved = 0;
+	for (const TPair<FString, TArray<int32>>& Pair : CommittedEntriesByKey)
 	{
-		for (int32 X = 0; X < FootprintX; ++X)
+		for (int32 EntryIndex : Pair.Value)
 		{
-			FIntPoint CellCoord(BottomLeftCell.X + X, BottomLeftCell.Y + Y);
-			if (FGridCell* Cell = RuntimeGrid.Find(CellCoord))
-			{
-				Cell->CellState = ECellState::Reserved;
-			}
+			NumRemoved += RemovePlanEntryMesh(CommittedPlan, CommittedPlan.Entries[EntryIndex]) ? 1 : 0;
 		}
 	}
 
-	return true;
-}
+	SpawnPlanEntries(Plan, AddedEntryIndices);
 
-bool AMasterRoom::CheckFootprintOverlap(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY) const
-{
-	for (int32 Y = 0; Y < FootprintY; ++Y)
-	{
-		for (int32 X = 0; X < FootprintX; ++X)
-		{
-			FIntPoint CellCoord(BottomLeftCell.X + X, BottomLeftCell.Y + Y);
-			
-			if (!IsValidGridPosition(CellCoord))
-			{
-				return true; // Out of bounds = overlap
-			}
-
-			const FGridCell* Cell = RuntimeGrid.Find(CellCoord);
-			if (!Cell || Cell->CellState != ECellState::Unoccupied)
-			{
-				return true; // Occupied or reserved = overlap
-			}
-		}
-	}
+	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::ApplyBuildPlanDelta - Removed %d and added %d of %d placements"),
+		NumRemoved, AddedEntryIndices.Num(), Plan.Entries.Num());
 
-	return false; // No overlap
+	FinishCommit(Plan, LayoutInput);
 }
 
-void AMasterRoom::InitializeGrid(const FRoomShapeDefinition& ShapeDefinition)
+bool AMasterRoom::RemovePlanEntryMesh(const FRoomBuildPlan& SourcePlan, const FRoomBuildPlanEntry& Entry)
 {
-	RuntimeGrid.Empty();
-
-	float CellSize = GetCellSize();
-
-	// Generate grid based on shape type
-	switch (ShapeDefinition.ShapeType)
-	{
-	case ERoomShape::Rectangle:
-		{
-			// Simple rectangular grid
-			for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-		}
-		break;
-
-	case ERoomShape::Custom:
-		{
-			// Custom shape from layout array
-			if (ShapeDefinition.CustomCellLayout.Num() == ShapeDefinition.CustomLayoutWidth * ShapeDefinition.CustomLayoutHeight)
-			{
-				for (int32 Y = 0; Y < ShapeDefinition.CustomLayoutHeight; ++Y)
-				{
-					for (int32 X = 0; X < ShapeDefinition.CustomLayoutWidth; ++X)
-					{
-						int32 Index = Y * ShapeDefinition.CustomLayoutWidth + X;
-						if (ShapeDefinition.CustomCellLayout[Index] == 1)
-						{
-							FIntPoint GridCoord(X, Y);
-							FGridCell NewCell;
-							NewCell.GridCoordinates = GridCoord;
-							NewCell.CellState = ECellState::Unoccupied;
-							NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-							
-							RuntimeGrid.Add(GridCoord, NewCell);
-						}
-					}
-				}
-			}
-		}
-		break;
-
-	case ERoomShape::LShape:
-		{
-			// L-Shape: Main rectangle + one extension
-			// Main section
-			for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-			// Extension (simplified - extends from bottom-right)
-			// In a full implementation, this would use FShapeTemplate
-			// For now, extend by half the width to the right
-			int32 ExtensionWidth = FMath::Max(1, ShapeDefinition.RectWidth / 2);
-			int32 ExtensionHeight = FMath::Max(1, ShapeDefinition.RectHeight / 2);
-			for (int32 Y = 0; Y < ExtensionHeight; ++Y)
-			{
-				for (int32 X = ShapeDefinition.RectWidth; X < ShapeDefinition.RectWidth + ExtensionWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-		}
-		break;
-
-	case ERoomShape::TShape:
-		{
-			// T-Shape: Main rectangle + extensions on two opposite sides
-			// Main section
-			for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-			// Top extension
-			int32 ExtensionWidth = FMath::Max(1, ShapeDefinition.RectWidth / 3);
-			int32 ExtensionHeight = FMath::Max(1, ShapeDefinition.RectHeight / 3);
-			int32 ExtensionStartX = (ShapeDefinition.RectWidth - ExtensionWidth) / 2;
-			for (int32 Y = ShapeDefinition.RectHeight; Y < ShapeDefinition.RectHeight + ExtensionHeight; ++Y)
-			{
-				for (int32 X = ExtensionStartX; X < ExtensionStartX + ExtensionWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-		}
-		break;
-
-	case ERoomShape::UShape:
-		{
-			// U-Shape: Main rectangle + extensions on three sides
-			// Main section (bottom bar of U)
-			for (int32 Y = 0; Y < ShapeDefinition.RectHeight / 3; ++Y)
-			{
-				for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-			// Left vertical extension
-			int32 ExtensionHeight = ShapeDefinition.RectHeight * 2 / 3;
-			int32 ExtensionWidth = ShapeDefinition.RectWidth / 3;
-			for (int32 Y = ShapeDefinition.RectHeight / 3; Y < ShapeDefinition.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < ExtensionWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-			// Right vertical extension
-			for (int32 Y = ShapeDefinition.RectHeight / 3; Y < ShapeDefinition.RectHeight; ++Y)
-			{
-				for (int32 X = ShapeDefinition.RectWidth - ExtensionWidth; X < ShapeDefinition.RectWidth; ++X)
-				{
-					FIntPoint GridCoord(X, Y);
-					FGridCell NewCell;
-					NewCell.GridCoordinates = GridCoord;
-					NewCell.CellState = ECellState::Unoccupied;
-					NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-					RuntimeGrid.Add(GridCoord, NewCell);
-				}
-			}
-		}
-		break;
-
-	default:
-		// Default to rectangle for any unknown shape type
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::InitializeGrid - Unknown shape type, defaulting to rectangle"));
-		for (int32 Y = 0; Y < ShapeDefinition.RectHeight; ++Y)
-		{
-			for (int32 X = 0; X < ShapeDefinition.RectWidth; ++X)
-			{
-				FIntPoint GridCoord(X, Y);
-				FGridCell NewCell;
-				NewCell.GridCoordinates = GridCoord;
-				NewCell.CellState = ECellState::Unoccupied;
-				NewCell.WorldPosition = GetWorldPositionForCell(GridCoord);
-				RuntimeGrid.Add(GridCoord, NewCell);
-			}
-		}
-		break;
-	}
-}
-
-float AMasterRoom::GetCellSize() const
-{
-	if (RoomData.IsValid())
-	{
-		URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-		if (LoadedRoomData)
-		{
-			return LoadedRoomData->GridConfig.CellSize;
-		}
-	}
-	
-	// Default cell size
-	return 100.0f;
-}
-
-void AMasterRoom::RefreshDebugVisualization()
-{
-	if (DebugHelpers && bIsGenerated)
-	{
-		DebugHelpers->UpdateDebugVisualization(RuntimeGrid, GetCellSize());
-		
-		// Also draw forced placements
-		DebugHelpers->DrawDebugForcedPlacements(ForcedFloorPlacements, GetCellSize());
-		DebugHelpers->DrawDebugForcedPlacements(ForcedWallPlacements, GetCellSize());
-		DebugHelpers->DrawDebugForcedPlacements(ForcedCeilingPlacements, GetCellSize());
-	}
-	// Determine which shape to use
-	FRoomShapeDefinition ShapeToUse;
-	if (bOverrideShape)
-	{
-		ShapeToUse = ShapeOverride;
-	}
-	else if (LoadedRoomData->AllowedShapes.Num() > 0)
-	{
-		// Select random shape from allowed shapes
-		int32 ShapeIndex = RandomStream.RandRange(0, LoadedRoomData->AllowedShapes.Num() - 1);
-		ShapeToUse = LoadedRoomData->AllowedShapes[ShapeIndex];
-	}
-	else
+	UStaticMesh* Mesh = GenerationContext.FindMesh(SourcePlan.MeshPaths[Entry.MeshIndex]);
+	if (!Mesh)
 	{
-		// Default rectangular shape
-		ShapeToUse.ShapeType = ERoomShape::Rectangle;
-		ShapeToUse.RectWidth = 5;
-		ShapeToUse.RectHeight = 5;
+		// The mesh may have left the data assets; it is still resident while this room displays it
+		Mesh = TSoftObjectPtr<UStaticMesh>(SourcePlan.MeshPaths[Entry.MeshIndex]).Get();
 	}
 
-	// Generate grid
-	GenerateGrid(ShapeToUse);
-
-	// Spawn meshes
-	SpawnFloorMeshes();
-	SpawnWallMeshes();
-	SpawnCeilingMeshes();
-	SpawnDoorwayMeshes();
-
-	// Calculate doorway snap points
-	CalculateDoorwaySnapPoints();
-
-	// Apply forced placements
-	ApplyForcedPlacements();
-
-	bIsGenerated = true;
-	
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::GenerateRoom - Room generated successfully with seed %d"), GenerationSeed);
-	// Clear existing room
-	ClearRoom();
-
-	// Validate RoomData
-	if (!RoomData.IsValid())
+	USceneComponent* ParentContainer = GetContainer(Entry.Container);
+	if (!Mesh || !ParentContainer)
 	{
-		// Try to load if not already loaded
-		if (!RoomData.IsNull())
-		{
-			RoomData.LoadSynchronous();
-		}
-		
-		if (!RoomData.IsValid())
-		{
-			return; // Cannot generate without room data
-		}
+		return false;
 	}
 
-	// Initialize random stream with effective seed
-	const int32 EffectiveSeed = GetEffectiveSeed();
-	RandomStream.Initialize(EffectiveSeed);
-
-	// Initialize grid based on shape
-	InitializeGrid();
-
-	// Generate room components
-	GenerateFloorMeshes();
-	GenerateWallMeshes();
-	GenerateCeilingMeshes();
-	GenerateDoorways();
-
-	// Mark as generated
-	bIsGenerated = true;
-}
-
-void AMasterRoom::ClearRoom()
-{
-	// Clear grid
-	Grid.Empty();
-
-	// Clear doorway tracking
-	DoorwaySnapPoints.Empty();
-	DoorwayDirections.Empty();
-
-	// Destroy all spawned mesh components in containers
-	// Clear doorway data
-	DoorwaySnapPoints.Empty();
-	DoorwayDirections.Empty();
-
-	// Destroy all mesh components in containers
-	if (FloorContainer)
-	{
-		TArray<USceneComponent*> Children;
-		FloorContainer->GetChildrenComponents(false, Children);
-		for (USceneComponent* Child : Children)
-		{
-			if (Child)
-			{
-				Child->DestroyComponent();
-			}
-		}
-	}
+	FTransform WorldTransform = Entry.LocalTransform;
+	WorldTransform.AddToTranslation(GetActorLocation());
 
-	if (WallContainer)
+	// Instanced: the instance of the matching batch with the entry's cells and transform
+	for (const FRoomInstanceBatch& Batch : InstanceBatches)
 	{
-		TArray<USceneComponent*> Children;
-		WallContainer->GetChildrenComponents(false, Children);
-		for (USceneComponent* Child : Children)
+		UInstancedStaticMeshComponent* Component = Batch.Component;
+		if (!Component || Component->GetStaticMesh() != Mesh || Component->GetAttachParent() != ParentContainer)
 		{
-			if (Child)
-			{
-				Child->DestroyComponent();
-			}
+			continue;
 		}
-	}
 
-	if (CeilingContainer)
-	{
-		TArray<USceneComponent*> Children;
-		CeilingContainer->GetChildrenComponents(false, Children);
-		for (USceneComponent* Child : Children)
+		for (int32 InstanceIndex = 0; InstanceIndex < Batch.InstanceCells.Num(); ++InstanceIndex)
 		{
-			if (Child)
+			const FRoomInstanceCellRef& CellRef = Batch.InstanceCells[InstanceIndex];
+			FTransform InstanceTransform;
+			if (CellRef.BottomLeftCell == Entry.BottomLeftCell && CellRef.Footprint == Entry.Footprint
+				&& Component->GetInstanceTransform(InstanceIndex, InstanceTransform, true) && InstanceTransform.Equals(WorldTransform, 0.1))
 			{
-				Child->DestroyComponent();
+				return RemoveMeshInstance(Component, InstanceIndex);
 			}
 		}
 	}
 
-	if (DoorwayContainer)
+	// Per-placement components
+	TArray<USceneComponent*> Children;
+	ParentContainer->GetChildrenComponents(false, Children);
+	for (USceneComponent* Child : Children)
 	{
-		TArray<USceneComponent*> Children;
-		DoorwayContainer->GetChildrenComponents(false, Children);
-		for (USceneComponent* Child : Children)
+		UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Child);
+		if (MeshComponent && !MeshComponent->IsA<UInstancedStaticMeshComponent>() && MeshComponent->GetStaticMesh() == Mesh
+			&& MeshComponent->GetComponentTransform().Equals(WorldTransform, 0.1))
 		{
-			if (Child)
-			{
-				Child->DestroyComponent();
-			}
+			ReleaseMeshComponent(MeshComponent);
+			return true;
 		}
 	}
 
-	bIsGenerated = false;
+	return false;
 }
 
-void AMasterRoom::RegenerateRoom(int32 NewSeed)
+void AMasterRoom::SpawnPlanEntries(const FRoomBuildPlan& Plan, TConstArrayView<int32> EntryIndices)
 {
-	GenerationSeed = NewSeed;
-	bUseRandomSeed = false;
-	GenerateRoom();
-}
+	DUNGEONGEN_SCOPE(SpawnPlanEntries);
 
-void AMasterRoom::ApplyForcedPlacements()
-{
-	// Spawn forced props
-	for (const TPair<FIntPoint, TSubclassOf<AActor>>& Placement : ForcedPropPlacements)
+	// Map the plan's mesh and material handles to the assets resolved in the generation context
+	TArray<UStaticMesh*> Meshes;
+	Meshes.Reserve(Plan.MeshPaths.Num());
+	for (const FSoftObjectPath& MeshPath : Plan.MeshPaths)
 	{
-		if (Placement.Value != nullptr)
-		{
-			// Find the grid cell at the specified coordinates
-			FGridCell* Cell = Grid.FindByPredicate([&Placement](const FGridCell& GridCell)
-			{
-				return GridCell.GridCoordinates == Placement.Key;
-			});
-
-			if (Cell != nullptr)
-			{
-				// Spawn actor at cell world position
-				FActorSpawnParameters SpawnParams;
-				SpawnParams.Owner = this;
-				AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(Placement.Value, Cell->WorldPosition, FRotator::ZeroRotator, SpawnParams);
-				
-				if (SpawnedActor)
-				{
-					Cell->OccupyingActor = SpawnedActor;
-				}
-			}
-		}
+		UStaticMesh* Mesh = GenerationContext.FindMesh(MeshPath);
+		Meshes.Add(Mesh ? Mesh : TSoftObjectPtr<UStaticMesh>(MeshPath).LoadSynchronous());
 	}
 
-	// Spawn forced furniture
-	for (const TPair<FIntPoint, TSubclassOf<AActor>>& Placement : ForcedFurniturePlacements)
+	TArray<UMaterialInterface*> Materials;
+	Materials.Reserve(Plan.MaterialPaths.Num());
+	for (const FSoftObjectPath& MaterialPath : Plan.MaterialPaths)
 	{
-		if (Placement.Value != nullptr)
-		{
-			FGridCell* Cell = Grid.FindByPredicate([&Placement](const FGridCell& GridCell)
-			{
-				return GridCell.GridCoordinates == Placement.Key;
-			});
-
-			if (Cell != nullptr)
-			{
-				FActorSpawnParameters SpawnParams;
-				SpawnParams.Owner = this;
-				AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(Placement.Value, Cell->WorldPosition, FRotator::ZeroRotator, SpawnParams);
-				
-				if (SpawnedActor)
-				{
-					Cell->OccupyingActor = SpawnedActor;
-				}
-			}
-		}
+		UMaterialInterface* Material = GenerationContext.FindMaterial(MaterialPath);
+		Materials.Add(Material ? Material : TSoftObjectPtr<UMaterialInterface>(MaterialPath).LoadSynchronous());
 	}
 
-	// Spawn forced enemies
-	for (const TPair<FIntPoint, TSubclassOf<AActor>>& Placement : ForcedEnemyPlacements)
+	// Queued into instanced batches when enabled (see FinishCommit)
+	const FVector RoomOrigin = GetActorLocation();
+	for (int32 EntryIndex : EntryIndices)
 	{
-		if (Placement.Value != nullptr)
+		const FRoomBuildPlanEntry& Entry = Plan.Entries[EntryIndex];
+		UStaticMesh* Mesh = Meshes.IsValidIndex(Entry.MeshIndex) ? Meshes[Entry.MeshIndex] : nullptr;
+		if (!Mesh)
 		{
-			FGridCell* Cell = Grid.FindByPredicate([&Placement](const FGridCell& GridCell)
-			{
-				return GridCell.GridCoordinates == Placement.Key;
-			});
-
-			if (Cell != nullptr)
-			{
-				FActorSpawnParameters SpawnParams;
-				SpawnParams.Owner = this;
-				AActor* SpawnedActor = GetWorld()->SpawnActor<AActor>(Placement.Value, Cell->WorldPosition, FRotator::ZeroRotator, SpawnParams);
-				
-				if (SpawnedActor)
-				{
-					Cell->OccupyingActor = SpawnedActor;
-				}
-			}
+			continue;
 		}
-	}
-}
-
-void AMasterRoom::GenerateGrid(const FRoomShapeDefinition& Shape)
-{
-	Grid.Empty();
-
-	// Get cell size from RoomData
-	float CellSize = 100.0f; // Default
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (LoadedRoomData)
-	{
-		CellSize = LoadedRoomData->GridConfig.CellSize;
-	}
-
-	// Generate grid based on shape type
-	switch (Shape.ShapeType)
-	{
-		case ERoomShape::Rectangle:
-		{
-			// Generate rectangular grid
-			for (int32 Y = 0; Y < Shape.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < Shape.RectWidth; ++X)
-				{
-					FGridCell Cell;
-					Cell.GridCoordinates = FIntPoint(X, Y);
-					Cell.CellState = ECellState::Occupied;
-					
-					// Calculate world position (centered on origin)
-					Cell.WorldPosition = FVector(
-						X * CellSize - (Shape.RectWidth * CellSize) / 2.0f + CellSize / 2.0f,
-						Y * CellSize - (Shape.RectHeight * CellSize) / 2.0f + CellSize / 2.0f,
-						0.0f
-					);
-
-					// Set perimeter walls
-					Cell.bHasNorthWall = (Y == Shape.RectHeight - 1);
-					Cell.bHasSouthWall = (Y == 0);
-					Cell.bHasEastWall = (X == Shape.RectWidth - 1);
-					Cell.bHasWestWall = (X == 0);
 
-void AMasterRoom::RegenerateWithNewSeed()
-{
-	// Generate a new random seed based on current time
-	GenerationSeed = static_cast<int32>(FDateTime::Now().GetTicks());
-	bUseRandomSeed = false;
-	
-	// Regenerate room
-	GenerateRoom();
-}
-
-float AMasterRoom::GetCellSize() const
-{
-	if (RoomData.IsValid())
-	{
-		return RoomData->GridConfig.CellSize;
-	}
-	return 100.0f; // Default cell size
-}
+		UMaterialInterface* Material = Materials.IsValidIndex(Entry.MaterialIndex) ? Materials[Entry.MaterialIndex] : nullptr;
 
-FRoomShapeDefinition AMasterRoom::GetActiveShapeDefinition() const
-{
-	if (bOverrideShape)
-	{
-		return ShapeOverride;
-	}
+		FTransform WorldTransform = Entry.LocalTransform;
+		WorldTransform.AddToTranslation(RoomOrigin);
 
-	if (RoomData.IsValid() && RoomData->AllowedShapes.Num() > 0)
-	{
-		// For now, use the first shape (can be randomized later)
-		return RoomData->AllowedShapes[0];
+		FString ComponentName = FString::Printf(TEXT("%s_%d_%d_%d"), *UEnum::GetDisplayValueAsText(Entry.Container).ToString(),
+			Entry.BottomLeftCell.X, Entry.BottomLeftCell.Y, EntryIndex);
+		SpawnMeshAtTransform(Mesh, Material, GetContainer(Entry.Container), WorldTransform,
+			FRoomInstanceCellRef(Entry.BottomLeftCell, Entry.Footprint), ComponentName);
 	}
-
-	// Return default rectangle shape
-	FRoomShapeDefinition DefaultShape;
-	DefaultShape.ShapeType = ERoomShape::Rectangle;
-	DefaultShape.RectWidth = 5;
-	DefaultShape.RectHeight = 5;
-	return DefaultShape;
 }
 
-void AMasterRoom::InitializeGrid()
+void AMasterRoom::FinishCommit(const FRoomBuildPlan& Plan, const FRoomLayoutInput& LayoutInput)
 {
-	Grid.Empty();
+	DUNGEONGEN_SCOPE(FinishCommit);
 
-	const FRoomShapeDefinition ShapeDefinition = GetActiveShapeDefinition();
-	const float CellSize = GetCellSize();
+	FlushInstanceBatches();
 
-	// For now, implement simple rectangular grid
-	// TODO: Implement L, T, U, and Custom shapes in future iterations
-	if (ShapeDefinition.ShapeType == ERoomShape::Rectangle)
+	if (Plan.NumRejectedForcedPlacements > 0)
 	{
-		const int32 Width = ShapeDefinition.RectWidth;
-		const int32 Height = ShapeDefinition.RectHeight;
-
-		for (int32 Y = 0; Y < Height; Y++)
-		{
-			for (int32 X = 0; X < Width; X++)
-			{
-				FGridCell Cell;
-				Cell.GridCoordinates = FIntPoint(X, Y);
-				Cell.CellState = ECellState::Occupied;
-				Cell.WorldPosition = GridToWorldPosition(FIntPoint(X, Y));
-
-				// Set walls on edges
-				Cell.bHasNorthWall = (Y == Height - 1);
-				Cell.bHasEastWall = (X == Width - 1);
-				Cell.bHasSouthWall = (Y == 0);
-				Cell.bHasWestWall = (X == 0);
-
-				Grid.Add(Cell);
-			}
-		}
+		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::FinishCommit - %d forced placements were rejected due to overlaps"), Plan.NumRejectedForcedPlacements);
 	}
-}
-
-void AMasterRoom::GenerateFloorMeshes()
-{
-	// Placeholder implementation
-	// TODO: Load floor meshes from RoomData->FloorData and spawn them
-	// For now, just ensure we have the container ready
-}
 
-void AMasterRoom::GenerateWallMeshes()
-{
-	// Placeholder implementation
-	// TODO: Load wall meshes from RoomData->WallData and spawn them
-	// For now, just ensure we have the container ready
-}
-
-void AMasterRoom::GenerateCeilingMeshes()
-{
-	// Placeholder implementation
-	// TODO: Load ceiling meshes from RoomData->CeilingData and spawn them
-	// For now, just ensure we have the container ready
-}
+	RuntimeGrid = Plan.Grid;
 
-void AMasterRoom::GenerateDoorways()
-{
-	// Placeholder implementation
-	// TODO: Analyze grid, place doorways, and create snap points
-	// For now, just ensure we have the container ready
-}
-
-UStaticMeshComponent* AMasterRoom::SpawnMeshComponent(USceneComponent* Parent, UStaticMesh* Mesh, const FTransform& Transform)
-{
-	if (!Parent || !Mesh)
-void AMasterRoom::GenerateRoom()
-{
-	// Clear any existing generation first
-	if (bIsGenerated)
-	{
-		ClearRoom();
-	}
-
-	// Load and validate room data
-	if (!LoadRoomData())
-	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::GenerateRoom - Failed to load RoomData"));
-		return;
-	}
-
-	// Initialize random stream
-	if (bUseRandomSeed)
-	{
-		RandomStream.Initialize(FMath::Rand());
-	}
-	else
-	{
-		RandomStream.Initialize(GenerationSeed);
-	}
-
-	// Initialize the grid
-	InitializeGrid();
-
-	// Apply forced placements first (highest priority)
-	ApplyForcedPlacements();
-
-	// Generate floor tiles
-	GenerateFloorTiles();
-
-	// Generate walls
-	GenerateWalls();
-
-	// Generate ceiling
-	GenerateCeiling();
-
-	// Generate doorways
-	GenerateDoorways();
-
-	bIsGenerated = true;
-
-	// Update debug visualization
-	UpdateDebugVisualization();
-
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::GenerateRoom - Room generated successfully"));
-}
-
-void AMasterRoom::ClearRoom()
-{
-	// Destroy all spawned mesh components
-	TArray<USceneComponent*> ChildComponents;
-	
-	// Get all children of container components
-	if (FloorContainer)
+	// Occupied cells are owned by this room
+	RuntimeGrid.ForEachCellIndex([this](int32 CellIndex)
 	{
-		FloorContainer->GetChildrenComponents(true, ChildComponents);
-	}
-	if (WallContainer)
-	{
-		WallContainer->GetChildrenComponents(true, ChildComponents);
-	}
-	if (CeilingContainer)
-	{
-		CeilingContainer->GetChildrenComponents(true, ChildComponents);
-	}
-	if (DoorwayContainer)
-	{
-		DoorwayContainer->GetChildrenComponents(true, ChildComponents);
-	}
-
-	// Destroy each child component
-	for (USceneComponent* Child : ChildComponents)
-	{
-		if (Child)
+		if (RuntimeGrid.GetCellState(CellIndex) == ECellState::Occupied)
 		{
-			Child->DestroyComponent();
+			RuntimeGrid.SetOccupyingActor(CellIndex, this);
 		}
-	}
-
-	// Clear runtime state
-	Grid.Empty();
-	DoorwaySnapPoints.Empty();
-	DoorwayDirections.Empty();
-	bIsGenerated = false;
-
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::ClearRoom - Room cleared successfully"));
-}
-
-void AMasterRoom::RegenerateRoom()
-{
-	ClearRoom();
-	GenerateRoom();
-}
-
-void AMasterRoom::UpdateDebugVisualization()
-{
-	if (!DebugHelper)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::UpdateDebugVisualization - DebugHelper is null"));
-		return;
-	}
-
-	UWorld* World = GetWorld();
-	if (!World)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::UpdateDebugVisualization - World is null"));
-		return;
-	}
-
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::UpdateDebugVisualization - RoomData is null"));
-		return;
-	}
-
-	const float CellSize = LoadedRoomData->GridConfig.CellSize;
-	const FVector OwnerLocation = GetActorLocation();
-
-	// Draw grid lines
-	DebugHelper->DrawGrid(Grid, CellSize, OwnerLocation, World);
+	});
 
-	// Draw occupied cells
-	DebugHelper->DrawOccupiedCells(Grid, CellSize, OwnerLocation, World);
+	// Remember what was built, whichever path committed it, so the next edit can be applied incrementally
+	CommittedPlan = Plan;
+	CommittedLayoutInput = LayoutInput;
 
-	// Draw unoccupied cells
-	DebugHelper->DrawUnoccupiedCells(Grid, CellSize, OwnerLocation, World);
+	// Rebuild the debug overlay if the layout changed
+	UpdateDebugOverlay();
 
-	// Draw forced placements
-	DebugHelper->DrawForcedPlacements(ForcedFloorPlacements, CellSize, OwnerLocation, World);
+	bIsGenerated = true;
+	DUNGEONGEN_COUNTER_ADD(RoomsCommitted, 1);
+	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::FinishCommit - Room generation completed successfully"));
 
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::UpdateDebugVisualization - Debug visualization updated"));
+	OnRoomGenerated.Broadcast(this);
 }
 
-void AMasterRoom::InitializeGrid()
+void AMasterRoom::CleanupRoom()
 {
-	// Get the active room shape
-	FRoomShapeDefinition ActiveShape = GetActiveRoomShape();
-
-	// Clear existing grid
-	Grid.Empty();
-
-	// Get cell size from RoomData
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData)
-	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::InitializeGrid - RoomData is null"));
-		return;
-	}
+	DUNGEONGEN_SCOPE(CleanupRoom);
 
-	const float CellSize = LoadedRoomData->GridConfig.CellSize;
+	// Destroy all child components in containers
+	TArray<USceneComponent*> ContainersToClean = {FloorContainer, WallContainer, DoorContainer, CeilingContainer};
 
-	// Generate grid based on shape type
-	switch (ActiveShape.ShapeType)
-	{
-		case ERoomShape::Rectangle:
-		{
-			// Simple rectangular grid
-			for (int32 Y = 0; Y < ActiveShape.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < ActiveShape.RectWidth; ++X)
-				{
-					FGridCell Cell;
-					Cell.GridCoordinates = FIntPoint(X, Y);
-					Cell.CellState = ECellState::Unoccupied;
-					Cell.WorldPosition = GetActorLocation() + FVector(X * CellSize, Y * CellSize, 0.0f);
-					Grid.Add(Cell);
-				}
-			}
-			break;
-		}
-		case ERoomShape::Custom:
+	for (USceneComponent* Container : ContainersToClean)
+	{
+		if (Container)
 		{
-			// Generate custom shape grid
-			for (int32 Y = 0; Y < Shape.CustomLayoutHeight; ++Y)
-			{
-				for (int32 X = 0; X < Shape.CustomLayoutWidth; ++X)
-				{
-					int32 Index = Y * Shape.CustomLayoutWidth + X;
-					if (Index < Shape.CustomCellLayout.Num() && Shape.CustomCellLayout[Index] == 1)
-					{
-						FGridCell Cell;
-						Cell.GridCoordinates = FIntPoint(X, Y);
-						Cell.CellState = ECellState::Occupied;
-						
-						Cell.WorldPosition = FVector(
-							X * CellSize - (Shape.CustomLayoutWidth * CellSize) / 2.0f + CellSize / 2.0f,
-							Y * CellSize - (Shape.CustomLayoutHeight * CellSize) / 2.0f + CellSize / 2.0f,
-							0.0f
-						);
-
-						// Check neighbors for walls
-						int32 NorthIndex = (Y + 1) * Shape.CustomLayoutWidth + X;
-						int32 SouthIndex = (Y - 1) * Shape.CustomLayoutWidth + X;
-						int32 EastIndex = Y * Shape.CustomLayoutWidth + (X + 1);
-						int32 WestIndex = Y * Shape.CustomLayoutWidth + (X - 1);
-
-						Cell.bHasNorthWall = (Y == Shape.CustomLayoutHeight - 1 || NorthIndex >= Shape.CustomCellLayout.Num() || Shape.CustomCellLayout[NorthIndex] == 0);
-						Cell.bHasSouthWall = (Y == 0 || SouthIndex < 0 || Shape.CustomCellLayout[SouthIndex] == 0);
-						Cell.bHasEastWall = (X == Shape.CustomLayoutWidth - 1 || EastIndex >= Shape.CustomCellLayout.Num() || Shape.CustomCellLayout[EastIndex] == 0);
-						Cell.bHasWestWall = (X == 0 || WestIndex < 0 || Shape.CustomCellLayout[WestIndex] == 0);
-
-			// Custom shape based on layout array
-			if (ActiveShape.CustomCellLayout.Num() != ActiveShape.CustomLayoutWidth * ActiveShape.CustomLayoutHeight)
-			{
-				UE_LOG(LogTemp, Error, TEXT("AMasterRoom::InitializeGrid - Custom layout array size mismatch"));
-				return;
-			}
+			TArray<USceneComponent*> Children;
+			Container->GetChildrenComponents(false, Children);
 
-			for (int32 Y = 0; Y < ActiveShape.CustomLayoutHeight; ++Y)
+			for (USceneComponent* Child : Children)
 			{
-				for (int32 X = 0; X < ActiveShape.CustomLayoutWidth; ++X)
+				if (UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Child))
 				{
-					int32 Index = Y * ActiveShape.CustomLayoutWidth + X;
-					if (ActiveShape.CustomCellLayout[Index] == 1)
-					{
-						FGridCell Cell;
-						Cell.GridCoordinates = FIntPoint(X, Y);
-						Cell.CellState = ECellState::Unoccupied;
-						Cell.WorldPosition = GetActorLocation() + FVector(X * CellSize, Y * CellSize, 0.0f);
-						Grid.Add(Cell);
-					}
+					// Kept registered for the next generation instead of being destroyed and recreated
+					ReleaseMeshComponent(MeshComponent);
 				}
-			}
-			break;
-		}
-		case ERoomShape::LShape:
-		case ERoomShape::TShape:
-		case ERoomShape::UShape:
-		{
-			// L, T, U shapes - for now, treat as rectangles (can be enhanced later)
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateGrid - L/T/U shapes not yet fully implemented, generating simple rectangle"));
-			
-			// Generate rectangular grid directly without recursion
-			const int32 Width = FMath::Max(Shape.RectWidth, 5);
-			const int32 Height = FMath::Max(Shape.RectHeight, 5);
-			
-			for (int32 Y = 0; Y < Height; ++Y)
-			{
-				for (int32 X = 0; X < Width; ++X)
-				{
-					FGridCell Cell;
-					Cell.GridCoordinates = FIntPoint(X, Y);
-					Cell.CellState = ECellState::Occupied;
-					
-					// Calculate world position (centered on origin)
-					Cell.WorldPosition = FVector(
-						X * CellSize - (Width * CellSize) / 2.0f + CellSize / 2.0f,
-						Y * CellSize - (Height * CellSize) / 2.0f + CellSize / 2.0f,
-						0.0f
-					);
-
-					// Set perimeter walls
-					Cell.bHasNorthWall = (Y == Height - 1);
-					Cell.bHasSouthWall = (Y == 0);
-					Cell.bHasEastWall = (X == Width - 1);
-					Cell.bHasWestWall = (X == 0);
-
-		default:
-		{
-			// For L, T, U shapes - implement as simple rectangles for now
-			// These would require more complex shape generation logic
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::InitializeGrid - L/T/U shapes not yet implemented, using rectangle"));
-			for (int32 Y = 0; Y < ActiveShape.RectHeight; ++Y)
-			{
-				for (int32 X = 0; X < ActiveShape.RectWidth; ++X)
+				else if (Child)
 				{
-					FGridCell Cell;
-					Cell.GridCoordinates = FIntPoint(X, Y);
-					Cell.CellState = ECellState::Unoccupied;
-					Cell.WorldPosition = GetActorLocation() + FVector(X * CellSize, Y * CellSize, 0.0f);
-					Grid.Add(Cell);
+					Child->DestroyComponent();
 				}
 			}
-			break;
 		}
 	}
-}
 
-void AMasterRoom::SpawnFloorMeshes()
-{
-	// Placeholder - actual mesh spawning to be implemented with asset loading
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::SpawnFloorMeshes - Placeholder"));
+	if (DebugOverlay)
+	{
+		DebugOverlay->ClearRoomLayout();
+	}
+
+	// Clear runtime grid and instance bookkeeping (the components themselves were pooled or destroyed above)
+	RuntimeGrid.Empty();
+	InstanceBatches.Empty();
+	PendingInstanceBatches.Empty();
+	CommittedPlan = FRoomBuildPlan();
+	CommittedLayoutInput = FRoomLayoutInput();
+
+	// Clear doorway snap points
+	NorthDoorwaySnapPoints.Empty();
+	EastDoorwaySnapPoints.Empty();
+	SouthDoorwaySnapPoints.Empty();
+	WestDoorwaySnapPoints.Empty();
+
+	bIsGenerated = false;
 }
 
-void AMasterRoom::SpawnWallMeshes()
+void AMasterRoom::RegenerateWithNewSeed()
 {
-	// Placeholder - actual mesh spawning to be implemented with asset loading
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::SpawnWallMeshes - Placeholder"));
+	// Generate a new random seed
+	GenerationSeed = FDungeonSeed::MakeRandomSeed();
+	bUseRandomSeed = false;
+
+	// Regenerate room
+	GenerateRoom();
 }
 
-void AMasterRoom::SpawnCeilingMeshes()
+FVector AMasterRoom::GetWorldPositionForCell(const FIntPoint& GridCoord, float ZOffset) const
 {
-	// Placeholder - actual mesh spawning to be implemented with asset loading
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::SpawnCeilingMeshes - Placeholder"));
+	float CellSize = GetCellSize();
+
+	// Calculate world position from grid coordinates
+	// Grid origin is at actor location
+	FVector WorldPos;
+	WorldPos.X = GridCoord.X * CellSize;
+	WorldPos.Y = GridCoord.Y * CellSize;
+	WorldPos.Z = ZOffset;
+
+	return GetActorLocation() + WorldPos;
 }
 
-void AMasterRoom::SpawnDoorwayMeshes()
+bool AMasterRoom::IsValidGridPosition(const FIntPoint& GridCoord) const
 {
-	// Placeholder - actual mesh spawning to be implemented with asset loading
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::SpawnDoorwayMeshes - Placeholder"));
+	return RuntimeGrid.Contains(GridCoord);
 }
 
-void AMasterRoom::CalculateDoorwaySnapPoints()
+float AMasterRoom::GetCellSize() const
 {
-	DoorwaySnapPoints.Empty();
-	DoorwayDirections.Empty();
+	// Resolved once per generation
+	if (GenerationContext.IsValid())
+	{
+		return GenerationContext.CellSize;
+	}
 
-	// Calculate snap points from grid cells with doorways
-	for (const FGridCell& Cell : Grid)
+	if (!RoomData.IsNull())
 	{
-		if (Cell.bHasNorthDoorway)
-		{
-			DoorwaySnapPoints.Add(Cell.WorldPosition + FVector(0, 50.0f, 0)); // Offset to edge
-			DoorwayDirections.Add(EWallDirection::North);
-		}
-		if (Cell.bHasEastDoorway)
-		{
-			DoorwaySnapPoints.Add(Cell.WorldPosition + FVector(50.0f, 0, 0));
-			DoorwayDirections.Add(EWallDirection::East);
-		}
-		if (Cell.bHasSouthDoorway)
-		{
-			DoorwaySnapPoints.Add(Cell.WorldPosition + FVector(0, -50.0f, 0));
-			DoorwayDirections.Add(EWallDirection::South);
-		}
-		if (Cell.bHasWestDoorway)
+		URoomData* LoadedRoomData = RoomData.LoadSynchronous();
+		if (LoadedRoomData)
 		{
-			DoorwaySnapPoints.Add(Cell.WorldPosition + FVector(-50.0f, 0, 0));
-			DoorwayDirections.Add(EWallDirection::West);
+			return LoadedRoomData->GridConfig.CellSize;
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::InitializeGrid - Grid initialized with %d cells"), Grid.Num());
+	// Default cell size
+	return 100.0f;
+}
+
+USceneComponent* AMasterRoom::GetContainer(ERoomContainer Container) const
+{
+	switch (Container)
+	{
+	case ERoomContainer::Floor:
+		return FloorContainer;
+	case ERoomContainer::Wall:
+		return WallContainer;
+	case ERoomContainer::Door:
+		return DoorContainer;
+	case ERoomContainer::Ceiling:
+		return CeilingContainer;
+	default:
+		return nullptr;
+	}
 }
 
-void AMasterRoom::ApplyForcedPlacements()
+void AMasterRoom::SpawnMeshAtTransform(UStaticMesh* Mesh, UMaterialInterface* Material, USceneComponent* ParentContainer, const FTransform& WorldTransform,
+	const FRoomInstanceCellRef& CellRef, const FString& ComponentName)
 {
-	// Apply forced floor placements
-	for (const TPair<FIntPoint, FMeshPlacementData>& Pair : ForcedFloorPlacements)
+	if (!Mesh || !ParentContainer)
 	{
-		const FIntPoint& BottomLeft = Pair.Key;
-		const FMeshPlacementData& PlacementData = Pair.Value;
+		return;
+	}
 
-		// Check if placement is valid
-		if (!CanPlaceMeshAt(BottomLeft, PlacementData.CellsX, PlacementData.CellsY))
+	if (bUseInstancedMeshes)
+	{
+		// Queue into the batch for this mesh/material/container (spawned in bulk by FlushInstanceBatches)
+		FPendingInstanceBatch* Batch = PendingInstanceBatches.FindByPredicate([&](const FPendingInstanceBatch& Pending)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::ApplyForcedPlacements - Forced floor placement at (%d, %d) with size (%dx%d) overlaps occupied cells or is out of bounds. Rejecting."),
-				BottomLeft.X, BottomLeft.Y, PlacementData.CellsX, PlacementData.CellsY);
-			continue;
-		}
-
-		// Mark cells as occupied
-		MarkCellsOccupied(BottomLeft, PlacementData.CellsX, PlacementData.CellsY);
+			return Pending.Mesh == Mesh && Pending.Material == Material && Pending.ParentContainer == ParentContainer;
+		});
 
-		// Spawn the mesh
-		if (PlacementData.Mesh.IsValid())
+		if (!Batch)
 		{
-			UStaticMesh* Mesh = PlacementData.Mesh.LoadSynchronous();
-			if (Mesh)
-			{
-				FVector WorldPosition = CalculateWorldPositionForCell(BottomLeft, PlacementData);
-				SpawnMeshAtPosition(WorldPosition, Mesh, PlacementData, FloorContainer);
-			}
+			Batch = &PendingInstanceBatches.AddDefaulted_GetRef();
+			Batch->Mesh = Mesh;
+			Batch->Material = Material;
+			Batch->ParentContainer = ParentContainer;
 		}
+
+		Batch->Transforms.Add(WorldTransform);
+		Batch->InstanceCells.Add(CellRef);
+		return;
+	}
+
+	// Legacy path: one static mesh component per placement
+	UStaticMeshComponent* MeshComponent = AcquireMeshComponent(UStaticMeshComponent::StaticClass(), Mesh, ParentContainer, FName(*ComponentName));
+	if (!MeshComponent)
+	{
+		return;
 	}
 
-	// Apply forced wall placements (similar logic)
-	for (const TPair<FIntPoint, FMeshPlacementData>& Pair : ForcedWallPlacements)
+	if (Material)
 	{
-		const FIntPoint& Position = Pair.Key;
-		const FMeshPlacementData& PlacementData = Pair.Value;
+		MeshComponent->SetMaterial(0, Material);
+	}
+	MeshComponent->SetWorldTransform(WorldTransform);
+	DUNGEONGEN_COUNTER_ADD(InstancesSpawned, 1);
+}
+
+void AMasterRoom::FlushInstanceBatches()
+{
+	DUNGEONGEN_SCOPE(FlushInstanceBatches);
+
+	UClass* ComponentClass = bUseHierarchicalInstancing
+		? UHierarchicalInstancedStaticMeshComponent::StaticClass()
+		: UInstancedStaticMeshComponent::StaticClass();
 
-		// Check if placement is valid
-		if (!CanPlaceMeshAt(Position, PlacementData.CellsX, PlacementData.CellsY))
+	for (FPendingInstanceBatch& Pending : PendingInstanceBatches)
+	{
+		if (Pending.Transforms.Num() == 0)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::ApplyForcedPlacements - Forced wall placement at (%d, %d) overlaps occupied cells or is out of bounds. Rejecting."),
-				Position.X, Position.Y);
 			continue;
 		}
 
-		// Mark cells as occupied/reserved
-		MarkCellsOccupied(Position, PlacementData.CellsX, PlacementData.CellsY);
-
-		// Spawn the mesh
-		if (PlacementData.Mesh.IsValid())
+		// Append to an existing batch for the same mesh, material and container (incremental commits)
+		UMaterialInterface* BatchMaterial = Pending.Material ? Pending.Material : Pending.Mesh->GetMaterial(0);
+		FRoomInstanceBatch* ExistingBatch = InstanceBatches.FindByPredicate([&Pending, ComponentClass, BatchMaterial](const FRoomInstanceBatch& Batch)
 		{
-			UStaticMesh* Mesh = PlacementData.Mesh.LoadSynchronous();
-			if (Mesh)
-			{
-				FVector WorldPosition = CalculateWorldPositionForCell(Position, PlacementData);
-				SpawnMeshAtPosition(WorldPosition, Mesh, PlacementData, WallContainer);
-			}
-		}
-	}
+			return Batch.Component && Batch.Component->GetClass() == ComponentClass && Batch.Component->GetStaticMesh() == Pending.Mesh
+				&& Batch.Component->GetAttachParent() == Pending.ParentContainer && Batch.Component->GetMaterial(0) == BatchMaterial;
+		});
 
-	// Apply forced ceiling placements
-	for (const TPair<FIntPoint, FMeshPlacementData>& Pair : ForcedCeilingPlacements)
-	{
-		const FIntPoint& BottomLeft = Pair.Key;
-		const FMeshPlacementData& PlacementData = Pair.Value;
+		DUNGEONGEN_COUNTER_ADD(InstancesSpawned, Pending.Transforms.Num());
 
-		// Check if placement is valid
-		if (!CanPlaceMeshAt(BottomLeft, PlacementData.CellsX, PlacementData.CellsY))
+		if (ExistingBatch)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::ApplyForcedPlacements - Forced ceiling placement at (%d, %d) overlaps occupied cells or is out of bounds. Rejecting."),
-				BottomLeft.X, BottomLeft.Y);
+			ExistingBatch->Component->AddInstances(Pending.Transforms, false, true);
+			ExistingBatch->InstanceCells.Append(MoveTemp(Pending.InstanceCells));
 			continue;
 		}
 
-		// Mark cells as occupied
-		MarkCellsOccupied(BottomLeft, PlacementData.CellsX, PlacementData.CellsY);
+		const FName ComponentName(*FString::Printf(TEXT("ISM_%s_%s"), *Pending.ParentContainer->GetName(), *Pending.Mesh->GetName()));
 
-		// Spawn the mesh
-		if (PlacementData.Mesh.IsValid())
+		UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(
+			AcquireMeshComponent(ComponentClass, Pending.Mesh, Pending.ParentContainer, ComponentName));
+		if (!InstancedComponent)
 		{
-			UStaticMesh* Mesh = PlacementData.Mesh.LoadSynchronous();
-			if (Mesh)
-			{
-				FVector WorldPosition = CalculateWorldPositionForCell(BottomLeft, PlacementData);
-				SpawnMeshAtPosition(WorldPosition, Mesh, PlacementData, CeilingContainer);
-			}
+			continue;
 		}
-	}
-
-	// Apply forced doorway placements
-	for (const TPair<FIntPoint, FMeshPlacementData>& Pair : ForcedDoorwayPlacements)
-	{
-		const FIntPoint& Position = Pair.Key;
-		const FMeshPlacementData& PlacementData = Pair.Value;
 
-		// Spawn the mesh (doorways don't necessarily occupy cells)
-		if (PlacementData.Mesh.IsValid())
+		if (Pending.Material)
 		{
-			UStaticMesh* Mesh = PlacementData.Mesh.LoadSynchronous();
-			if (Mesh)
-			{
-				FVector WorldPosition = CalculateWorldPositionForCell(Position, PlacementData);
-				SpawnMeshAtPosition(WorldPosition, Mesh, PlacementData, DoorwayContainer);
-			}
+			InstancedComponent->SetMaterial(0, Pending.Material);
 		}
-	}
-}
 
-void AMasterRoom::GenerateFloorTiles()
-{
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->FloorData.IsValid())
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateFloorTiles - No floor data available"));
-		return;
-	}
+		// Add all transforms in one call (world space, no index array needed since order is preserved)
+		InstancedComponent->AddInstances(Pending.Transforms, false, true);
 
-	UFloorData* FloorData = LoadedRoomData->FloorData.LoadSynchronous();
-	if (!FloorData || FloorData->FloorTiles.Num() == 0)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateFloorTiles - Floor data has no tiles"));
-		return;
+		FRoomInstanceBatch& Batch = InstanceBatches.AddDefaulted_GetRef();
+		Batch.Component = InstancedComponent;
+		Batch.InstanceCells = MoveTemp(Pending.InstanceCells);
 	}
 
-	// Sort floor tiles by footprint size (largest first)
-	TArray<FMeshPlacementData> SortedTiles = FloorData->FloorTiles;
-	SortedTiles.Sort([](const FMeshPlacementData& A, const FMeshPlacementData& B)
-	{
-		return (A.CellsX * A.CellsY) > (B.CellsX * B.CellsY);
-	});
+	PendingInstanceBatches.Empty();
+}
 
-	// First pass: Place multi-cell tiles (largest to smallest)
-	for (const FMeshPlacementData& TileData : SortedTiles)
+UStaticMeshComponent* AMasterRoom::AcquireMeshComponent(UClass* ComponentClass, UStaticMesh* Mesh, USceneComponent* ParentContainer, FName BaseName)
+{
+	auto PopFromBucket = [this, ComponentClass](FRoomComponentPoolBucket& Bucket) -> UStaticMeshComponent*
 	{
-		if (TileData.CellsX == 1 && TileData.CellsY == 1)
+		for (int32 Index = Bucket.Components.Num() - 1; Index >= 0; --Index)
 		{
-			continue; // Skip single-cell tiles for now
-		}
-
-		// Try to place this tile type in available locations
-		for (FGridCell& Cell : Grid)
-		{
-			if (Cell.CellState == ECellState::Unoccupied)
+			UStaticMeshComponent* Candidate = Bucket.Components[Index];
+			if (!IsValid(Candidate) || Candidate->GetClass() == ComponentClass)
 			{
-				// Check if we can place this multi-cell tile here
-				if (CanPlaceMeshAt(Cell.GridCoordinates, TileData.CellsX, TileData.CellsY))
+				Bucket.Components.RemoveAtSwap(Index, EAllowShrinking::No);
+				--NumPooledComponents;
+
+				if (IsValid(Candidate))
 				{
-					// Use weighted random selection based on SelectionWeight
-					if (RandomStream.FRand() <= (TileData.SelectionWeight / SELECTION_WEIGHT_SCALE))
-					{
-						// Place the tile
-						MarkCellsOccupied(Cell.GridCoordinates, TileData.CellsX, TileData.CellsY);
-
-						if (TileData.Mesh.IsValid())
-						{
-							UStaticMesh* Mesh = TileData.Mesh.LoadSynchronous();
-							if (Mesh)
-							{
-								FVector WorldPosition = CalculateWorldPositionForCell(Cell.GridCoordinates, TileData);
-								SpawnMeshAtPosition(WorldPosition, Mesh, TileData, FloorContainer);
-							}
-						}
-					}
+					return Candidate;
 				}
 			}
 		}
-	}
+		return nullptr;
+	};
 
-	// Second pass: Fill remaining cells with single-cell tiles
-	TArray<FMeshPlacementData> SingleCellTiles;
-	for (const FMeshPlacementData& TileData : FloorData->FloorTiles)
+	// Same mesh first (only the attachment and transform change), then any pooled component of the class
+	UStaticMeshComponent* Component = nullptr;
+	if (FRoomComponentPoolBucket* MeshBucket = ComponentPool.Find(Mesh))
 	{
-		if (TileData.CellsX == 1 && TileData.CellsY == 1)
-		{
-			SingleCellTiles.Add(TileData);
-		}
+		Component = PopFromBucket(*MeshBucket);
 	}
 
-	if (SingleCellTiles.Num() > 0)
+	for (TPair<UStaticMesh*, FRoomComponentPoolBucket>& Pair : ComponentPool)
 	{
-		// Calculate total weight
-		float TotalWeight = 0.0f;
-		for (const FMeshPlacementData& TileData : SingleCellTiles)
-		{
-			TotalWeight += TileData.SelectionWeight;
-		}
-
-		// Fill remaining unoccupied cells
-		for (FGridCell& Cell : Grid)
+		if (Component)
 		{
-			if (Cell.CellState == ECellState::Unoccupied)
-			{
-				// Weighted random selection
-				float RandomValue = RandomStream.FRand() * TotalWeight;
-				float CurrentWeight = 0.0f;
-
-				for (const FMeshPlacementData& TileData : SingleCellTiles)
-				{
-					CurrentWeight += TileData.SelectionWeight;
-					if (RandomValue <= CurrentWeight)
-					{
-						// Place this tile
-						Cell.CellState = ECellState::Occupied;
-
-						if (TileData.Mesh.IsValid())
-						{
-							UStaticMesh* Mesh = TileData.Mesh.LoadSynchronous();
-							if (Mesh)
-							{
-								FVector WorldPosition = CalculateWorldPositionForCell(Cell.GridCoordinates, TileData);
-								SpawnMeshAtPosition(WorldPosition, Mesh, TileData, FloorContainer);
-							}
-						}
-						break;
-					}
-				}
-			}
+			break;
 		}
+		Component = PopFromBucket(Pair.Value);
 	}
-}
 
-void AMasterRoom::GenerateWalls()
-{
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->WallData.IsValid())
+	if (Component)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateWalls - No wall data available"));
-		return;
+		if (Component->GetStaticMesh() != Mesh)
+		{
+			Component->SetStaticMesh(Mesh);
+		}
+		Component->AttachToComponent(ParentContainer, FAttachmentTransformRules::KeepRelativeTransform);
+		Component->SetCollisionEnabled(ComponentClass->GetDefaultObject<UStaticMeshComponent>()->GetCollisionEnabled());
+		Component->SetVisibility(true);
+		return Component;
 	}
 
-	UWallData* WallDataAsset = LoadedRoomData->WallData.LoadSynchronous();
-	if (!WallDataAsset)
+	Component = NewObject<UStaticMeshComponent>(this, ComponentClass, MakeUniqueObjectName(this, ComponentClass, BaseName));
+	if (!Component)
 	{
-		return;
+		return nullptr;
 	}
 
-	// Wall generation logic would analyze grid cells and place walls at boundaries
-	// For now, this is a placeholder that would need full implementation
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::GenerateWalls - Wall generation placeholder"));
+	Component->SetStaticMesh(Mesh);
+	Component->SetupAttachment(ParentContainer);
+	Component->RegisterComponent();
+	return Component;
 }
 
-void AMasterRoom::GenerateCeiling()
+void AMasterRoom::ReleaseMeshComponent(UStaticMeshComponent* Component)
 {
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->CeilingData.IsValid())
+	if (NumPooledComponents >= MaxPooledComponents)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateCeiling - No ceiling data available"));
+		Component->DestroyComponent();
 		return;
 	}
 
-	UCeilingData* CeilingDataAsset = LoadedRoomData->CeilingData.LoadSynchronous();
-	if (!CeilingDataAsset || CeilingDataAsset->CeilingTiles.Num() == 0)
+	if (UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(Component))
 	{
-		return;
+		InstancedComponent->ClearInstances();
 	}
 
-	// Generate ceiling tiles similar to floor tiles but at ceiling height
-	const float CeilingHeight = CeilingDataAsset->CeilingHeightOffset;
+	// Hidden components are not added to the scene; parking them under the root keeps them out of the containers' children
+	Component->EmptyOverrideMaterials();
+	Component->SetVisibility(false);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->AttachToComponent(RootSceneComponent, FAttachmentTransformRules::KeepRelativeTransform);
+
+	ComponentPool.FindOrAdd(Component->GetStaticMesh()).Components.Add(Component);
+	++NumPooledComponents;
+}
 
-	// Use first ceiling tile for all cells (simple approach)
-	if (CeilingDataAsset->CeilingTiles.Num() > 0)
+void AMasterRoom::TrimComponentPool(int32 MaxComponentsToKeep)
+{
+	for (auto It = ComponentPool.CreateIterator(); It && NumPooledComponents > MaxComponentsToKeep; ++It)
 	{
-		const FMeshPlacementData& TileData = CeilingDataAsset->CeilingTiles[0];
-		
-		if (TileData.Mesh.IsValid())
+		TArray<UStaticMeshComponent*>& Components = It.Value().Components;
+		while (Components.Num() > 0 && NumPooledComponents > MaxComponentsToKeep)
 		{
-			UStaticMesh* Mesh = TileData.Mesh.LoadSynchronous();
-			if (Mesh)
+			UStaticMeshComponent* Component = Components.Pop(EAllowShrinking::No);
+			--NumPooledComponents;
+
+			if (IsValid(Component))
 			{
-				for (const FGridCell& Cell : Grid)
-				{
-					if (Cell.CellState == ECellState::Occupied || Cell.CellState == ECellState::Unoccupied)
-					{
-						FVector WorldPosition = CalculateWorldPositionForCell(Cell.GridCoordinates, TileData);
-						WorldPosition.Z += CeilingHeight;
-						SpawnMeshAtPosition(WorldPosition, Mesh, TileData, CeilingContainer);
-					}
-				}
+				Component->DestroyComponent();
 			}
 		}
+
+		if (Components.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
 	}
 }
 
-void AMasterRoom::GenerateDoorways()
+FRoomMemoryStats AMasterRoom::GetMemoryStats() const
 {
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData || !LoadedRoomData->DoorData.IsValid())
+	FRoomMemoryStats Stats;
+	Stats.NumCells = RuntimeGrid.Num();
+	Stats.NumPooledComponents = NumPooledComponents;
+	Stats.GridBytes = RuntimeGrid.GetAllocatedSize();
+	Stats.PlanBytes = CommittedPlan.GetAllocatedSize() + CommittedLayoutInput.GetAllocatedSize();
+
+	Stats.BookkeepingBytes = GenerationContext.Meshes.GetAllocatedSize() + GenerationContext.Materials.GetAllocatedSize()
+		+ InstanceBatches.GetAllocatedSize() + PendingInstanceBatches.GetAllocatedSize() + ComponentPool.GetAllocatedSize()
+		+ RoomAssetHandles.GetAllocatedSize() + NorthDoorwaySnapPoints.GetAllocatedSize() + EastDoorwaySnapPoints.GetAllocatedSize()
+		+ SouthDoorwaySnapPoints.GetAllocatedSize() + WestDoorwaySnapPoints.GetAllocatedSize();
+	for (const FRoomInstanceBatch& Batch : InstanceBatches)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AMasterRoom::GenerateDoorways - No door data available"));
-		return;
+		Stats.BookkeepingBytes += Batch.InstanceCells.GetAllocatedSize();
 	}
-
-	UDoorData* DoorDataAsset = LoadedRoomData->DoorData.LoadSynchronous();
-	if (!DoorDataAsset)
+	for (const TPair<UStaticMesh*, FRoomComponentPoolBucket>& Bucket : ComponentPool)
 	{
-		return;
+		Stats.BookkeepingBytes += Bucket.Value.Components.GetAllocatedSize();
 	}
 
-	// Doorway generation logic would analyze room boundaries and place doorways
-	// For now, this is a placeholder
-	UE_LOG(LogTemp, Log, TEXT("AMasterRoom::GenerateDoorways - Doorway generation placeholder"));
-}
-
-bool AMasterRoom::CanPlaceMeshAt(const FIntPoint& BottomLeft, int32 CellsX, int32 CellsY) const
-{
-	// Check each cell in the footprint
-	for (int32 Y = 0; Y < CellsY; ++Y)
+	// Pooled components are hidden but still allocated, so they count towards the component bytes
+	TInlineComponentArray<UStaticMeshComponent*> MeshComponents(this);
+	for (UStaticMeshComponent* MeshComponent : MeshComponents)
 	{
-		for (int32 X = 0; X < CellsX; ++X)
-		{
-			FIntPoint CheckCoord = BottomLeft + FIntPoint(X, Y);
-			
-			// Find the cell in the grid
-			const FGridCell* FoundCell = Grid.FindByPredicate([CheckCoord](const FGridCell& Cell)
-			{
-				return Cell.GridCoordinates == CheckCoord;
-			});
+		const SIZE_T ResourceBytes = MeshComponent->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		Stats.ComponentBytes += MeshComponent->GetClass()->GetStructureSize();
 
-			// If cell doesn't exist or is not unoccupied, placement is invalid
-			if (!FoundCell || FoundCell->CellState != ECellState::Unoccupied)
-			{
-				return false;
-			}
+		if (const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent))
+		{
+			// Instanced components report their per-instance buffers as their resource size
+			Stats.InstanceBytes += ResourceBytes;
+			Stats.NumInstances += InstancedComponent->GetInstanceCount();
+		}
+		else
+		{
+			Stats.ComponentBytes += ResourceBytes;
 		}
+
+		Stats.NumComponents += MeshComponent->IsVisible() ? 1 : 0;
 	}
 
-	return true;
+	if (DebugHelpers)
+	{
+		Stats.DebugBytes = DebugHelpers->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	if (DebugOverlay)
+	{
+		Stats.DebugBytes += DebugOverlay->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	return Stats;
 }
 
-void AMasterRoom::MarkCellsOccupied(const FIntPoint& BottomLeft, int32 CellsX, int32 CellsY)
+void AMasterRoom::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
 {
-	for (int32 Y = 0; Y < CellsY; ++Y)
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// Components are objects of their own, so they only join the estimated total
+	const FRoomMemoryStats Stats = GetMemoryStats();
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Stats.GridBytes + Stats.PlanBytes + Stats.BookkeepingBytes);
+	if (CumulativeResourceSize.GetResourceMode() == EResourceSizeMode::EstimatedTotal)
 	{
-		for (int32 X = 0; X < CellsX; ++X)
-		{
-			FIntPoint TargetCoord = BottomLeft + FIntPoint(X, Y);
-			
-			// Find and mark the cell as occupied
-			for (FGridCell& Cell : Grid)
-			{
-				if (Cell.GridCoordinates == TargetCoord)
-				{
-					Cell.CellState = ECellState::Occupied;
-					break;
-				}
-			}
-		}
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Stats.ComponentBytes + Stats.InstanceBytes + Stats.DebugBytes);
 	}
 }
 
-UStaticMeshComponent* AMasterRoom::SpawnMeshAtPosition(const FVector& WorldPosition, UStaticMesh* Mesh, const FMeshPlacementData& PlacementData, USceneComponent* ParentComponent)
+bool AMasterRoom::GetCellsForMeshInstance(const UInstancedStaticMeshComponent* Component, int32 InstanceIndex, FIntPoint& OutBottomLeftCell, FIntPoint& OutFootprint) const
 {
-	if (!Mesh || !ParentComponent)
+	const FRoomInstanceBatch* Batch = InstanceBatches.FindByPredicate([Component](const FRoomInstanceBatch& Candidate)
 	{
-		return nullptr;
-	}
+		return Candidate.Component == Component;
+	});
 
-	// Create new static mesh component
-	UStaticMeshComponent* MeshComponent = NewObject<UStaticMeshComponent>(this);
-	if (MeshComponent)
-	{
-		MeshComponent->SetStaticMesh(Mesh);
-		MeshComponent->SetupAttachment(Parent);
-		MeshComponent->SetRelativeTransform(Transform);
-		MeshComponent->RegisterComponent();
-	// Create a new static mesh component
-	FString ComponentName = FString::Printf(TEXT("SpawnedMesh_%s"), *Mesh->GetName());
-	UStaticMeshComponent* MeshComponent = NewObject<UStaticMeshComponent>(this, *ComponentName);
-	
-	if (MeshComponent)
-	{
-		MeshComponent->SetStaticMesh(Mesh);
-		MeshComponent->SetupAttachment(ParentComponent);
-		MeshComponent->RegisterComponent();
-		MeshComponent->SetWorldLocation(WorldPosition);
-		
-		// Handle rotation if allowed
-		if (PlacementData.bAllowRotation)
-		{
-			// Random rotation in 90-degree increments
-			int32 RotationSteps = RandomStream.RandRange(0, 3);
-			FRotator Rotation(0.0f, RotationSteps * 90.0f, 0.0f);
-			MeshComponent->SetWorldRotation(Rotation);
-		}
+	if (!Batch || !Batch->InstanceCells.IsValidIndex(InstanceIndex))
+	{
+		return false;
 	}
 
-	return MeshComponent;
+	OutBottomLeftCell = Batch->InstanceCells[InstanceIndex].BottomLeftCell;
+	OutFootprint = Batch->InstanceCells[InstanceIndex].Footprint;
+	return true;
 }
 
-FVector AMasterRoom::GridToWorldPosition(const FIntPoint& GridCoord) const
+bool AMasterRoom::RemoveMeshInstance(UInstancedStaticMeshComponent* Component, int32 InstanceIndex)
 {
-	const float CellSize = GetCellSize();
-	
-	// Calculate world position (centered on cell)
-	const float WorldX = GridCoord.X * CellSize;
-	const float WorldY = GridCoord.Y * CellSize;
-	
-	return FVector(WorldX, WorldY, 0.0f);
-}
+	FRoomInstanceBatch* Batch = InstanceBatches.FindByPredicate([Component](const FRoomInstanceBatch& Candidate)
+	{
+		return Candidate.Component == Component;
+	});
 
-int32 AMasterRoom::GetEffectiveSeed() const
-{
-	if (bUseRandomSeed)
+	if (!Batch || !Component || !Batch->InstanceCells.IsValidIndex(InstanceIndex))
 	{
-		// Use system time for random seed generation
-		// This provides consistent cross-platform behavior
-		return static_cast<int32>(FDateTime::Now().GetTicks());
+		return false;
 	}
-	return GenerationSeed;
-FVector AMasterRoom::CalculateWorldPositionForCell(const FIntPoint& CellCoord, const FMeshPlacementData& PlacementData) const
-{
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData)
+
+	// Mirror the component's removal order so back-references stay index-aligned
+	const bool bRemoveAtSwap = Component->IsA<UHierarchicalInstancedStaticMeshComponent>() || Component->SupportsRemoveSwap();
+	if (!Component->RemoveInstance(InstanceIndex))
 	{
-		return FVector::ZeroVector;
+		return false;
 	}
 
-	const float CellSize = LoadedRoomData->GridConfig.CellSize;
-	FVector BasePosition = GetActorLocation() + FVector(CellCoord.X * CellSize, CellCoord.Y * CellSize, 0.0f);
-
-	// Adjust for pivot type
-	switch (PlacementData.PivotType)
+	if (bRemoveAtSwap)
 	{
-		case EMeshPivotType::CenterXY:
-		{
-			// Center the mesh on the cell(s)
-			float OffsetX = (PlacementData.CellsX * CellSize) / 2.0f;
-			float OffsetY = (PlacementData.CellsY * CellSize) / 2.0f;
-			BasePosition += FVector(OffsetX, OffsetY, 0.0f);
-			break;
-		}
-		case EMeshPivotType::BottomBackCenter:
-		{
-			// Center on X, back on Y
-			float OffsetX = (PlacementData.CellsX * CellSize) / 2.0f;
-			BasePosition += FVector(OffsetX, 0.0f, 0.0f);
-			break;
-		}
-		case EMeshPivotType::BottomCenter:
-		{
-			// Center on X and Y, bottom on Z
-			float OffsetX = (PlacementData.CellsX * CellSize) / 2.0f;
-			float OffsetY = (PlacementData.CellsY * CellSize) / 2.0f;
-			BasePosition += FVector(OffsetX, OffsetY, 0.0f);
-			break;
-		}
-		case EMeshPivotType::Custom:
-		{
-			BasePosition += PlacementData.CustomPivotOffset;
-			break;
-		}
+		Batch->InstanceCells.RemoveAtSwap(InstanceIndex);
+	}
+	else
+	{
+		Batch->InstanceCells.RemoveAt(InstanceIndex);
 	}
 
-	return BasePosition;
+	return true;
 }
 
-FRoomShapeDefinition AMasterRoom::GetActiveRoomShape() const
+void AMasterRoom::RefreshDebugVisualization()
 {
-	if (bOverrideShape)
+	if (bIsGenerated)
 	{
-		return ShapeOverride;
+		UpdateDebugOverlay();
 	}
+}
 
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (LoadedRoomData && LoadedRoomData->AllowedShapes.Num() > 0)
+bool AMasterRoom::ShouldDrawDebugOverlay() const
+{
+	if (!DebugHelpers || !DebugHelpers->bEnableDebugDraw)
+	{
+		return false;
+	}
+
+#if UE_BUILD_SHIPPING
+	// Shipping games never show it, so they don't pay for building it
+	const UWorld* World = GetWorld();
+	if (World && World->IsGameWorld())
 	{
-		// Use the first allowed shape
-		return LoadedRoomData->AllowedShapes[0];
+		return false;
 	}
+#endif
 
-	// Return default rectangular shape
-	FRoomShapeDefinition DefaultShape;
-	DefaultShape.ShapeType = ERoomShape::Rectangle;
-	DefaultShape.RectWidth = 5;
-	DefaultShape.RectHeight = 5;
-	return DefaultShape;
+	return true;
 }
 
-bool AMasterRoom::LoadRoomData()
+void AMasterRoom::UpdateDebugOverlay()
 {
-	if (!RoomData.IsValid())
+	if (!DebugOverlay)
 	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::LoadRoomData - RoomData is not set"));
-		return false;
+		return;
 	}
 
-	URoomData* LoadedRoomData = RoomData.LoadSynchronous();
-	if (!LoadedRoomData)
+	if (!ShouldDrawDebugOverlay())
 	{
-		UE_LOG(LogTemp, Error, TEXT("AMasterRoom::LoadRoomData - Failed to load RoomData"));
-		return false;
+		DebugOverlay->ClearRoomLayout();
+		return;
 	}
 
-	return true;
+	// Nothing fills the per-side snap point arrays any more, so the cells holding doorway edges are the snap points
+	TSet<FIntPoint> SnapPointSet;
+	RuntimeGrid.ForEachCellIndex([this, &SnapPointSet](int32 Index)
+	{
+		if (RuntimeGrid.GetDoorwayMask(Index) != 0)
+		{
+			SnapPointSet.Add(RuntimeGrid.ToCoord(Index));
+		}
+	});
+	SnapPointSet.Append(NorthDoorwaySnapPoints);
+	SnapPointSet.Append(EastDoorwaySnapPoints);
+	SnapPointSet.Append(SouthDoorwaySnapPoints);
+	SnapPointSet.Append(WestDoorwaySnapPoints);
+	const TArray<FIntPoint> SnapPoints = SnapPointSet.Array();
+
+	DebugOverlay->SetRoomLayout(RuntimeGrid, GetCellSize(), { &ForcedFloorPlacements, &ForcedWallPlacements, &ForcedCeilingPlacements }, SnapPoints);
 }
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+/** Varint helpers shared by the compact binary formats (seed data, room build cache blobs) */
+namespace DungeonGenArchive
+{
+	/** Upper bound on any count read back, so corrupt data cannot trigger huge allocations */
+	inline constexpr uint32 MaxCount = 1 << 20;
+
+	/** ZigZag: maps small negative values to small unsigned ones, so they pack as short varints */
+	FORCEINLINE uint32 ZigZagEncode(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	FORCEINLINE int32 ZigZagDecode(uint32 Encoded)
+	{
+		return static_cast<int32>((Encoded >> 1) ^ (0u - (Encoded & 1u)));
+	}
+
+	/** Signed varint (ZigZag, then 7-bit packing) */
+	inline void SerializeVarInt(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = ZigZagEncode(Value);
+		Ar.SerializeIntPacked(Encoded);
+
+		if (Ar.IsLoading())
+		{
+			Value = ZigZagDecode(Encoded);
+		}
+	}
+
+	/** Varint element count, rejected on load past MaxCount */
+	inline bool SerializeCount(FArchive& Ar, int32& Count)
+	{
+		uint32 Encoded = static_cast<uint32>(Count);
+		Ar.SerializeIntPacked(Encoded);
+
+		if (Ar.IsLoading())
+		{
+			if (Encoded > MaxCount)
+			{
+				Ar.SetError();
+				return false;
+			}
+			Count = static_cast<int32>(Encoded);
+		}
+
+		return !Ar.IsError();
+	}
+}
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "UObject/Package.h"
+#include "Rooms/MasterRoom.h"
+#include "Data/Room/RoomData.h"
+#include "Data/Room/FloorData.h"
+#include "Data/Room/WallData.h"
+#include "Data/Room/CeilingData.h"
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/RoomBuildCache.h"
+#include "Generation/DungeonSeed.h"
+
+namespace DungeonGenMasterRoomTests
+{
+	/** Engine basic shapes load without rendering, so the test runs with -nullrhi */
+	FMeshPlacementData MakeEnginePlacement(const TCHAR* MeshPath, int32 CellsX, int32 CellsY)
+	{
+		FMeshPlacementData Placement;
+		Placement.Mesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(MeshPath));
+		Placement.CellsX = CellsX;
+		Placement.CellsY = CellsY;
+		return Placement;
+	}
+
+	/** Transient room data with every ERoomShape but Custom allowed and one component data asset of each kind */
+	URoomData* MakeRoomData()
+	{
+		UFloorData* FloorData = NewObject<UFloorData>(GetTransientPackage());
+		FloorData->FloorTiles = { MakeEnginePlacement(TEXT("/Engine/BasicShapes/Plane.Plane"), 1, 1), MakeEnginePlacement(TEXT("/Engine/BasicShapes/Cube.Cube"), 2, 2) };
+
+		UWallData* WallData = NewObject<UWallData>(GetTransientPackage());
+		WallData->WallSegments = { MakeEnginePlacement(TEXT("/Engine/BasicShapes/Cube.Cube"), 1, 1), MakeEnginePlacement(TEXT("/Engine/BasicShapes/Cylinder.Cylinder"), 2, 1) };
+		WallData->OuterCorners = { MakeEnginePlacement(TEXT("/Engine/BasicShapes/Sphere.Sphere"), 1, 1) };
+
+		UCeilingData* CeilingData = NewObject<UCeilingData>(GetTransientPackage());
+		CeilingData->CeilingTiles = { MakeEnginePlacement(TEXT("/Engine/BasicShapes/Plane.Plane"), 1, 1) };
+
+		URoomData* RoomData = NewObject<URoomData>(GetTransientPackage());
+		RoomData->FloorData = FloorData;
+		RoomData->WallData = WallData;
+		RoomData->CeilingData = CeilingData;
+
+		for (ERoomShape ShapeType : { ERoomShape::Rectangle, ERoomShape::LShape, ERoomShape::TShape, ERoomShape::UShape })
+		{
+			FRoomShapeDefinition& Shape = RoomData->AllowedShapes.AddDefaulted_GetRef();
+			Shape.ShapeType = ShapeType;
+			Shape.RectWidth = 6;
+			Shape.RectHeight = 6;
+		}
+
+		return RoomData;
+	}
+
+	/** Rendered placements of a room: instances of visible instanced components plus visible single-mesh components */
+	int32 CountRenderedPlacements(AMasterRoom& Room)
+	{
+		int32 NumPlacements = 0;
+		TInlineComponentArray<UStaticMeshComponent*> MeshComponents(&Room);
+		for (const UStaticMeshComponent* MeshComponent : MeshComponents)
+		{
+			if (MeshComponent->IsVisible())
+			{
+				const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent);
+				NumPlacements += InstancedComponent ? InstancedComponent->GetInstanceCount() : 1;
+			}
+		}
+		return NumPlacements;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMasterRoomGenerateRoomTest, "DungeonGen.MasterRoom.GenerateRoom",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMasterRoomGenerateRoomTest::RunTest(const FString& Parameters)
+{
+	using namespace DungeonGenMasterRoomTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("DungeonGenMasterRoomTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AMasterRoom* Room = World->SpawnActorDeferred<AMasterRoom>(AMasterRoom::StaticClass(), FTransform::Identity);
+	Room->RoomData = MakeRoomData();
+	Room->bUseRandomSeed = false;
+	Room->bGenerateOnSpawn = false;
+	Room->bUseBuildCache = false;
+	Room->FinishSpawning(FTransform::Identity);
+
+	for (int32 SeedIndex = 0; SeedIndex < 16; ++SeedIndex)
+	{
+		Room->GenerationSeed = FDungeonSeed::DeriveRoomSeed(3, SeedIndex);
+		const FString Context = FString::Printf(TEXT("Seed %d"), Room->GenerationSeed);
+
+		// Reference plan for this seed
+		FRoomLayoutInput LayoutInput;
+		if (!TestTrue(FString::Printf(TEXT("%s: layout input prepared"), *Context), Room->PrepareLayoutInput(LayoutInput)))
+		{
+			break;
+		}
+		const FRoomBuildPlan Plan = FRoomLayoutSolver::Solve(LayoutInput);
+
+		// The committed room matches the plan, and regenerating with the same seed (reusing pooled components) changes nothing
+		Room->GenerateRoom();
+		TestTrue(FString::Printf(TEXT("%s: room generated"), *Context), Room->IsRoomGenerated());
+		TestEqual(FString::Printf(TEXT("%s: runtime grid matches the plan"), *Context), Room->GetGridCellCount(), Plan.Grid.Num());
+		TestEqual(FString::Printf(TEXT("%s: one rendered placement per plan entry"), *Context), CountRenderedPlacements(*Room), Plan.Entries.Num());
+
+		Room->GenerateRoom();
+		TestEqual(FString::Printf(TEXT("%s: regeneration is identical"), *Context), CountRenderedPlacements(*Room), Plan.Entries.Num());
+	}
+
+	// A build cache hit skips the solve and must commit the same room
+	Room->bUseBuildCache = true;
+	Room->GenerateRoom();
+	const int32 NumPlacements = CountRenderedPlacements(*Room);
+	const int64 NumHitsBefore = FRoomBuildCache::Get().GetNumHits();
+	Room->GenerateRoom();
+	TestTrue(TEXT("Build cache hit on regeneration"), FRoomBuildCache::Get().GetNumHits() > NumHitsBefore);
+	TestEqual(TEXT("Cached room matches the solved room"), CountRenderedPlacements(*Room), NumPlacements);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
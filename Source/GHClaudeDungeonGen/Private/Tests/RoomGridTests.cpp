@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UnrealType.h"
+#include "Data/Grid/RoomGrid.h"
+
+namespace DungeonGenGridTests
+{
+	/** Every ECellState, in enum order */
+	const ECellState AllStates[] = { ECellState::Unoccupied, ECellState::Occupied, ECellState::Reserved, ECellState::Excluded };
+
+	/** Wider than one bitboard word, with a hole, a missing corner and cells in every state */
+	FRoomGrid MakeGrid()
+	{
+		FRoomGrid Grid;
+		Grid.Initialize(FIntPoint(-3, -2), FIntPoint(70, 5));
+
+		for (int32 Y = -2; Y < 3; ++Y)
+		{
+			for (int32 X = -3; X < 67; ++X)
+			{
+				const bool bHole = X >= 10 && X < 13 && Y >= 0 && Y < 2;
+				const bool bMissingCorner = X >= 62 && Y >= 1;
+				if (!bHole && !bMissingCorner)
+				{
+					Grid.AddCell(FIntPoint(X, Y));
+				}
+			}
+		}
+
+		Grid.SetRectState(FIntPoint(-3, -2), FIntPoint(4, 2), ECellState::Occupied);
+		Grid.SetRectState(FIntPoint(60, -2), FIntPoint(6, 3), ECellState::Reserved);
+		Grid.SetRectState(FIntPoint(20, 1), FIntPoint(2, 2), ECellState::Excluded);
+
+		const int32 WallIndex = Grid.FindIndex(FIntPoint(0, 2));
+		Grid.SetWall(WallIndex, EWallDirection::North, true);
+		Grid.SetDoorway(WallIndex, EWallDirection::North, true);
+		return Grid;
+	}
+
+	/** Round trip through the tagged property path that levels, copies and PIE duplication go through */
+	FRoomGrid RoundTrip(FRoomGrid& Source)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FRoomGrid::StaticStruct()->SerializeItem(Writer, &Source, nullptr);
+
+		FRoomGrid Loaded;
+		FMemoryReader Reader(Bytes);
+		FRoomGrid::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+		return Loaded;
+	}
+
+	/** Serialized state bytes of a grid, which are private to FRoomGrid */
+	TArray<uint8>& GetSerializedCellStates(FRoomGrid& Grid)
+	{
+		const FArrayProperty* CellStatesProperty = FindFProperty<FArrayProperty>(FRoomGrid::StaticStruct(), TEXT("CellStates"));
+		check(CellStatesProperty);
+		return *CellStatesProperty->ContainerPtrToValuePtr<TArray<uint8>>(&Grid);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRoomGridSerializationTest, "DungeonGen.RoomGrid.Serialization",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRoomGridSerializationTest::RunTest(const FString& Parameters)
+{
+	using namespace DungeonGenGridTests;
+
+	FRoomGrid Source = MakeGrid();
+	FRoomGrid Loaded = RoundTrip(Source);
+
+	TestEqual(TEXT("Cell count"), Loaded.Num(), Source.Num());
+	TestEqual(TEXT("Bounds size"), Loaded.GetSize(), Source.GetSize());
+	TestEqual(TEXT("Bounds origin"), Loaded.GetMinCoord(), Source.GetMinCoord());
+
+	int32 NumMismatchedCells = 0;
+	int32 NumMismatchedRects = 0;
+	const FIntPoint MinCoord = Source.GetMinCoord() - FIntPoint(1, 1);
+	const FIntPoint MaxCoord = Source.GetMinCoord() + Source.GetSize();
+
+	for (int32 Y = MinCoord.Y; Y <= MaxCoord.Y; ++Y)
+	{
+		for (int32 X = MinCoord.X; X <= MaxCoord.X; ++X)
+		{
+			const FIntPoint GridCoord(X, Y);
+			const int32 Index = Source.FindIndex(GridCoord);
+			NumMismatchedCells += Loaded.Contains(GridCoord) != Source.Contains(GridCoord) ? 1 : 0;
+
+			if (Index != INDEX_NONE && Loaded.Contains(GridCoord))
+			{
+				NumMismatchedCells += Loaded.GetCellState(Index) != Source.GetCellState(Index) ? 1 : 0;
+				NumMismatchedCells += Loaded.GetWallMask(Index) != Source.GetWallMask(Index) ? 1 : 0;
+				NumMismatchedCells += Loaded.GetDoorwayMask(Index) != Source.GetDoorwayMask(Index) ? 1 : 0;
+			}
+
+			// Footprints up to 3x2, including ones that cross the hole, the missing corner, the bounds and a word boundary
+			for (const FIntPoint& Extent : { FIntPoint(1, 1), FIntPoint(2, 1), FIntPoint(3, 2), FIntPoint(1, 2) })
+			{
+				for (ECellState State : AllStates)
+				{
+					NumMismatchedRects += Loaded.IsRectInState(GridCoord, Extent, State) != Source.IsRectInState(GridCoord, Extent, State) ? 1 : 0;
+				}
+			}
+		}
+	}
+
+	TestEqual(TEXT("Cells whose existence, state or edges differ after loading"), NumMismatchedCells, 0);
+	TestEqual(TEXT("Footprint queries that differ after loading"), NumMismatchedRects, 0);
+
+	// The loaded bitboard must also follow later edits
+	Loaded.SetRectState(FIntPoint(62, -2), FIntPoint(3, 2), ECellState::Occupied);
+	TestTrue(TEXT("Footprint across the word boundary is occupied after editing the loaded grid"), Loaded.IsRectInState(FIntPoint(62, -2), FIntPoint(3, 2), ECellState::Occupied));
+	TestFalse(TEXT("Edited cells left the reserved bitboard"), Loaded.IsRectInState(FIntPoint(62, -2), FIntPoint(1, 1), ECellState::Reserved));
+
+	// Cell counts are tracked per grid, so a loaded grid round-trips again unchanged
+	FRoomGrid Reloaded = RoundTrip(Loaded);
+	TestEqual(TEXT("Cell count after a second round trip"), Reloaded.Num(), Loaded.Num());
+
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRoomGridInvalidStateTest, "DungeonGen.RoomGrid.InvalidState",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRoomGridInvalidStateTest::RunTest(const FString& Parameters)
+{
+	using namespace DungeonGenGridTests;
+
+	// A corrupt save: one existing cell holds a state byte outside ECellState
+	FRoomGrid Source = MakeGrid();
+	const FIntPoint CorruptCoord(30, 0);
+	const int32 CorruptIndex = Source.FindIndex(CorruptCoord);
+	if (!TestTrue(TEXT("Corrupted cell exists"), CorruptIndex != INDEX_NONE))
+	{
+		return false;
+	}
+	GetSerializedCellStates(Source)[CorruptIndex] = 0xFF;
+
+	AddExpectedMessage(TEXT("invalid serialized state"), EAutomationExpectedErrorFlags::Contains, 1);
+	FRoomGrid Loaded = RoundTrip(Source);
+
+	TestEqual(TEXT("Invalid state is reset on load"), Loaded.GetCellState(CorruptIndex), ECellState::Unoccupied);
+	TestTrue(TEXT("Reset cell is in the unoccupied bitboard"), Loaded.IsRectInState(CorruptCoord, FIntPoint(1, 1), ECellState::Unoccupied));
+
+	// Clearing the old state's bit must stay inside the bitboard
+	Loaded.SetCellState(CorruptIndex, ECellState::Occupied);
+	TestEqual(TEXT("State after editing the reset cell"), Loaded.GetCellState(CorruptIndex), ECellState::Occupied);
+	TestTrue(TEXT("Edited cell is in the occupied bitboard"), Loaded.IsRectInState(CorruptCoord, FIntPoint(1, 1), ECellState::Occupied));
+	TestFalse(TEXT("Edited cell left the unoccupied bitboard"), Loaded.IsRectInState(CorruptCoord, FIntPoint(1, 1), ECellState::Unoccupied));
+	TestEqual(TEXT("Cell count is unaffected"), Loaded.Num(), Source.Num());
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
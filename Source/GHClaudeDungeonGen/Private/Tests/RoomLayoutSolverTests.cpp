@@ -0,0 +1,371 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Class.h"
+#include "Generation/RoomLayoutSolver.h"
+#include "Generation/RoomBuildCache.h"
+#include "Generation/DungeonSeed.h"
+
+namespace DungeonGenSolverTests
+{
+	/** Seeds per shape in the invariant sweep */
+	constexpr int32 NumSweepSeeds = 64;
+
+	/** Mesh paths are never resolved by the solver, so the tests use made-up ones */
+	FMeshPlacementData MakePlacement(const TCHAR* MeshName, int32 CellsX, int32 CellsY, float SelectionWeight = 1.0f)
+	{
+		FMeshPlacementData Placement;
+		Placement.Mesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(FString::Printf(TEXT("/Game/DungeonGenTests/%s.%s"), MeshName, MeshName)));
+		Placement.CellsX = CellsX;
+		Placement.CellsY = CellsY;
+		Placement.SelectionWeight = SelectionWeight;
+		return Placement;
+	}
+
+	/** One shape of each ERoomShape (Scale grows every dimension, for the performance sweep) */
+	FRoomShapeDefinition MakeShape(ERoomShape ShapeType, int32 Scale = 1)
+	{
+		FRoomShapeDefinition Shape;
+		Shape.ShapeType = ShapeType;
+		Shape.RectWidth = 6 * Scale;
+		Shape.RectHeight = 5 * Scale;
+
+		if (ShapeType == ERoomShape::Custom)
+		{
+			// A ring with a notch: holes and concave corners on every side
+			Shape.CustomLayoutWidth = 6 * Scale;
+			Shape.CustomLayoutHeight = 6 * Scale;
+			Shape.CustomCellLayout.SetNum(Shape.CustomLayoutWidth * Shape.CustomLayoutHeight);
+			for (int32 Y = 0; Y < Shape.CustomLayoutHeight; ++Y)
+			{
+				for (int32 X = 0; X < Shape.CustomLayoutWidth; ++X)
+				{
+					const bool bHole = X >= 2 * Scale && X < 4 * Scale && Y >= 2 * Scale && Y < 4 * Scale;
+					const bool bNotch = X >= 5 * Scale && Y < Scale;
+					Shape.CustomCellLayout[Y * Shape.CustomLayoutWidth + X] = (bHole || bNotch) ? 0 : 1;
+				}
+			}
+		}
+
+		return Shape;
+	}
+
+	/** Solver input with multi-cell floor, wall and ceiling candidates plus single-cell fallbacks */
+	FRoomLayoutInput MakeInput(ERoomShape ShapeType, int32 Seed, int32 Scale = 1)
+	{
+		FRoomLayoutInput Input;
+		Input.Seed = Seed;
+		Input.bUseShapeOverride = true;
+		Input.ShapeOverride = MakeShape(ShapeType, Scale);
+		Input.CellSize = 100.0f;
+
+		Input.FloorTiles = { MakePlacement(TEXT("SM_Floor1x1"), 1, 1, 2.0f), MakePlacement(TEXT("SM_Floor2x1"), 2, 1), MakePlacement(TEXT("SM_Floor2x2"), 2, 2) };
+		Input.WallSegments = { MakePlacement(TEXT("SM_Wall1"), 1, 1), MakePlacement(TEXT("SM_Wall2"), 2, 1), MakePlacement(TEXT("SM_Wall3"), 3, 1, 0.5f) };
+		Input.InnerCorners = { MakePlacement(TEXT("SM_InnerCorner"), 1, 1) };
+		Input.OuterCorners = { MakePlacement(TEXT("SM_OuterCorner"), 1, 1) };
+		Input.CeilingTiles = { MakePlacement(TEXT("SM_Ceiling1x1"), 1, 1), MakePlacement(TEXT("SM_Ceiling2x2"), 2, 2) };
+		return Input;
+	}
+
+	/** True if the cell exists and belongs to the room */
+	bool IsInteriorCell(const FRoomGrid& Grid, const FIntPoint& GridCoord)
+	{
+		const int32 CellIndex = Grid.FindIndex(GridCoord);
+		return CellIndex != INDEX_NONE && Grid.GetCellState(CellIndex) != ECellState::Unoccupied;
+	}
+
+	/** Neighbour across each edge, indexed by EWallDirection */
+	const FIntPoint DirectionOffsets[4] = { FIntPoint(0, 1), FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(-1, 0) };
+
+	/** Edge a wall segment faces, from its yaw (north 0, east 90, south 180, west 270) */
+	int32 GetWallDirection(const FRoomBuildPlanEntry& Entry)
+	{
+		const int32 Quadrant = FMath::RoundToInt32(Entry.LocalTransform.GetRotation().Rotator().Yaw / 90.0f);
+		return ((Quadrant % 4) + 4) % 4;
+	}
+
+	/** Checks every invariant of one solved plan, reporting failures against Test */
+	void CheckPlanInvariants(FAutomationTestBase& Test, const FString& Context, const FRoomBuildPlan& Plan)
+	{
+		const FRoomGrid& Grid = Plan.Grid;
+		if (!Test.TestTrue(FString::Printf(TEXT("%s: solve succeeded"), *Context), Plan.bSucceeded)
+			|| !Test.TestTrue(FString::Printf(TEXT("%s: room has cells"), *Context), Grid.Num() > 0))
+		{
+			return;
+		}
+
+		// Footprint coverage per slot: no two floor (or ceiling) placements may share a cell, and every room cell is covered once
+		TArray<int32> FloorCoverage;
+		TArray<int32> CeilingCoverage;
+		FloorCoverage.SetNumZeroed(Grid.GetNumSlots());
+		CeilingCoverage.SetNumZeroed(Grid.GetNumSlots());
+
+		// Wall segment edges, as slot * 4 + direction
+		TSet<int32> WallEdges;
+		int32 NumDuplicateWallEdges = 0;
+		int32 NumMisplacedFootprints = 0;
+
+		for (const FRoomBuildPlanEntry& Entry : Plan.Entries)
+		{
+			const FString MeshName = Plan.MeshPaths.IsValidIndex(Entry.MeshIndex) ? Plan.MeshPaths[Entry.MeshIndex].GetAssetName() : FString();
+			const bool bCorner = MeshName.Contains(TEXT("Corner"));
+
+			for (int32 Y = 0; Y < Entry.Footprint.Y; ++Y)
+			{
+				for (int32 X = 0; X < Entry.Footprint.X; ++X)
+				{
+					const FIntPoint CellCoord = Entry.BottomLeftCell + FIntPoint(X, Y);
+					const int32 CellIndex = Grid.FindIndex(CellCoord);
+
+					if (Entry.Container == ERoomContainer::Wall && bCorner)
+					{
+						// Corners sit on outline vertices, their cell may be outside the room
+						continue;
+					}
+
+					if (CellIndex == INDEX_NONE || !IsInteriorCell(Grid, CellCoord))
+					{
+						++NumMisplacedFootprints;
+						continue;
+					}
+
+					switch (Entry.Container)
+					{
+					case ERoomContainer::Floor:
+						++FloorCoverage[CellIndex];
+						break;
+					case ERoomContainer::Ceiling:
+						++CeilingCoverage[CellIndex];
+						break;
+					case ERoomContainer::Wall:
+					{
+						bool bAlreadyInSet = false;
+						WallEdges.Add(CellIndex * 4 + GetWallDirection(Entry), &bAlreadyInSet);
+						NumDuplicateWallEdges += bAlreadyInSet ? 1 : 0;
+						break;
+					}
+					default:
+						break;
+					}
+				}
+			}
+		}
+
+		Test.TestEqual(FString::Printf(TEXT("%s: placements outside the room"), *Context), NumMisplacedFootprints, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: boundary edges covered by more than one wall segment"), *Context), NumDuplicateWallEdges, 0);
+
+		int32 NumUnflooredCells = 0;
+		int32 NumOverlappingFloorCells = 0;
+		int32 NumOverlappingCeilingCells = 0;
+		int32 NumMissingWalls = 0;
+		int32 NumExtraWalls = 0;
+
+		Grid.ForEachCellIndex([&](int32 CellIndex)
+		{
+			// Every cell of the shape must be floored (a cell no tile covered would still be Unoccupied)
+			NumUnflooredCells += FloorCoverage[CellIndex] == 0 ? 1 : 0;
+			NumOverlappingFloorCells += FloorCoverage[CellIndex] > 1 ? 1 : 0;
+			NumOverlappingCeilingCells += CeilingCoverage[CellIndex] > 1 ? 1 : 0;
+
+			const FIntPoint CellCoord = Grid.ToCoord(CellIndex);
+			if (!IsInteriorCell(Grid, CellCoord))
+			{
+				return;
+			}
+
+			// A wall belongs on an edge exactly when the neighbour across it is not part of the room
+			for (int32 Direction = 0; Direction < 4; ++Direction)
+			{
+				const bool bBoundary = !IsInteriorCell(Grid, CellCoord + DirectionOffsets[Direction]);
+				const bool bGridWall = Grid.HasWall(CellIndex, static_cast<EWallDirection>(Direction));
+				const bool bSegment = WallEdges.Contains(CellIndex * 4 + Direction);
+
+				NumMissingWalls += (bBoundary && (!bGridWall || !bSegment)) ? 1 : 0;
+				NumExtraWalls += (!bBoundary && (bGridWall || bSegment)) ? 1 : 0;
+			}
+		});
+
+		Test.TestEqual(FString::Printf(TEXT("%s: room cells without a floor tile"), *Context), NumUnflooredCells, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: cells under overlapping floor tiles"), *Context), NumOverlappingFloorCells, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: cells under overlapping ceiling tiles"), *Context), NumOverlappingCeilingCells, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: boundary edges without a wall"), *Context), NumMissingWalls, 0);
+		Test.TestEqual(FString::Printf(TEXT("%s: walls on interior edges"), *Context), NumExtraWalls, 0);
+	}
+
+	/** Plan bytes in the build cache format, which covers every field of every entry */
+	TArray<uint8> SerializePlanBytes(const FRoomBuildPlan& Plan)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FRoomBuildCache::SerializePlan(Writer, const_cast<FRoomBuildPlan&>(Plan));	// Saving only reads the plan
+		return Bytes;
+	}
+
+	/** Every ERoomShape, in enum order */
+	const ERoomShape AllShapes[] = { ERoomShape::Rectangle, ERoomShape::LShape, ERoomShape::TShape, ERoomShape::UShape, ERoomShape::Custom };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRoomLayoutSolverInvariantsTest, "DungeonGen.RoomLayoutSolver.Invariants",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRoomLayoutSolverInvariantsTest::RunTest(const FString& Parameters)
+{
+	using namespace DungeonGenSolverTests;
+
+	for (ERoomShape ShapeType : AllShapes)
+	{
+		for (int32 SeedIndex = 0; SeedIndex < NumSweepSeeds; ++SeedIndex)
+		{
+			const int32 Seed = FDungeonSeed::DeriveRoomSeed(1, SeedIndex);
+			const FRoomBuildPlan Plan = FRoomLayoutSolver::Solve(MakeInput(ShapeType, Seed));
+			CheckPlanInvariants(*this, FString::Printf(TEXT("%s seed %d"), *UEnum::GetValueAsString(ShapeType), Seed), Plan);
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRoomLayoutSolverDeterminismTest, "DungeonGen.RoomLayoutSolver.Determinism",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FRoomLayoutSolverDeterminismTest::RunTest(const FString& Parameters)
+{
+	using namespace DungeonGenSolverTests;
+
+	for (ERoomShape ShapeType : AllShapes)
+	{
+		TSet<uint32> DistinctPlans;
+		for (int32 SeedIndex = 0; SeedIndex < NumSweepSeeds; ++SeedIndex)
+		{
+			const int32 Seed = FDungeonSeed::DeriveRoomSeed(1, SeedIndex);
+			const FRoomLayoutInput Input = MakeInput(ShapeType, Seed);
+
+			// Same seed, same plan - with a fresh input copy, so nothing can leak between solves
+			const FRoomBuildPlan FirstPlan = FRoomLayoutSolver::Solve(Input);
+			const FRoomBuildPlan SecondPlan = FRoomLayoutSolver::Solve(MakeInput(ShapeType, Seed));
+
+			const TArray<uint8> FirstBytes = SerializePlanBytes(FirstPlan);
+			const FString Context = FString::Printf(TEXT("%s seed %d"), *UEnum::GetValueAsString(ShapeType), Seed);
+			TestTrue(FString::Printf(TEXT("%s: repeated solve is identical"), *Context), FirstBytes == SerializePlanBytes(SecondPlan));
+
+			DistinctPlans.Add(FCrc::MemCrc32(FirstBytes.GetData(), FirstBytes.Num()));
+		}
+
+		// The seed has to matter, or the sweep above proves nothing
+		TestTrue(FString::Printf(TEXT("%s: seeds produce different layouts"), *UEnum::GetValueAsString(ShapeType)), DistinctPlans.Num() > 1);
+	}
+
+	return !HasAnyErrors();
+}
+
+/**
+ * Times every solver pass over a larger seed sweep and compares the p50 of each pass with a stored baseline
+ * -DungeonGenPerfBaseline=Path     Baseline file (default Saved/DungeonGen/Automation/RoomLayoutSolverBaseline.json)
+ * -DungeonGenPerfThreshold=0.25    Allowed slowdown per pass (fraction of the baseline)
+ * -DungeonGenUpdatePerfBaseline    Rewrite the baseline with this run's timings
+ * The baseline is written on the first run; keep one per build machine, timings do not transfer between machines
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRoomLayoutSolverPerformanceTest, "DungeonGen.RoomLayoutSolver.Performance",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRoomLayoutSolverPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace DungeonGenSolverTests;
+
+	constexpr int32 NumPerfSeeds = 200;
+	constexpr int32 PerfShapeScale = 4;
+
+	// Differences below this are timer noise on any machine
+	constexpr double AbsoluteSlackMs = 0.02;
+
+	TMap<FString, TArray<double>> PassSamples;
+	for (ERoomShape ShapeType : AllShapes)
+	{
+		for (int32 SeedIndex = 0; SeedIndex < NumPerfSeeds; ++SeedIndex)
+		{
+			const FRoomLayoutInput Input = MakeInput(ShapeType, FDungeonSeed::DeriveRoomSeed(2, SeedIndex), PerfShapeScale);
+
+			FRoomLayoutSolveTimings Timings;
+			const double StartTime = FPlatformTime::Seconds();
+			FRoomLayoutSolver::Solve(Input, &Timings);
+			const double EndTime = FPlatformTime::Seconds();
+
+			PassSamples.FindOrAdd(TEXT("ShapeMs")).Add(Timings.ShapeSeconds * 1000.0);
+			PassSamples.FindOrAdd(TEXT("GridInitMs")).Add(Timings.GridSeconds * 1000.0);
+			PassSamples.FindOrAdd(TEXT("ForcedPlacementsMs")).Add(Timings.ForcedPlacementSeconds * 1000.0);
+			PassSamples.FindOrAdd(TEXT("FloorMs")).Add(Timings.FloorSeconds * 1000.0);
+			PassSamples.FindOrAdd(TEXT("WallsMs")).Add(Timings.WallSeconds * 1000.0);
+			PassSamples.FindOrAdd(TEXT("CeilingMs")).Add(Timings.CeilingSeconds * 1000.0);
+			PassSamples.FindOrAdd(TEXT("SolveMs")).Add((EndTime - StartTime) * 1000.0);
+		}
+	}
+
+	// Median per pass
+	TSharedRef<FJsonObject> Current = MakeShared<FJsonObject>();
+	for (TPair<FString, TArray<double>>& Pass : PassSamples)
+	{
+		Pass.Value.Sort();
+		const double Median = Pass.Value[Pass.Value.Num() / 2];
+		Current->SetNumberField(Pass.Key, Median);
+		AddInfo(FString::Printf(TEXT("%s p50 %.4f ms"), *Pass.Key, Median));
+	}
+
+	FString BaselinePath = FPaths::ProjectSavedDir() / TEXT("DungeonGen/Automation/RoomLayoutSolverBaseline.json");
+	double Threshold = 0.25;
+	FParse::Value(FCommandLine::Get(), TEXT("DungeonGenPerfBaseline="), BaselinePath);
+	FParse::Value(FCommandLine::Get(), TEXT("DungeonGenPerfThreshold="), Threshold);
+
+	auto WriteBaseline = [this, &Current, &BaselinePath]()
+	{
+		FString BaselineText;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&BaselineText);
+		FJsonSerializer::Serialize(Current, Writer);
+		TestTrue(FString::Printf(TEXT("Baseline written to %s"), *BaselinePath), FFileHelper::SaveStringToFile(BaselineText, *BaselinePath));
+	};
+
+	FString BaselineText;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FParse::Param(FCommandLine::Get(), TEXT("DungeonGenUpdatePerfBaseline")) && FFileHelper::LoadFileToString(BaselineText, *BaselinePath))
+	{
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline);
+	}
+
+	if (!Baseline.IsValid())
+	{
+		AddInfo(FString::Printf(TEXT("No baseline at %s, recording this run"), *BaselinePath));
+		WriteBaseline();
+		return !HasAnyErrors();
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Current->Values)
+	{
+		double BaselineMs = 0.0;
+		if (!Baseline->TryGetNumberField(Field.Key, BaselineMs))
+		{
+			continue;
+		}
+
+		const double CurrentMs = Field.Value->AsNumber();
+		const double LimitMs = BaselineMs * (1.0 + Threshold) + AbsoluteSlackMs;
+		if (CurrentMs > LimitMs)
+		{
+			AddError(FString::Printf(TEXT("%s regressed: p50 %.4f ms, baseline %.4f ms (limit %.4f ms)"), *Field.Key, CurrentMs, BaselineMs, LimitMs));
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
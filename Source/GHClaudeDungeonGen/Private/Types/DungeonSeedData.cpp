@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Types/DungeonSeedData.h"
+#include "Serialization/CustomVersion.h"
+#include "Generation/DungeonSeed.h"
+#include "Serialization/DungeonGenArchive.h"
+
+const FGuid FDungeonSeedDataCustomVersion::GUID(0xBC5B75ED, 0xDC1745C0, 0xB91AA9E3, 0xE9591314);
+
+// Register the custom version with the core
+static FCustomVersionRegistration GRegisterDungeonSeedDataCustomVersion(FDungeonSeedDataCustomVersion::GUID, FDungeonSeedDataCustomVersion::LatestVersion, TEXT("DungeonSeedDataVer"));
+
+// Per-floor flag byte
+static constexpr uint8 FloorSeedDerivedFlag = 0x01;		// FloorSeed == FDungeonSeed::DeriveFloorSeed(MasterSeed, FloorIndex), not stored
+
+// Per-room header byte
+static constexpr uint8 RoomQuadrantMask = 0x03;			// Rotation / 90
+static constexpr uint8 RoomSeedDerivedFlag = 0x04;		// RoomSeed == FDungeonSeed::DeriveRoomSeed(FloorSeed, index in its list), not stored
+static constexpr uint8 RoomFreeRotationFlag = 0x08;		// Rotation is not one of 0/90/180/270 and follows as a varint
+
+/** Seeds are packed as unsigned, so hand-typed positive seeds stay short */
+static void SerializeSeed(FArchive& Ar, int32& Seed)
+{
+	uint32 Encoded = static_cast<uint32>(Seed);
+	Ar.SerializeIntPacked(Encoded);
+	Seed = static_cast<int32>(Encoded);
+}
+
+/** Location deltas from the previous entry of the list (rooms are laid out next to each other, so deltas stay small) */
+static void SerializeLocationDelta(FArchive& Ar, FIntPoint& Location, FIntPoint& PreviousLocation)
+{
+	FIntPoint Delta = Location - PreviousLocation;
+	DungeonGenArchive::SerializeVarInt(Ar, Delta.X);
+	DungeonGenArchive::SerializeVarInt(Ar, Delta.Y);
+
+	if (Ar.IsLoading())
+	{
+		Location = PreviousLocation + Delta;
+	}
+	PreviousLocation = Location;
+}
+
+static void SerializeRoomList(FArchive& Ar, TArray<FRoomSeedData>& Rooms, int32 FloorSeed, TArray<FName>& NameTable, const TMap<FName, int32>& NameIndices)
+{
+	int32 NumRooms = Rooms.Num();
+	if (!DungeonGenArchive::SerializeCount(Ar, NumRooms))
+	{
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Rooms.SetNum(NumRooms);
+	}
+
+	FIntPoint PreviousLocation = FIntPoint::ZeroValue;
+	for (int32 RoomIndex = 0; RoomIndex < NumRooms && !Ar.IsError(); ++RoomIndex)
+	{
+		FRoomSeedData& Room = Rooms[RoomIndex];
+		const int32 DerivedSeed = FDungeonSeed::DeriveRoomSeed(FloorSeed, RoomIndex);
+
+		uint8 Header = 0;
+		if (Ar.IsSaving())
+		{
+			const bool bQuadrant = Room.Rotation >= 0 && Room.Rotation < 360 && Room.Rotation % 90 == 0;
+			Header = bQuadrant ? static_cast<uint8>(Room.Rotation / 90) : RoomFreeRotationFlag;
+			Header |= Room.RoomSeed == DerivedSeed ? RoomSeedDerivedFlag : 0;
+		}
+		Ar << Header;
+
+		int32 NameIndex = Ar.IsSaving() ? NameIndices.FindChecked(Room.RoomDataAssetName) : 0;
+		DungeonGenArchive::SerializeCount(Ar, NameIndex);
+		SerializeLocationDelta(Ar, Room.Location, PreviousLocation);
+
+		if (Header & RoomSeedDerivedFlag)
+		{
+			Room.RoomSeed = DerivedSeed;
+		}
+		else
+		{
+			SerializeSeed(Ar, Room.RoomSeed);
+		}
+
+		if (Header & RoomFreeRotationFlag)
+		{
+			DungeonGenArchive::SerializeVarInt(Ar, Room.Rotation);
+		}
+		else
+		{
+			Room.Rotation = (Header & RoomQuadrantMask) * 90;
+		}
+
+		if (Ar.IsLoading())
+		{
+			if (!NameTable.IsValidIndex(NameIndex))
+			{
+				Ar.SetError();
+				return;
+			}
+			Room.RoomDataAssetName = NameTable[NameIndex];
+		}
+	}
+}
+
+/** The compact form at a known format version (the archive's custom version, or the latest for replication) */
+static void SerializeCompactSeedData(FArchive& Ar, FDungeonSeedData& SeedData, int32 Version)
+{
+	if (Ar.IsLoading())
+	{
+		SeedData.SaveVersion = Version;
+	}
+
+	SerializeSeed(Ar, SeedData.MasterSeed);
+
+	if (Version >= FDungeonSeedDataCustomVersion::AddedRoomsPerFloor)
+	{
+		DungeonGenArchive::SerializeVarInt(Ar, SeedData.RoomsPerFloor);
+	}
+	else
+	{
+		SeedData.RoomsPerFloor = 0;
+	}
+
+	uint64 Ticks = static_cast<uint64>(SeedData.GenerationTimestamp.GetTicks());
+	Ar.SerializeIntPacked64(Ticks);
+	if (Ar.IsLoading())
+	{
+		SeedData.GenerationTimestamp = FDateTime(static_cast<int64>(Ticks));
+	}
+
+	// String table: every room data asset name once, referenced by index
+	TArray<FName> NameTable;
+	TMap<FName, int32> NameIndices;
+	if (Ar.IsSaving())
+	{
+		for (const FFloorSeedData& Floor : SeedData.FloorSeeds)
+		{
+			for (const TArray<FRoomSeedData>* Rooms : { &Floor.RoomSeeds, &Floor.HallwaySeeds })
+			{
+				for (const FRoomSeedData& Room : *Rooms)
+				{
+					if (!NameIndices.Contains(Room.RoomDataAssetName))
+					{
+						NameIndices.Add(Room.RoomDataAssetName, NameTable.Add(Room.RoomDataAssetName));
+					}
+				}
+			}
+		}
+	}
+
+	int32 NumNames = NameTable.Num();
+	if (!DungeonGenArchive::SerializeCount(Ar, NumNames))
+	{
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		NameTable.SetNum(NumNames);
+	}
+
+	for (FName& Name : NameTable)
+	{
+		FString NameString = Name.ToString();
+		Ar << NameString;
+		if (Ar.IsLoading())
+		{
+			Name = FName(*NameString);
+		}
+	}
+
+	// Floors
+	int32 NumFloors = SeedData.FloorSeeds.Num();
+	if (!DungeonGenArchive::SerializeCount(Ar, NumFloors))
+	{
+		return;
+	}
+
+	if (Ar.IsLoading())
+	{
+		SeedData.FloorSeeds.SetNum(NumFloors);
+	}
+
+	for (int32 FloorSeedIndex = 0; FloorSeedIndex < NumFloors && !Ar.IsError(); ++FloorSeedIndex)
+	{
+		FFloorSeedData& Floor = SeedData.FloorSeeds[FloorSeedIndex];
+		DungeonGenArchive::SerializeVarInt(Ar, Floor.FloorIndex);
+
+		const int32 DerivedFloorSeed = FDungeonSeed::DeriveFloorSeed(SeedData.MasterSeed, Floor.FloorIndex);
+		uint8 Flags = (Ar.IsSaving() && Floor.FloorSeed == DerivedFloorSeed) ? FloorSeedDerivedFlag : 0;
+		Ar << Flags;
+
+		if (Flags & FloorSeedDerivedFlag)
+		{
+			Floor.FloorSeed = DerivedFloorSeed;
+		}
+		else
+		{
+			SerializeSeed(Ar, Floor.FloorSeed);
+		}
+
+		SerializeRoomList(Ar, Floor.RoomSeeds, Floor.FloorSeed, NameTable, NameIndices);
+		SerializeRoomList(Ar, Floor.HallwaySeeds, Floor.FloorSeed, NameTable, NameIndices);
+
+		int32 NumDoorways = Floor.DoorwayPositions.Num();
+		if (!DungeonGenArchive::SerializeCount(Ar, NumDoorways))
+		{
+			break;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Floor.DoorwayPositions.SetNum(NumDoorways);
+		}
+
+		FIntPoint PreviousDoorway = FIntPoint::ZeroValue;
+		for (FIntPoint& Doorway : Floor.DoorwayPositions)
+		{
+			SerializeLocationDelta(Ar, Doorway, PreviousDoorway);
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FDungeonSeedData& SeedData)
+{
+	Ar.UsingCustomVersion(FDungeonSeedDataCustomVersion::GUID);
+
+	const int32 Version = Ar.IsLoading() ? Ar.CustomVer(FDungeonSeedDataCustomVersion::GUID) : FDungeonSeedDataCustomVersion::LatestVersion;
+	if (Version < FDungeonSeedDataCustomVersion::CompactBinaryFormat)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FDungeonSeedData - Archive has no compact seed data (custom version %d)"), Version);
+		Ar.SetError();
+		return Ar;
+	}
+
+	SerializeCompactSeedData(Ar, SeedData, Version);
+	return Ar;
+}
+
+bool FDungeonSeedData::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FDungeonSeedDataCustomVersion::GUID);
+
+	// Saved before the compact format existed: leave it to tagged property serialization
+	if (Ar.IsLoading() && Ar.CustomVer(FDungeonSeedDataCustomVersion::GUID) < FDungeonSeedDataCustomVersion::CompactBinaryFormat)
+	{
+		return false;
+	}
+
+	Ar << *this;
+	return !Ar.IsError();
+}
+
+bool FDungeonSeedData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Both ends run the same build, so replication always uses the latest format
+	SerializeCompactSeedData(Ar, *this, FDungeonSeedDataCustomVersion::LatestVersion);
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DungeonGenBenchmarkCommandlet.generated.h"
+
+class AMasterRoom;
+class URoomData;
+
+/**
+ * UDungeonGenBenchmarkCommandlet - Headless room generation benchmark
+ * Generates every room data asset over a reproducible seed corpus in a transient world (no rendering)
+ * and reports per-pass solver timings, commit time, plan memory, component and instance counts
+ * as mean/p50/p95/p99/max, in CSV or JSON.
+ *
+ * UnrealEditor-Cmd <Project>.uproject -run=DungeonGenBenchmark [options] -nullrhi
+ *   -RoomData=/Game/A.A,/Game/B.B   Room data assets to benchmark (default: every URoomData in the asset registry)
+ *   -Seeds=N                        Seeds per room data asset (default 200)
+ *   -CorpusSeed=S                   Seed the corpus is derived from (default 1; same value, same corpus)
+ *   -Warmup=N                       Untimed generations per asset before measuring (default 5)
+ *   -SolveOnly                      Skip committing the plans (no components are spawned)
+ *   -Format=csv|json                Report format (default csv)
+ *   -Output=Path                    Report file (default Saved/DungeonGen/Benchmark/DungeonGenBenchmark-<time>.<format>)
+ */
+UCLASS()
+class GHCLAUDEDUNGEONGEN_API UDungeonGenBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDungeonGenBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Samples of one metric for one room data asset */
+	struct FMetricSamples
+	{
+		FString Name;
+		TArray<double> Values;
+	};
+
+	/** Every metric of one room data asset, in report order */
+	struct FRoomDataReport
+	{
+		FString RoomDataPath;
+		TArray<FMetricSamples> Metrics;
+
+		/** Returns the samples of a metric, adding it on first use */
+		TArray<double>& GetSamples(const TCHAR* MetricName);
+	};
+
+	/** Room data assets named on the command line, or every one in the asset registry */
+	static void GatherRoomData(const FString& Params, TArray<URoomData*>& OutRoomData);
+
+	/** Runs the seed corpus against one room */
+	static void BenchmarkRoom(AMasterRoom& Room, const TArray<int32>& Seeds, int32 NumWarmupSeeds, bool bSolveOnly, FRoomDataReport& OutReport);
+
+	/** Nearest-rank percentile of sorted samples */
+	static double GetPercentile(const TArray<double>& SortedValues, double Percentile);
+
+	static FString FormatCsv(const TArray<FRoomDataReport>& Reports);
+	static FString FormatJson(const TArray<FRoomDataReport>& Reports, int32 NumSeeds, int32 CorpusSeed);
+};
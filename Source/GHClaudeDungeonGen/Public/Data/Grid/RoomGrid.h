@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Types/GridTypes.h"
+#include "RoomGrid.generated.h"
+
+/**
+ * Dense row-major grid backing a room's runtime cells
+ * Cells are stored as parallel arrays (structure-of-arrays) over the room's bounding box:
+ * one byte of ECellState and one byte of packed edge flags per cell (low nibble walls, high nibble doorways).
+ * World positions are derived from coordinates on demand and occupying actors are kept sparsely.
+ * A per-state bitboard (one bit per slot, rows packed into 64-bit words) is kept in sync with the cell states
+ * so rectangular footprint queries test whole rows of cells per word instead of visiting every cell.
+ * FGridCell is only built as a view for Blueprint and debug drawing.
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomGrid
+{
+	GENERATED_BODY()
+
+	FRoomGrid()
+		: MinCoord(0, 0)
+		, Size(0, 0)
+		, NumCells(0)
+		, WordsPerRow(0)
+	{
+	}
+
+	// ========== Setup ==========
+
+	/** Resets the grid to an empty dense block covering [InMinCoord, InMinCoord + InSize) */
+	void Initialize(const FIntPoint& InMinCoord, const FIntPoint& InSize);
+
+	/** Removes all cells and releases storage */
+	void Empty();
+
+	/** Adds an unoccupied cell at the given coordinate (must be inside the bounds) and returns its index */
+	int32 AddCell(const FIntPoint& GridCoord);
+
+	// ========== Indexing ==========
+
+	/** Returns true if the coordinate is inside the bounding box (the cell may still not exist) */
+	FORCEINLINE bool IsInBounds(const FIntPoint& GridCoord) const
+	{
+		return GridCoord.X >= MinCoord.X && GridCoord.Y >= MinCoord.Y
+			&& GridCoord.X < MinCoord.X + Size.X && GridCoord.Y < MinCoord.Y + Size.Y;
+	}
+
+	/** Converts a coordinate to its row-major index (INDEX_NONE if out of bounds) */
+	FORCEINLINE int32 ToIndex(const FIntPoint& GridCoord) const
+	{
+		return IsInBounds(GridCoord) ? (GridCoord.Y - MinCoord.Y) * Size.X + (GridCoord.X - MinCoord.X) : INDEX_NONE;
+	}
+
+	/** Converts a row-major index back to a grid coordinate */
+	FORCEINLINE FIntPoint ToCoord(int32 Index) const
+	{
+		return FIntPoint(MinCoord.X + Index % Size.X, MinCoord.Y + Index / Size.X);
+	}
+
+	/** Returns the index of an existing cell, or INDEX_NONE if there is no cell at the coordinate */
+	FORCEINLINE int32 FindIndex(const FIntPoint& GridCoord) const
+	{
+		const int32 Index = ToIndex(GridCoord);
+		return (Index != INDEX_NONE && IsCellIndex(Index)) ? Index : INDEX_NONE;
+	}
+
+	/** Returns true if the slot at a row-major index belongs to the room */
+	FORCEINLINE bool IsCellIndex(int32 Index) const
+	{
+		return ((CellExistsBits[Index >> 6] >> (Index & 63)) & 1) != 0;
+	}
+
+	/** Returns true if a cell exists at the given coordinate */
+	FORCEINLINE bool Contains(const FIntPoint& GridCoord) const
+	{
+		return FindIndex(GridCoord) != INDEX_NONE;
+	}
+
+	// ========== Cell State ==========
+
+	FORCEINLINE ECellState GetCellState(int32 Index) const { return static_cast<ECellState>(CellStates[Index]); }
+
+	FORCEINLINE void SetCellState(int32 Index, ECellState State)
+	{
+		if (IsCellIndex(Index))
+		{
+			SetStateBit(GetCellState(Index), Index, false);
+			SetStateBit(State, Index, true);
+		}
+		CellStates[Index] = static_cast<uint8>(State);
+	}
+
+	/** Sets the state of every cell in a rectangle (all cells must exist) */
+	void SetRectState(const FIntPoint& BottomLeftCell, const FIntPoint& Extent, ECellState State);
+
+	/** Returns true if every cell of the rectangle exists and is in the given state (false for an empty rectangle) */
+	bool IsRectInState(const FIntPoint& BottomLeftCell, const FIntPoint& Extent, ECellState State) const;
+
+	// ========== Walls and Doorways ==========
+
+	/** Bit for a direction inside a 4-bit wall or doorway mask */
+	static FORCEINLINE uint8 GetEdgeBit(EWallDirection Direction) { return static_cast<uint8>(1 << static_cast<uint8>(Direction)); }
+
+	FORCEINLINE uint8 GetWallMask(int32 Index) const { return EdgeMasks[Index] & 0x0F; }
+	FORCEINLINE uint8 GetDoorwayMask(int32 Index) const { return EdgeMasks[Index] >> 4; }
+
+	FORCEINLINE void SetWallMask(int32 Index, uint8 WallMask) { EdgeMasks[Index] = (EdgeMasks[Index] & 0xF0) | (WallMask & 0x0F); }
+	FORCEINLINE void SetDoorwayMask(int32 Index, uint8 DoorwayMask) { EdgeMasks[Index] = (EdgeMasks[Index] & 0x0F) | ((DoorwayMask & 0x0F) << 4); }
+
+	FORCEINLINE bool HasWall(int32 Index, EWallDirection Direction) const { return (GetWallMask(Index) & GetEdgeBit(Direction)) != 0; }
+	FORCEINLINE bool HasDoorway(int32 Index, EWallDirection Direction) const { return (GetDoorwayMask(Index) & GetEdgeBit(Direction)) != 0; }
+
+	void SetWall(int32 Index, EWallDirection Direction, bool bHasWall);
+	void SetDoorway(int32 Index, EWallDirection Direction, bool bHasDoorway);
+
+	// ========== Occupancy ==========
+
+	/** Records (or clears, when null) the actor occupying a cell */
+	void SetOccupyingActor(int32 Index, AActor* Actor);
+
+	/** Returns the actor occupying a cell, if any */
+	AActor* GetOccupyingActor(int32 Index) const;
+
+	// ========== Views ==========
+
+	/** World position of a cell's bottom-left corner relative to the given grid origin */
+	FORCEINLINE FVector GetCellWorldPosition(int32 Index, const FVector& Origin, float CellSize) const
+	{
+		const FIntPoint GridCoord = ToCoord(Index);
+		return Origin + FVector(GridCoord.X * CellSize, GridCoord.Y * CellSize, 0.0f);
+	}
+
+	/** Builds a Blueprint-facing FGridCell for an existing cell */
+	FGridCell GetCellView(int32 Index, const FVector& Origin, float CellSize) const;
+
+	/** Builds a coordinate-keyed copy of the grid (for Blueprint and debug drawing) */
+	TMap<FIntPoint, FGridCell> ToMap(const FVector& Origin, float CellSize) const;
+
+	// ========== Accessors ==========
+
+	/** Number of existing cells */
+	FORCEINLINE int32 Num() const { return NumCells; }
+
+	/** Lowest coordinate covered by the bounding box */
+	FORCEINLINE const FIntPoint& GetMinCoord() const { return MinCoord; }
+
+	/** Width and height of the bounding box in cells */
+	FORCEINLINE const FIntPoint& GetSize() const { return Size; }
+
+	/** Number of slots in the bounding box (valid range for indices) */
+	FORCEINLINE int32 GetNumSlots() const { return CellStates.Num(); }
+
+	/** Heap memory held by the grid's arrays, bitboard and occupancy map */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Calls Func(int32 Index) for every existing cell in row-major order */
+	template <typename FuncType>
+	void ForEachCellIndex(FuncType&& Func) const
+	{
+		for (int32 WordIndex = 0; WordIndex < CellExistsBits.Num(); ++WordIndex)
+		{
+			for (uint64 Word = CellExistsBits[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				Func(WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Word)));
+			}
+		}
+	}
+
+	// ========== Serialization ==========
+
+	/** Restores the state that is not serialized after loading (the grid is emptied if the saved arrays disagree with its size) */
+	void PostSerialize(const FArchive& Ar);
+
+	/** Checks the serialized arrays against the bounds, resets invalid cell states to Unoccupied and recomputes the cell count and the state bitboard */
+	void RebuildDerivedState();
+
+private:
+	/** Lowest grid coordinate of the bounding box */
+	UPROPERTY()
+	FIntPoint MinCoord;
+
+	/** Bounding box dimensions in cells */
+	UPROPERTY()
+	FIntPoint Size;
+
+	/** Row-major ECellState per slot */
+	UPROPERTY()
+	TArray<uint8> CellStates;
+
+	/** Row-major packed edge flags per slot (bits 0-3 walls, bits 4-7 doorways, indexed by EWallDirection) */
+	UPROPERTY()
+	TArray<uint8> EdgeMasks;
+
+	/** Actors occupying cells, keyed by slot index (most cells are only occupied by the room itself) */
+	UPROPERTY()
+	TMap<int32, TWeakObjectPtr<AActor>> OccupyingActors;
+
+	/** Row-major mask of which slots belong to the room, 64 slots per word (serialized, unlike a TBitArray) */
+	UPROPERTY()
+	TArray<uint64> CellExistsBits;
+
+	/** Number of set bits in CellExistsBits */
+	UPROPERTY()
+	int32 NumCells;
+
+	// ========== State Bitboard ==========
+
+	/** Number of ECellState values tracked by the bitboard */
+	static constexpr int32 NumCellStates = 4;
+
+	/** 64-bit words needed to cover one row */
+	int32 WordsPerRow;
+
+	/** Per-state occupancy bits, laid out as [State][Row][Word]; a bit is set only for existing cells in that state */
+	TArray<uint64> StateRowBits;
+
+	/** First word of a row inside a state's bitboard */
+	FORCEINLINE const uint64* GetStateRow(ECellState State, int32 Row) const
+	{
+		return StateRowBits.GetData() + (static_cast<int32>(State) * Size.Y + Row) * WordsPerRow;
+	}
+
+	FORCEINLINE void SetStateBit(ECellState State, int32 Index, bool bValue)
+	{
+		const int32 Row = Index / Size.X;
+		const int32 Column = Index % Size.X;
+		uint64& Word = StateRowBits[(static_cast<int32>(State) * Size.Y + Row) * WordsPerRow + Column / 64];
+		const uint64 Bit = uint64(1) << (Column % 64);
+		Word = bValue ? (Word | Bit) : (Word & ~Bit);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FRoomGrid> : public TStructOpsTypeTraitsBase2<FRoomGrid>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
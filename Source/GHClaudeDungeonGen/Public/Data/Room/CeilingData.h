@@ -36,6 +36,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ceiling Data|Materials")
 	TSoftObjectPtr<UMaterialInterface> DefaultMaterial;
 
+	/** Appends the soft paths of every ceiling mesh and the default material (for async preloading) */
+	void GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
 	UCeilingData()
 		: AssetPackName(NAME_None)
 		, CeilingTiles()
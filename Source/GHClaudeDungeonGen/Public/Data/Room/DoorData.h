@@ -45,6 +45,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Door Data|Materials")
 	TSoftObjectPtr<UMaterialInterface> DefaultMaterial;
 
+	/** Appends the soft paths of every doorway and door mesh and the default material (for async preloading) */
+	void GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
 	UDoorData()
 		: AssetPackName(NAME_None)
 		, DoorwayMeshes()
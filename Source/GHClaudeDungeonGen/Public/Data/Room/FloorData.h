@@ -40,6 +40,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floor Data|Materials")
 	bool bRandomizeMaterials;
 
+	/** Appends the soft paths of every floor mesh and material (for async preloading) */
+	void GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
 	UFloorData()
 		: AssetPackName(NAME_None)
 		, FloorTiles()
@@ -96,6 +96,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Flags")
 	bool bCanBeExitRoom;
 
+	// ========== Asset Preloading ==========
+
+	/** Appends the soft paths of the floor, wall, door and ceiling data assets */
+	void GetComponentDataPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+	/** Appends the soft paths of every mesh and material referenced by the (already loaded) component data assets */
+	void GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
 	URoomData()
 		: RoomName(NAME_None)
 		, RoomDescription(FText::FromString("Default Room"))
@@ -44,6 +44,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Data|Materials")
 	TSoftObjectPtr<UMaterialInterface> DefaultMaterial;
 
+	/** Appends the soft paths of every wall, corner and doorway frame mesh and the default material (for async preloading) */
+	void GetReferencedAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
+
 	UWallData()
 		: AssetPackName(NAME_None)
 		, WallSegments()
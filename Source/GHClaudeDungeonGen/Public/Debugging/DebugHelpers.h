@@ -7,17 +7,16 @@
 #include "Types/GridTypes.h"
 #include "DebugHelpers.generated.h"
 
+class ULineBatchComponent;
+
 /**
  * UDebugHelpers - Component for visualizing dungeon generation data
  * Provides debug drawing for grids, cell states, walls, doorways, and forced placements
+ * UpdateDebugVisualization keeps the grid in one line batch component, rebuilt only when the grid or the settings change;
+ * the individual Draw* functions are immediate-mode helpers for Blueprint
+ * Generated rooms draw their layout through UDungeonDebugComponent instead
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), Blueprintable, BlueprintType)
- * Debug helper component for visualizing room generation
- * Provides grid visualization, cell state display, and doorway indicators
- * UDebugHelpers - Component for debugging and visualization of dungeon generation
- * Provides methods for drawing grids, cells, walls, and doorways in editor and runtime
- */
-UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class GHCLAUDEDUNGEONGEN_API UDebugHelpers : public UActorComponent
 {
 	GENERATED_BODY()
@@ -115,249 +114,53 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Debug Visualization")
 	void ToggleDebugDraw();
 
-	/** Draws all debug visualizations if enabled */
+	/** Broadcast when bEnableDebugDraw is toggled or edited, so the owner can rebuild or clear its own overlay */
+	FSimpleMulticastDelegate OnDebugDrawToggled;
+
+	/** Rebuilds the batched visualization from a coordinate-keyed grid if enabled (clears it otherwise) */
 	UFUNCTION(BlueprintCallable, Category = "Debug Visualization")
 	void UpdateDebugVisualization(const TMap<FIntPoint, FGridCell>& Grid, float CellSize);
 
-protected:
-	virtual void BeginPlay() override;
-
-private:
-	/** Helper to get world location for debug drawing */
-	FVector GetWorldLocationForCell(const FIntPoint& GridCoord, float CellSize) const;
-
-	/** Helper to get cell color based on state */
-	FColor GetColorForCellState(ECellState State) const;
-	// ========== Debug Display Options ==========
-	
-	/** Whether to draw the grid overlay */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display")
-	bool bShowGrid;
-
-	/** Whether to draw cell coordinates */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display")
-	bool bShowCellCoordinates;
-
-	/** Whether to draw cell states (color-coded) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display")
-	bool bShowCellStates;
-
-	/** Whether to draw wall indicators */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display")
-	bool bShowWalls;
-
-	/** Whether to draw doorway indicators */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display")
-	bool bShowDoorways;
-
-	/** Whether to draw snap point locations */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display")
-	bool bShowSnapPoints;
-
-	/** Duration for debug draw persistence (0 = one frame) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display", meta = (ClampMin = "0.0", ClampMax = "10.0"))
-	float DebugDrawDuration;
-
-	/** Thickness of debug lines */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Display", meta = (ClampMin = "0.1", ClampMax = "10.0"))
-	float DebugLineThickness;
-
-	// ========== Debug Drawing Methods ==========
-	
-	/** Draw grid overlay for the specified cells */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawGrid(const TArray<FGridCell>& GridCells, float CellSize);
-
-	/** Draw cell coordinates as text */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawCellCoordinates(const TArray<FGridCell>& GridCells);
-
-	/** Draw cell states with color coding */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawCellStates(const TArray<FGridCell>& GridCells, float CellSize);
-
-	/** Draw wall indicators */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawWalls(const TArray<FGridCell>& GridCells, float CellSize);
-
-	/** Draw doorway indicators */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawDoorways(const TArray<FGridCell>& GridCells, float CellSize);
-
-	/** Draw snap points */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawSnapPoints(const TArray<FVector>& SnapPoints);
-
-	/** Draw all debug visualizations for a room */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawRoomDebug(const TArray<FGridCell>& GridCells, const TArray<FVector>& SnapPoints, float CellSize);
-	// ========== Debug Visualization Settings ==========
-	
-	/** Whether to draw the grid in editor/runtime */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawGrid;
-
-	/** Whether to draw cell coordinates */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawCellCoordinates;
-
-	/** Whether to draw wall indicators */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawWalls;
-
-	/** Whether to draw doorway indicators */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawDoorways;
-
-	/** Whether to draw cell state colors */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawCellStates;
-
-	/** Color for grid lines */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization|Colors")
-	FColor GridColor;
-
-	/** Color for wall lines */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization|Colors")
-	FColor WallColor;
-
-	/** Color for doorway indicators */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization|Colors")
-	FColor DoorwayColor;
-
-	/** Color for unoccupied cells */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization|Colors")
-	FColor UnoccupiedCellColor;
-
-	/** Color for occupied cells */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization|Colors")
-	FColor OccupiedCellColor;
-
-	/** Thickness of debug lines */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	float LineThickness;
-
-	/** Height offset for drawing lines above floor */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	float DebugDrawHeight;
-
-	// ========== Debug Drawing Methods ==========
-	
-	/** Draw a single grid cell */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawGridCell(const FGridCell& Cell, float CellSize, const FVector& Offset = FVector::ZeroVector);
-
-	/** Draw multiple grid cells */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawGridCells(const TArray<FGridCell>& Cells, float CellSize, const FVector& Offset = FVector::ZeroVector);
-
-	/** Draw wall indicators for a cell */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawCellWalls(const FGridCell& Cell, float CellSize, const FVector& Offset = FVector::ZeroVector);
-
-	/** Draw doorway indicators for a cell */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawCellDoorways(const FGridCell& Cell, float CellSize, const FVector& Offset = FVector::ZeroVector);
-
-	/** Draw a coordinate label at a cell position */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawCellCoordinate(const FGridCell& Cell, const FVector& Offset = FVector::ZeroVector);
-
-	/** Draw doorway snap points */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void DrawDoorwaySnapPoints(const TArray<FVector>& SnapPoints, float Radius = 20.0f);
+	/** Removes the batched visualization */
+	UFUNCTION(BlueprintCallable, Category = "Debug Visualization")
+	void ClearDebugVisualization();
 
-	/** Clear all debug drawings */
-	UFUNCTION(BlueprintCallable, Category = "Debug Helpers")
-	void ClearDebugDrawings();
+	/** Adds the lines and meshes held by the batched visualization */
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
-	/** Get color for cell state */
-	UFUNCTION(BlueprintPure, Category = "Debug Helpers")
-	FColor GetCellStateColor(ECellState State) const;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 protected:
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void BeginPlay() override;
 
 private:
-	/** Cache of grid cells for continuous drawing */
-	TArray<FGridCell> CachedGridCells;
-	
-	/** Cache of snap points for continuous drawing */
-	TArray<FVector> CachedSnapPoints;
-	
-	/** Cached cell size */
-	float CachedCellSize;
+	/** One grid cell as read by the batch builder */
+	struct FDebugCell
+	{
+		FIntPoint GridCoord;
+		ECellState State;
+		uint8 WallMask;
+		uint8 DoorwayMask;
+	};
 
-	/** Helper method to check if any debug flags are enabled */
-	bool IsAnyDebugEnabled() const;
-private:
-	/** Get the world for drawing debug shapes */
-	UWorld* GetDebugWorld() const;
-	/** Enable/disable debug visualization */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bShowDebugVisualization;
+	/** Rebuilds the line batch unless the cells and settings match the last build */
+	void RebuildLineBatch(const TArray<FDebugCell>& Cells, float CellSize);
 
-	/** Draw grid lines in green */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawGrid;
+	/** Creates and registers the line batch on the owning actor on first use */
+	ULineBatchComponent* GetOrCreateLineBatch();
 
-	/** Draw occupied cells in red */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawOccupiedCells;
+	/** Line batch holding this room's visualization (world-space lines and cell quads) */
+	UPROPERTY(Transient, DuplicateTransient)
+	ULineBatchComponent* DebugLineBatch;
 
-	/** Draw unoccupied cells in blue */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawUnoccupiedCells;
+	/** Hash of everything the line batch was built from (0 = nothing built) */
+	uint64 LineBatchKey = 0;
 
-	/** Draw forced placements with special markers */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	bool bDrawForcedPlacements;
-
-	/** Thickness of debug lines */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization", meta = (ClampMin = "0.1", ClampMax = "10.0"))
-	float DebugLineThickness;
-
-	/** Height offset for debug visualization (to avoid z-fighting) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization")
-	float DebugVisualizationZOffset;
-
-	/**
-	 * Draw the grid lines in the editor
-	 * @param Grid - Array of grid cells to visualize
-	 * @param CellSize - Size of each cell in world units
-	 * @param OwnerLocation - World location of the room actor
-	 * @param World - World context for drawing
-	 */
-	void DrawGrid(const TArray<FGridCell>& Grid, float CellSize, const FVector& OwnerLocation, UWorld* World);
-
-	/**
-	 * Draw occupied cells in red
-	 * @param Grid - Array of grid cells to visualize
-	 * @param CellSize - Size of each cell in world units
-	 * @param OwnerLocation - World location of the room actor
-	 * @param World - World context for drawing
-	 */
-	void DrawOccupiedCells(const TArray<FGridCell>& Grid, float CellSize, const FVector& OwnerLocation, UWorld* World);
-
-	/**
-	 * Draw unoccupied cells in blue
-	 * @param Grid - Array of grid cells to visualize
-	 * @param CellSize - Size of each cell in world units
-	 * @param OwnerLocation - World location of the room actor
-	 * @param World - World context for drawing
-	 */
-	void DrawUnoccupiedCells(const TArray<FGridCell>& Grid, float CellSize, const FVector& OwnerLocation, UWorld* World);
-
-	/**
-	 * Draw forced placement markers
-	 * @param ForcedPlacements - Map of forced placements to visualize
-	 * @param CellSize - Size of each cell in world units
-	 * @param OwnerLocation - World location of the room actor
-	 * @param World - World context for drawing
-	 */
-	void DrawForcedPlacements(const TMap<FIntPoint, struct FMeshPlacementData>& ForcedPlacements, float CellSize, const FVector& OwnerLocation, UWorld* World);
+	/** Helper to get world location for debug drawing */
+	FVector GetWorldLocationForCell(const FIntPoint& GridCoord, float CellSize) const;
 
-protected:
-	/** Helper function to draw a cell rectangle */
-	void DrawCellRect(const FVector& CellWorldPosition, float CellSize, const FLinearColor& Color, UWorld* World);
+	/** Helper to get cell color based on state */
+	FColor GetColorForCellState(ECellState State) const;
 };
@@ -0,0 +1,226 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "Types/GridTypes.h"
+#include "DungeonDebugComponent.generated.h"
+
+struct FRoomGrid;
+class UMaterialInterface;
+
+/**
+ * Layers of the room debug overlay
+ * Each layer is a separate vertex/index buffer on the render thread, so it can be shown or hidden without a rebuild
+ */
+UENUM(BlueprintType)
+enum class EDungeonDebugLayer : uint8
+{
+	/** Cell boundaries */
+	Grid,
+
+	/** Color-coded cell states */
+	CellStates,
+
+	/** Wall edges */
+	Walls,
+
+	/** Doorway frames */
+	Doorways,
+
+	/** Doorway snap points */
+	SnapPoints,
+
+	/** Forced placement footprints */
+	ForcedPlacements,
+
+	Count UMETA(Hidden)
+};
+
+/** Vertex-colored triangles of one overlay layer, in component space */
+struct FDungeonDebugLayerGeometry
+{
+	TArray<FVector3f> Positions;
+	TArray<FColor> Colors;
+	TArray<uint32> Indices;
+
+	/** Adds a quad wound both ways, so it shows from either side */
+	void AddQuad(const FVector3f& A, const FVector3f& B, const FVector3f& C, const FVector3f& D, const FColor& Color);
+
+	/** Adds a line as two crossed quads of the given thickness */
+	void AddLine(const FVector3f& Start, const FVector3f& End, const FColor& Color, float Thickness);
+
+	/** Adds the twelve edges of an axis-aligned box */
+	void AddBox(const FVector3f& Min, const FVector3f& Max, const FColor& Color, float Thickness);
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Positions.GetAllocatedSize() + Colors.GetAllocatedSize() + Indices.GetAllocatedSize();
+	}
+};
+
+/**
+ * UDungeonDebugComponent - Room debug overlay rendered by its own scene proxy
+ * The grid, cell states, walls, doorways, snap points and forced placement footprints are built into GPU buffers once per layout;
+ * an unchanged room costs no CPU work per frame, and layer toggles only change which buffers are drawn
+ * Hidden in game by default
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), BlueprintType)
+class GHCLAUDEDUNGEONGEN_API UDungeonDebugComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+	friend class FDungeonDebugSceneProxy;
+
+public:
+	UDungeonDebugComponent();
+
+	// ========== Layers ==========
+
+	/** Draw cell boundaries */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Layers")
+	bool bDrawGrid;
+
+	/** Draw cell states (color-coded) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Layers")
+	bool bDrawCellStates;
+
+	/** Draw walls */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Layers")
+	bool bDrawWalls;
+
+	/** Draw doorways */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Layers")
+	bool bDrawDoorways;
+
+	/** Draw doorway snap points */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Layers")
+	bool bDrawSnapPoints;
+
+	/** Draw forced placement footprints */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Layers")
+	bool bDrawForcedPlacements;
+
+	// ========== Appearance (changes rebuild the overlay) ==========
+
+	/** Line thickness in world units */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance", meta = (ClampMin = "0.1"))
+	float LineThickness;
+
+	/** Height of the wall outlines */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance", meta = (ClampMin = "0.0"))
+	float WallHeight;
+
+	/** Color for unoccupied cells */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor UnoccupiedCellColor;
+
+	/** Color for occupied cells */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor OccupiedCellColor;
+
+	/** Color for reserved cells */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor ReservedCellColor;
+
+	/** Color for excluded cells */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor ExcludedCellColor;
+
+	/** Color for walls */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor WallColor;
+
+	/** Color for doorways */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor DoorwayColor;
+
+	/** Color for doorway snap points */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor SnapPointColor;
+
+	/** Color for forced placements */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Debug Overlay|Appearance")
+	FColor ForcedPlacementColor;
+
+	// ========== Layout ==========
+
+	/** Builds the overlay from a room grid, forced placement maps and doorway snap points (no-op if none of them changed) */
+	void SetRoomLayout(const FRoomGrid& Grid, float CellSize, TConstArrayView<const TMap<FIntPoint, FMeshPlacementData>*> ForcedPlacements, TConstArrayView<FIntPoint> SnapPoints);
+
+	/** Removes the overlay */
+	UFUNCTION(BlueprintCallable, Category = "Debug Overlay")
+	void ClearRoomLayout();
+
+	/** Shows or hides one layer without rebuilding the overlay */
+	UFUNCTION(BlueprintCallable, Category = "Debug Overlay")
+	void SetLayerVisible(EDungeonDebugLayer Layer, bool bVisible);
+
+	/** Returns whether a layer is drawn */
+	UFUNCTION(BlueprintPure, Category = "Debug Overlay")
+	bool IsLayerVisible(EDungeonDebugLayer Layer) const;
+
+	// ========== UPrimitiveComponent ==========
+
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials = false) const override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	/** One grid cell as the overlay was last built from */
+	struct FLayoutCell
+	{
+		FIntPoint GridCoord;
+		ECellState State;
+		uint8 WallMask;
+		uint8 DoorwayMask;
+
+		bool operator==(const FLayoutCell& Other) const
+		{
+			return GridCoord == Other.GridCoord && State == Other.State && WallMask == Other.WallMask && DoorwayMask == Other.DoorwayMask;
+		}
+	};
+
+	/** Rebuilds every layer from the stored layout and recreates the scene proxy */
+	void RebuildGeometry();
+
+	/** Sends the layer toggles to the scene proxy */
+	void PushVisibleLayers();
+
+	/** Bit per EDungeonDebugLayer that is drawn */
+	uint8 GetVisibleLayerMask() const;
+
+	/** Returns the material the overlay is drawn with (vertex colors) */
+	UMaterialInterface* GetOverlayMaterial() const;
+
+	FColor GetColorForCellState(ECellState State) const;
+
+	// ========== Layout the overlay was built from ==========
+
+	TArray<FLayoutCell> LayoutCells;
+
+	/** Forced placement footprints in grid coordinates (max exclusive) */
+	TArray<FIntRect> LayoutFootprints;
+
+	TArray<FIntPoint> LayoutSnapPoints;
+
+	float LayoutCellSize = 0.0f;
+
+	// ========== Built geometry ==========
+
+	FDungeonDebugLayerGeometry LayerGeometry[static_cast<int32>(EDungeonDebugLayer::Count)];
+
+	/** Bounds of all layers in component space */
+	FBox LocalBounds;
+
+	/** The layout changed while every layer was hidden; the geometry is built once a layer is shown */
+	bool bGeometryDeferred = false;
+};
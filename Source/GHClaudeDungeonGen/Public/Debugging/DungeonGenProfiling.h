@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
+
+/**
+ * Profiling hooks for dungeon generation
+ * - "DungeonGen" trace channel: one CPU scope per generation pass in Unreal Insights (-trace=cpu,DungeonGen)
+ * - "DungeonGen" CSV category: pass timings and counters in CSV profiles (csvprofile start, or -csvCaptureFrames=N)
+ * - STATGROUP_DungeonGen: running totals of the counters ("stat DungeonGen")
+ * - DungeonGen LLM tags: allocations made while solving, committing and caching rooms (-llm, "stat LLMFULL")
+ */
+
+UE_TRACE_CHANNEL_EXTERN(DungeonGenChannel, GHCLAUDEDUNGEONGEN_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(GHCLAUDEDUNGEONGEN_API, DungeonGen);
+
+LLM_DECLARE_TAG_API(DungeonGen, GHCLAUDEDUNGEONGEN_API);
+LLM_DECLARE_TAG_API(DungeonGen_Solver, GHCLAUDEDUNGEONGEN_API);
+LLM_DECLARE_TAG_API(DungeonGen_Rooms, GHCLAUDEDUNGEONGEN_API);
+LLM_DECLARE_TAG_API(DungeonGen_BuildCache, GHCLAUDEDUNGEONGEN_API);
+
+DECLARE_STATS_GROUP(TEXT("DungeonGen"), STATGROUP_DungeonGen, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rooms Solved"), STAT_DungeonGen_RoomsSolved, STATGROUP_DungeonGen, GHCLAUDEDUNGEONGEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rooms Committed"), STAT_DungeonGen_RoomsCommitted, STATGROUP_DungeonGen, GHCLAUDEDUNGEONGEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cells Processed"), STAT_DungeonGen_CellsProcessed, STATGROUP_DungeonGen, GHCLAUDEDUNGEONGEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Instances Spawned"), STAT_DungeonGen_InstancesSpawned, STATGROUP_DungeonGen, GHCLAUDEDUNGEONGEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Loaded"), STAT_DungeonGen_AssetsLoaded, STATGROUP_DungeonGen, GHCLAUDEDUNGEONGEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rejected Forced Placements"), STAT_DungeonGen_RejectedForcedPlacements, STATGROUP_DungeonGen, GHCLAUDEDUNGEONGEN_API);
+
+/** Times the enclosing scope as DungeonGen_<Name> in Insights and as <Name> in the DungeonGen CSV category (any thread) */
+#define DUNGEONGEN_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(DungeonGen_##Name, DungeonGenChannel); \
+	CSV_SCOPED_TIMING_STAT(DungeonGen, Name)
+
+/** Names the enclosing scope after a runtime string (e.g. the room being generated), Insights only */
+#define DUNGEONGEN_SCOPE_TEXT(Text) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Text, DungeonGenChannel)
+
+/** Adds to a DungeonGen counter: the running total in "stat DungeonGen" and the per-frame sum in CSV profiles (any thread) */
+#define DUNGEONGEN_COUNTER_ADD(Name, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_DungeonGen_##Name, Amount); \
+		CSV_CUSTOM_STAT(DungeonGen, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
@@ -4,9 +4,30 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Types/DungeonSeedData.h"
+#include "DungeonManager/DungeonSpatialHash.h"
 #include "DungeonManager.generated.h"
 
-UCLASS()
+// Forward declarations
+class ADungeonManager;
+class AMasterRoom;
+class URoomData;
+struct FRoomBuildPlan;
+struct FRoomLayoutInput;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDungeonGenerated, ADungeonManager*, DungeonManager);
+
+/**
+ * ADungeonManager - Multi-room dungeon layout engine
+ * Places room footprints on a global grid (one FDungeonSpatialHash per floor for broad-phase overlap rejection),
+ * records the result as FDungeonSeedData and spawns one AMasterRoom per placed room.
+ * Room interiors are solved in parallel on worker threads; each solve only depends on its room's seed
+ * (derived from the master seed), so the result is identical for any thread count. Only the commit runs on the game thread.
+ * The seed data alone reproduces the dungeon through GenerateFromSeedData.
+ * With bStreamRooms set (game worlds only), only the seed data and a spatial index of room bounds stay resident;
+ * rooms are spawned and solved when a streaming source comes within StreamInRadius and torn down beyond StreamOutRadius.
+ */
+UCLASS(Blueprintable, BlueprintType)
 class GHCLAUDEDUNGEONGEN_API ADungeonManager : public AActor
 {
 	GENERATED_BODY()
@@ -15,12 +36,225 @@ public:
 	// Sets default values for this actor's properties
 	ADungeonManager();
 
+	// ========== Layout Settings ==========
+
+	/** Room definitions to pick from (weighted by RoomSelectionWeight) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation")
+	TArray<TSoftObjectPtr<URoomData>> RoomPool;
+
+	/** Room actor class spawned for every placed room */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation")
+	TSubclassOf<AMasterRoom> RoomClass;
+
+	/** Number of rooms to place on each floor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation", meta = (ClampMin = "1"))
+	int32 RoomsPerFloor;
+
+	/** Number of floors to generate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation", meta = (ClampMin = "1"))
+	int32 NumFloors;
+
+	/** Master seed for the whole dungeon */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation", meta = (EditCondition = "!bUseRandomSeed"))
+	int32 MasterSeed;
+
+	/** If true, generates a random master seed each time; otherwise uses MasterSeed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation")
+	bool bUseRandomSeed;
+
+	/** Size of a global grid cell in world units (room footprints are converted from their own cell size) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Grid", meta = (ClampMin = "1.0"))
+	float GlobalCellSize;
+
+	/** Minimum number of empty global cells between two rooms */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Grid", meta = (ClampMin = "0"))
+	int32 RoomSpacing;
+
+	/** Vertical distance between floors in world units */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Grid")
+	float FloorHeight;
+
+	/** Candidate positions tried per room before it is skipped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Grid", meta = (ClampMin = "1"))
+	int32 MaxPlacementAttempts;
+
+	/** Edge length (in global cells) of a spatial hash bucket */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Grid", meta = (ClampMin = "1"))
+	int32 SpatialHashBucketSize;
+
+	/** If true, room layouts are looked up in FRoomBuildCache and only solved on a miss (repeated rooms and streamed-back rooms skip the solve) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Cache")
+	bool bUseRoomBuildCache;
+
+	/** If true, the build cache also reads and writes its on-disk store under Saved/ */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Cache", meta = (EditCondition = "bUseRoomBuildCache"))
+	bool bPersistRoomBuildCache;
+
+	// ========== Streaming Settings ==========
+
+	/** If true, rooms are only spawned and generated around streaming sources (game worlds only; the editor always spawns every room) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming")
+	bool bStreamRooms;
+
+	/** Rooms whose bounds come within this distance of a streaming source are generated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming", meta = (EditCondition = "bStreamRooms", ClampMin = "0.0"))
+	float StreamInRadius;
+
+	/** Streamed rooms farther than this from every source are torn down (never less than StreamInRadius, so rooms at the edge don't thrash) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming", meta = (EditCondition = "bStreamRooms", ClampMin = "0.0"))
+	float StreamOutRadius;
+
+	/** Seconds between streaming updates */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming", meta = (EditCondition = "bStreamRooms", ClampMin = "0.01"))
+	float StreamingUpdateInterval;
+
+	/** Maximum rooms spawned per streaming update (the nearest first), to spread spawn cost over several updates */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming", meta = (EditCondition = "bStreamRooms", ClampMin = "1"))
+	int32 MaxRoomsStreamedInPerUpdate;
+
+	/** Torn-down rooms kept hidden for reuse instead of being destroyed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming", meta = (EditCondition = "bStreamRooms", ClampMin = "0"))
+	int32 MaxPooledRooms;
+
+	/** Actors that drive streaming in addition to every player's view point */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Generation|Streaming", meta = (EditCondition = "bStreamRooms"))
+	TArray<AActor*> StreamingSources;
+
+	/** Broadcast once every room of a GenerateDungeon/GenerateFromSeedData call has been committed (in streaming mode, once the layout is indexed) */
+	UPROPERTY(BlueprintAssignable, Category = "Dungeon Generation")
+	FOnDungeonGenerated OnDungeonGenerated;
+
+	// ========== Generation Functions ==========
+
+	/** Lays out a new dungeon from MasterSeed and spawns its rooms */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Dungeon Generation")
+	void GenerateDungeon();
+
+	/** Spawns the rooms recorded in seed data (reproduces the dungeon it was taken from), solves them in parallel and commits them */
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generation")
+	void GenerateFromSeedData(const FDungeonSeedData& SeedData);
+
+	/** Decodes a dungeon code (see UDungeonGenLibrary::EncodeDungeonCode), applies its seed, floor and room counts and generates it; false if the code is invalid */
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generation")
+	bool GenerateFromDungeonCode(const FString& Code);
+
+	/** Destroys every spawned room */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Dungeon Generation")
+	void ClearDungeon();
+
+	/** Seed data of the current dungeon */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation")
+	FDungeonSeedData GetSeedData() const { return CurrentSeedData; }
+
+	/** Shareable code reproducing the current dungeon (empty if it was not generated from its master seed) */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation")
+	FString GetDungeonCode() const;
+
+	/** Rooms spawned for the current dungeon */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation")
+	TArray<AMasterRoom*> GetSpawnedRooms() const { return SpawnedRooms; }
+
+	/** Places RoomsPerFloor room footprints for one floor without spawning anything */
+	bool LayoutFloor(int32 FloorIndex, int32 FloorSeed, FFloorSeedData& OutFloorSeedData) const;
+
+	/** Streams rooms in and out around the current streaming sources (runs every StreamingUpdateInterval in streaming mode) */
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generation|Streaming")
+	void UpdateStreaming();
+
+	/** Number of rooms currently streamed in */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Streaming")
+	int32 GetNumStreamedInRooms() const { return ResidentRoomIndices.Num(); }
+
+	/** Floor a spawned room stands on (from its height above the manager), or INDEX_NONE if the room is not one of SpawnedRooms */
+	int32 GetRoomFloorIndex(const AMasterRoom* Room) const;
+
+	/** Seed data, streaming index and room lists always; the spawned and pooled rooms only in EResourceSizeMode::EstimatedTotal */
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** Spawns and configures one room from its seed data (the room does not generate itself) */
+	AMasterRoom* SpawnRoom(const FRoomSeedData& RoomSeedData, int32 FloorIndex);
+
+	/** World transform of a room recorded in seed data */
+	FTransform GetRoomTransform(const FRoomSeedData& RoomSeedData, int32 FloorIndex) const;
+
+	/** Size in global cells of the footprint a room generates with a seed */
+	FIntPoint GetRoomFootprintSize(const URoomData& RoomDataAsset, int32 RoomSeed) const;
+
+	/** Solves layouts in parallel on worker threads, then hands the inputs and plans to OnSolved on the game thread (dropped if the dungeon was regenerated or cleared meanwhile) */
+	void LaunchRoomSolves(TArray<FRoomLayoutInput>&& LayoutInputs, TFunction<void(ADungeonManager&, const TArray<FRoomLayoutInput>&, const TArray<FRoomBuildPlan>&)>&& OnSolved);
+
+	/** Commits solved plans, with the inputs they were solved from, to their rooms on the game thread */
+	void CommitRoomPlans(const TArray<TWeakObjectPtr<AMasterRoom>>& Rooms, const TArray<FRoomLayoutInput>& LayoutInputs, const TArray<FRoomBuildPlan>& Plans);
+
+	// ========== Streaming ==========
+
+	/** Indexes the bounds of every room in CurrentSeedData and starts the streaming timer */
+	void BeginStreaming();
+
+	/** Appends the manager-relative location of every player view point and streaming source */
+	void GatherStreamingSourceLocations(TArray<FVector>& OutLocations) const;
+
+	/** Pops a pooled room (or spawns one) and configures it for a streamed room */
+	AMasterRoom* AcquireStreamedRoom(int32 StreamedRoomIndex);
+
+	/** Marks a streamed room resident once its assets are loaded and launches its solve (dropped if it was streamed out or the dungeon cleared meanwhile) */
+	void OnStreamedRoomAssetsLoaded(int32 StreamedRoomIndex, int32 StreamSerial, int32 RequestId);
+
+	/** Tears a streamed room down and returns its actor to the pool (or destroys it when the pool is full) */
+	void ReleaseStreamedRoom(int32 StreamedRoomIndex);
+
+	/** Commits streamed room plans whose room has not been streamed out since the solve was launched */
+	void CommitStreamedRoomPlans(const TArray<int32>& StreamedRoomIndices, const TArray<int32>& StreamSerials, const TArray<FRoomLayoutInput>& LayoutInputs, const TArray<FRoomBuildPlan>& Plans);
+
+	/** Seed data of the current dungeon */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Generation")
+	FDungeonSeedData CurrentSeedData;
+
+	/** Rooms spawned for the current dungeon */
+	UPROPERTY(Transient)
+	TArray<AMasterRoom*> SpawnedRooms;
+
+	/** Hidden, torn-down rooms waiting for reuse by streaming */
+	UPROPERTY(Transient)
+	TArray<AMasterRoom*> PooledRooms;
+
+private:
+	/** Layout-only record of one room in streaming mode */
+	struct FStreamedRoom
+	{
+		/** Floor and index into that floor's RoomSeeds in CurrentSeedData */
+		int32 FloorIndex = 0;
+		int32 RoomIndex = 0;
+
+		/** Bounds relative to the manager's location */
+		FBox LocalBounds = FBox(ForceInit);
+
+		/** Spawned room while streamed in */
+		TWeakObjectPtr<AMasterRoom> Room;
+
+		/** Incremented on every stream in/out, so a plan solved for an earlier residency is discarded */
+		int32 StreamSerial = 0;
+	};
+
+	/** Every room of the current dungeon in streaming mode (same indices as StreamingIndex) */
+	TArray<FStreamedRoom> StreamedRooms;
+
+	/** Room footprints in global cells, for finding the rooms around a streaming source */
+	FDungeonSpatialHash StreamingIndex;
+
+	/** Indices into StreamedRooms of the rooms currently streamed in */
+	TArray<int32> ResidentRoomIndices;
+
+	/** Indices into StreamedRooms of spawned rooms still waiting for their assets */
+	TArray<int32> LoadingRoomIndices;
+
+	/** Timer driving UpdateStreaming */
+	FTimerHandle StreamingTimerHandle;
 
+	/** Incremented per generation so a stale parallel solve is discarded */
+	int32 GenerationRequestId = 0;
 };
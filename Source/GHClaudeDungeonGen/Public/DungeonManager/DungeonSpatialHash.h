@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FDungeonSpatialHash - Uniform bucket grid over room footprints on the global dungeon grid
+ * Each footprint is registered in every bucket it touches, so an overlap test only visits the rooms
+ * sharing a bucket with the query instead of every placed room.
+ * Footprints are FIntRects in global cells (Min inclusive, Max exclusive).
+ */
+class GHCLAUDEDUNGEONGEN_API FDungeonSpatialHash
+{
+public:
+	explicit FDungeonSpatialHash(int32 InBucketSize = 16);
+
+	/** Removes every footprint and sets the bucket edge length (in cells) */
+	void Reset(int32 InBucketSize);
+
+	/** Registers a footprint and returns its index */
+	int32 Add(const FIntRect& Footprint);
+
+	/** True if the footprint intersects any registered footprint */
+	bool Overlaps(const FIntRect& Footprint) const;
+
+	/** Appends the index of every registered footprint intersecting Region (each index at most once) */
+	void Query(const FIntRect& Region, TArray<int32>& OutIndices) const;
+
+	/** Number of registered footprints */
+	FORCEINLINE int32 Num() const { return Footprints.Num(); }
+
+	/** Footprint registered at an index */
+	FORCEINLINE const FIntRect& GetFootprint(int32 Index) const { return Footprints[Index]; }
+
+	/** Heap memory held by the footprints and buckets */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Bucket containing a global cell (floor division, so negative coordinates bucket correctly) */
+	FIntPoint ToBucket(const FIntPoint& Cell) const;
+
+	/** True if two footprints share at least one cell */
+	static FORCEINLINE bool Intersects(const FIntRect& A, const FIntRect& B)
+	{
+		return A.Min.X < B.Max.X && B.Min.X < A.Max.X && A.Min.Y < B.Max.Y && B.Min.Y < A.Max.Y;
+	}
+
+	/** Edge length of a bucket in cells */
+	int32 BucketSize;
+
+	/** Every registered footprint */
+	TArray<FIntRect> Footprints;
+
+	/** Footprint indices per bucket */
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Buckets;
+};
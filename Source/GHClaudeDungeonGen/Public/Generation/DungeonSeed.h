@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * What a derived seed is used for - part of the hash key, so sibling seeds never share a stream
+ * Values are persisted implicitly through seed data; append new entries, never reorder
+ */
+enum class EDungeonSeedDomain : uint32
+{
+	/** Floor seed from the master seed (Index = floor index) */
+	Floor = 1,
+
+	/** Room seed from the floor seed (Index = room index on the floor) */
+	Room,
+
+	/** Room type and position choice during floor layout (Index = room index on the floor) */
+	RoomPlacement,
+
+	/** Room solver passes, derived from the room seed */
+	Shape,
+	FloorTiles,
+	Walls,
+	Ceiling
+};
+
+/**
+ * FDungeonSeed - Counter-based seed derivation (SplitMix64 hashing)
+ * Any sub-seed is a pure function of (parent seed, domain, index), computed in O(1) without consuming a stream,
+ * so a room can be regenerated alone, in any order or on any thread, and still match a full-dungeon run:
+ *   MasterSeed -> FloorSeed(floor) -> RoomSeed(room) -> pass seeds (shape, floor tiles, walls, ceiling)
+ */
+struct GHCLAUDEDUNGEONGEN_API FDungeonSeed
+{
+	/** Bump whenever derivation or layout changes what a master seed generates, so older dungeon codes are rejected */
+	static constexpr int32 GeneratorVersion = 1;
+
+	/** SplitMix64 output function: a bijective 64-bit mix with full avalanche */
+	static FORCEINLINE uint64 Mix(uint64 Value)
+	{
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+
+	/** Derives the seed for (Domain, Index) under a parent seed */
+	static FORCEINLINE int32 Derive(int32 ParentSeed, EDungeonSeedDomain Domain, int32 Index = 0)
+	{
+		// Golden-ratio increments as in SplitMix64, keyed first by parent and domain, then by index
+		constexpr uint64 GoldenGamma = 0x9E3779B97F4A7C15ull;
+		const uint64 Key = Mix(static_cast<uint64>(static_cast<uint32>(ParentSeed)) + GoldenGamma * static_cast<uint64>(Domain));
+		const uint64 Hash = Mix(Key + GoldenGamma * (static_cast<uint64>(static_cast<uint32>(Index)) + 1));
+		return static_cast<int32>(static_cast<uint32>(Hash ^ (Hash >> 32)));
+	}
+
+	/** Seed of a floor */
+	static FORCEINLINE int32 DeriveFloorSeed(int32 MasterSeed, int32 FloorIndex)
+	{
+		return Derive(MasterSeed, EDungeonSeedDomain::Floor, FloorIndex);
+	}
+
+	/** Seed of a room on a floor */
+	static FORCEINLINE int32 DeriveRoomSeed(int32 FloorSeed, int32 RoomIndex)
+	{
+		return Derive(FloorSeed, EDungeonSeedDomain::Room, RoomIndex);
+	}
+
+	/** Seed of a room straight from the master seed */
+	static FORCEINLINE int32 DeriveRoomSeed(int32 MasterSeed, int32 FloorIndex, int32 RoomIndex)
+	{
+		return DeriveRoomSeed(DeriveFloorSeed(MasterSeed, FloorIndex), RoomIndex);
+	}
+
+	/** Fresh non-deterministic seed for bUseRandomSeed (independent of the shared FMath::Rand state) */
+	static int32 MakeRandomSeed();
+};
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Types/GridTypes.h"
+#include "Data/Grid/RoomGrid.h"
+#include "Generation/WeightedAliasSampler.h"
+
+/**
+ * A floor tile chosen by FFloorTilingSolver
+ */
+struct FFloorTilePlacement
+{
+	/** Index into the tile array passed to FFloorTilingSolver::Solve */
+	int32 TileIndex = INDEX_NONE;
+
+	/** Bottom-left grid coordinate of the covered cells */
+	FIntPoint BottomLeftCell = FIntPoint::ZeroValue;
+
+	/** Covered cells in X and Y after rotation */
+	FIntPoint Footprint = FIntPoint(1, 1);
+
+	/** Yaw in degrees (multiple of 90) */
+	float Yaw = 0.0f;
+};
+
+/**
+ * FFloorTilingSolver - Covers the free cells of a room with as few floor tiles as possible
+ * The unoccupied region is split into maximal rectangles (row-major, so the result does not depend on
+ * container iteration order). Each rectangle is packed with a guillotine grid of the available footprints,
+ * including 90-degree rotated ones for tiles that allow rotation, picked by a memoised search that minimises
+ * uncovered cells first and tile count second. SelectionWeight only chooses between variants of the same
+ * footprint, so variety never costs extra tiles. All random choices come from the given stream.
+ */
+class GHCLAUDEDUNGEONGEN_API FFloorTilingSolver
+{
+public:
+	/** Tiles every Unoccupied cell of Grid that the footprints allow (Grid itself is not modified) */
+	static void Solve(const FRoomGrid& Grid, TConstArrayView<FMeshPlacementData> Tiles, FRandomStream& RandomStream, TArray<FFloorTilePlacement>& OutPlacements);
+
+	/** True if a tile may be rotated in place (rotation needs a footprint-centered pivot) */
+	static bool CanRotate(const FMeshPlacementData& TileData);
+
+private:
+	/** One footprint size and every tile variant that produces it */
+	struct FFootprintOption
+	{
+		FIntPoint Size = FIntPoint(1, 1);
+
+		/** Tile index per variant, and whether the variant is the tile turned by 90 degrees */
+		TArray<int32> TileIndices;
+		TArray<bool> RotatedFlags;
+
+		FWeightedAliasSampler Sampler;
+	};
+
+	/** Memoised best packing of a W x H rectangle */
+	struct FPackResult
+	{
+		/** Uncovered cells weighted above tile count (INDEX_NONE = not evaluated) */
+		int64 Cost = INDEX_NONE;
+
+		/** Option tiled in the bottom-left block (INDEX_NONE = nothing fits) */
+		int32 OptionIndex = INDEX_NONE;
+
+		/** True if the leftover is split into a full-height right strip and a top strip, false for the transpose */
+		bool bSplitRightFirst = true;
+	};
+
+	FFloorTilingSolver(TConstArrayView<FMeshPlacementData> InTiles, const FIntPoint& MaxRectSize, FRandomStream& InRandomStream);
+
+	/** Groups the tiles (and their rotations) into footprint options, largest area first */
+	void BuildOptions();
+
+	/** Returns the memoised best packing of a Width x Height rectangle */
+	const FPackResult& Evaluate(int32 Width, int32 Height);
+
+	/** Emits the placements for a rectangle according to its memoised packing */
+	void EmitRect(const FIntPoint& BottomLeftCell, int32 Width, int32 Height, TArray<FFloorTilePlacement>& OutPlacements);
+
+	/** Picks a variant and orientation for one tile of an option */
+	void EmitTile(const FFootprintOption& Option, const FIntPoint& BottomLeftCell, TArray<FFloorTilePlacement>& OutPlacements);
+
+	TConstArrayView<FMeshPlacementData> Tiles;
+	FRandomStream& RandomStream;
+
+	TArray<FFootprintOption> Options;
+
+	/** Dense memo indexed by Height * (MaxRectSize.X + 1) + Width */
+	FIntPoint MaxRectSize;
+	TArray<FPackResult> Memo;
+
+	/** Cost of leaving one cell uncovered (more than any possible tile count) */
+	int64 UncoveredCellCost;
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+#include "Types/RoomBuildPlan.h"
+#include <atomic>
+
+/**
+ * FRoomBuildCache - Process-wide cache of solved rooms ("baked rooms")
+ * Plans are keyed by a hash of everything the solver reads (room data contents, shape, seed, forced placements)
+ * plus FDungeonSeed::GeneratorVersion, and stored as compact binary blobs: an LRU in memory and, optionally,
+ * one file per key under Saved/DungeonGen/RoomBuildCache. A hit skips FRoomLayoutSolver entirely.
+ * Thread-safe; FindOrSolve can be called from solver worker threads.
+ */
+class GHCLAUDEDUNGEONGEN_API FRoomBuildCache
+{
+public:
+	/** Bumped whenever the blob layout changes (older disk entries are then ignored) */
+	static constexpr uint8 FormatVersion = 1;
+
+	/** Default number of plans kept in memory */
+	static constexpr int32 DefaultMaxEntries = 1024;
+
+	/** Returns the shared cache */
+	static FRoomBuildCache& Get();
+
+	FRoomBuildCache();
+
+	/** Returns the cached plan for Input, or solves it and caches the result (bUseDiskStore also reads/writes the Saved/ store) */
+	FRoomBuildPlan FindOrSolve(const FRoomLayoutInput& Input, bool bUseDiskStore);
+
+	/** Key of a solver input - equal keys solve to equal plans */
+	static uint64 MakeKey(const FRoomLayoutInput& Input);
+
+	/** Looks up a plan in memory, then on disk if bUseDiskStore (a disk hit is promoted to memory) */
+	bool Find(uint64 Key, bool bUseDiskStore, FRoomBuildPlan& OutPlan);
+
+	/** Stores a successful plan in memory and, if bUseDiskStore, on disk */
+	void Add(uint64 Key, const FRoomBuildPlan& Plan, bool bUseDiskStore);
+
+	/** Reads or writes a plan in the cache's binary format (sets an error on Ar for malformed data) */
+	static void SerializePlan(FArchive& Ar, FRoomBuildPlan& Plan);
+
+	/** Drops every in-memory plan and sets how many are kept from now on (the disk store is left alone) */
+	void Empty(int32 MaxEntries = DefaultMaxEntries);
+
+	/** Number of plans held in memory */
+	int32 Num() const;
+
+	/** Bytes held by the in-memory blobs */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Lookups served from memory or disk / lookups that had to solve, since startup */
+	int64 GetNumHits() const { return NumHits.load(std::memory_order_relaxed); }
+	int64 GetNumMisses() const { return NumMisses.load(std::memory_order_relaxed); }
+
+private:
+	/** File holding a key in the disk store */
+	static FString GetDiskPath(uint64 Key);
+
+	/** Decodes a blob, rejecting malformed data */
+	static bool ReadBlob(const TArray<uint8>& Blob, FRoomBuildPlan& OutPlan);
+
+	/** Encoded plans, most recently used first */
+	TLruCache<uint64, TArray<uint8>> Blobs;
+
+	mutable FCriticalSection Mutex;
+
+	std::atomic<int64> NumHits;
+	std::atomic<int64> NumMisses;
+};
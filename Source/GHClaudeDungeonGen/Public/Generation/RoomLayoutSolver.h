@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Types/RoomBuildPlan.h"
+
+enum class EDungeonSeedDomain : uint32;
+
+/**
+ * Wall-clock time spent in each solver pass (seconds), filled by Solve on request for profiling and benchmarks
+ */
+struct GHCLAUDEDUNGEONGEN_API FRoomLayoutSolveTimings
+{
+	double ShapeSeconds = 0.0;
+	double GridSeconds = 0.0;
+	double ForcedPlacementSeconds = 0.0;
+	double FloorSeconds = 0.0;
+	double WallSeconds = 0.0;
+	double CeilingSeconds = 0.0;
+
+	/** Sum of every pass */
+	double GetTotalSeconds() const
+	{
+		return ShapeSeconds + GridSeconds + ForcedPlacementSeconds + FloorSeconds + WallSeconds + CeilingSeconds;
+	}
+};
+
+/**
+ * FRoomLayoutSolver - Pure room layout stage
+ * Turns an FRoomLayoutInput into an FRoomBuildPlan without touching any UObject,
+ * so it can run on a worker thread. AMasterRoom::CommitBuildPlan applies the result.
+ */
+class GHCLAUDEDUNGEONGEN_API FRoomLayoutSolver
+{
+public:
+	/** Solves a complete room layout (shape, forced placements, floor, walls, ceiling), timing each pass into OutTimings if given */
+	static FRoomBuildPlan Solve(const FRoomLayoutInput& Input, FRoomLayoutSolveTimings* OutTimings = nullptr);
+
+	/**
+	 * Re-solves a room previously solved into PreviousPlan, keeping every floor and ceiling tile that lies entirely outside
+	 * DirtyRegion (grid cells, Max exclusive); walls are solved in full. Use FindDirtyRegion to get the region
+	 */
+	static FRoomBuildPlan SolveIncremental(const FRoomLayoutInput& Input, const FRoomBuildPlan& PreviousPlan, const FIntRect& DirtyRegion);
+
+	/**
+	 * Finds the cells whose layout can differ between the input PreviousPlan was solved from and a new input
+	 * (changed forced placements, custom shape cells and floor/ceiling tile entries, plus one cell of neighbourhood)
+	 * Returns false if the change affects the whole room (seed, shape extents, cell size, new tile meshes...); an empty region means nothing to re-solve
+	 */
+	static bool FindDirtyRegion(const FRoomLayoutInput& PreviousInput, const FRoomLayoutInput& Input, const FRoomBuildPlan& PreviousPlan, FIntRect& OutDirtyRegion);
+
+	/** Returns the dense bounding box (in cells) covered by a shape */
+	static FIntPoint GetShapeGridExtents(const FRoomShapeDefinition& ShapeDefinition);
+
+	/** Returns the shape Solve picks from AllowedShapes for a seed (no override), without solving the room */
+	static bool SelectShapeForSeed(int32 Seed, const TArray<FRoomShapeDefinition>& AllowedShapes, FRoomShapeDefinition& OutShape);
+
+private:
+	FRoomLayoutSolver(const FRoomLayoutInput& InInput, FRoomBuildPlan& OutPlan);
+
+	/** Shared by Solve and SolveIncremental (PreviousPlan is null for a full solve) */
+	static FRoomBuildPlan Run(const FRoomLayoutInput& Input, const FRoomBuildPlan* PreviousPlan, const FIntRect& DirtyRegion, FRoomLayoutSolveTimings* OutTimings = nullptr);
+
+	/** Returns the override or the shape the seed selects */
+	static bool ResolveShape(const FRoomLayoutInput& Input, FRoomShapeDefinition& OutShape);
+
+	/** Reseeds RandomStream for a pass from the room seed, so passes never shift each other's draws */
+	void BeginPass(EDungeonSeedDomain Pass);
+
+	/** Picks the override or a random allowed shape */
+	bool SelectShape(FRoomShapeDefinition& OutShape);
+
+	/** Picks a random allowed shape from the stream */
+	static bool PickShape(FRandomStream& Stream, const TArray<FRoomShapeDefinition>& AllowedShapes, FRoomShapeDefinition& OutShape);
+
+	/** Initializes the plan grid based on shape definition */
+	void InitializeGrid(const FRoomShapeDefinition& ShapeDefinition);
+
+	/** Applies forced placements and validates no overlaps */
+	bool ApplyForcedPlacements();
+
+	/** Places floor tiles with the fewest tiles that cover the free cells (see FFloorTilingSolver) */
+	void SolveFloor();
+
+	/** A maximal straight run of exposed edges facing one direction */
+	struct FWallRun
+	{
+		/** Side of the cells the edges lie on */
+		EWallDirection Direction = EWallDirection::North;
+
+		/** Lowest cell of the run (runs go +X for north/south, +Y for east/west) */
+		FIntPoint StartCell = FIntPoint::ZeroValue;
+
+		/** Number of edges in the run */
+		int32 Length = 0;
+	};
+
+	/** Detects boundary edges, then places wall segments and corners */
+	void SolveWalls();
+
+	/** Merges collinear exposed edges (doorways excluded) into runs */
+	void ExtractWallRuns(TArray<FWallRun>& OutRuns) const;
+
+	/** Covers each run greedily with the longest fitting wall segment (CellsX is the length along the wall) */
+	void PlaceWallRuns(const TArray<FWallRun>& WallRuns);
+
+	/** Places outer corners on convex outline vertices and inner corners on concave ones */
+	void PlaceWallCorners();
+
+	/** True if the cell exists and is part of the room (anything but Unoccupied) */
+	bool IsInteriorCell(const FIntPoint& GridCoord) const;
+
+	/** Places ceiling tiles over occupied cells */
+	void SolveCeiling();
+
+	/** Re-adds PreviousPlan's entries of a container that lie outside DirtyRegion and whose cells are all still FreeState on TargetGrid (then marks them TakenState) */
+	void KeepPreviousEntries(ERoomContainer Container, FRoomGrid& TargetGrid, ECellState FreeState, ECellState TakenState);
+
+	/** Attempts to place a multi-cell mesh at the specified location (optionally consuming cells reserved by ReserveCellsForFootprint) */
+	bool TryPlaceMultiCellMesh(const FIntPoint& BottomLeftCell, const FMeshPlacementData& PlacementData, ERoomContainer Container, bool bConsumeReservation = false);
+
+	/** Reserves cells for a multi-cell mesh footprint */
+	bool ReserveCellsForFootprint(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY);
+
+	/** Checks if a footprint would overlap occupied or reserved cells */
+	bool CheckFootprintOverlap(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY) const;
+
+	/** Calculates pivot offset based on EMeshPivotType and cell size */
+	FVector CalculatePivotOffset(const FMeshPlacementData& PlacementData) const;
+
+	/** Converts grid coordinates to a position relative to the room origin */
+	FVector GetLocalPositionForCell(const FIntPoint& GridCoord, float ZOffset = 0.0f) const;
+
+	/** Appends a plan entry */
+	void AddEntry(const TSoftObjectPtr<UStaticMesh>& Mesh, ERoomContainer Container, const FTransform& LocalTransform, const FIntPoint& BottomLeftCell, const FIntPoint& Footprint);
+
+	const FRoomLayoutInput& Input;
+	FRoomBuildPlan& Plan;
+	FRoomGrid& Grid;
+
+	/** Random stream of the current pass (see BeginPass) */
+	FRandomStream RandomStream;
+
+	/** Plan whose tiles outside DirtyRegion are kept (null for a full solve) */
+	const FRoomBuildPlan* PreviousPlan = nullptr;
+	FIntRect DirtyRegion;
+};
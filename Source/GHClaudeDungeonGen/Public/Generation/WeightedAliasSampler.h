@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Types/GridTypes.h"
+
+/**
+ * FWeightedAliasSampler - Weighted random selection using Vose's alias method
+ * Built once per weight array in O(N); every draw afterwards is O(1) and only uses the given FRandomStream,
+ * so selections stay deterministic for a seed regardless of how many variants a pack ships with.
+ * Items with zero or negative weight are never selected.
+ */
+class GHCLAUDEDUNGEONGEN_API FWeightedAliasSampler
+{
+public:
+	FWeightedAliasSampler() = default;
+
+	explicit FWeightedAliasSampler(TConstArrayView<float> Weights)
+	{
+		Build(Weights);
+	}
+
+	/** Builds a sampler over the SelectionWeight of each placement */
+	static FWeightedAliasSampler FromPlacements(TConstArrayView<FMeshPlacementData> Placements);
+
+	/** Builds a sampler over any item array, reading each weight through WeightFunc(const ItemType&) */
+	template <typename ItemType, typename WeightFuncType>
+	static FWeightedAliasSampler FromItems(TConstArrayView<ItemType> Items, WeightFuncType&& WeightFunc)
+	{
+		TArray<float> Weights;
+		Weights.Reserve(Items.Num());
+		for (const ItemType& Item : Items)
+		{
+			Weights.Add(WeightFunc(Item));
+		}
+		return FWeightedAliasSampler(Weights);
+	}
+
+	/** Rebuilds the probability and alias tables for the given weights */
+	void Build(TConstArrayView<float> Weights);
+
+	/** Returns a weighted random index, or INDEX_NONE if no item has a positive weight */
+	int32 Sample(FRandomStream& RandomStream) const
+	{
+		if (IsEmpty())
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Column = RandomStream.RandHelper(Probabilities.Num());
+		return RandomStream.GetFraction() < Probabilities[Column] ? Column : Aliases[Column];
+	}
+
+	/** True if there is nothing to select */
+	FORCEINLINE bool IsEmpty() const { return Probabilities.Num() == 0; }
+
+	/** Number of items the sampler was built over */
+	FORCEINLINE int32 Num() const { return Probabilities.Num(); }
+
+private:
+	/** Chance of keeping column i instead of taking its alias */
+	TArray<float> Probabilities;
+
+	/** Item returned when column i is not kept */
+	TArray<int32> Aliases;
+};
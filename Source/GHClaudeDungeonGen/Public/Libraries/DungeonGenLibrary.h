@@ -4,14 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Types/DungeonSeedData.h"
 #include "DungeonGenLibrary.generated.h"
 
 /**
- * 
+ * UDungeonGenLibrary - Blueprint helpers for the dungeon generator
  */
 UCLASS()
 class GHCLAUDEDUNGEONGEN_API UDungeonGenLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
+public:
+	/**
+	 * Encodes the inputs that reproduce a dungeon (master seed, generator version, floor count, rooms per floor) as a short
+	 * checksummed Crockford base32 code such as "7K3MQ-9XA2B-4HN0R". Returns an empty string if the seed data was not
+	 * generated from its master seed (floor seeds not derived, floors not numbered 0..N-1 or RoomsPerFloor unknown)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Dungeon Code")
+	static FString EncodeDungeonCode(const FDungeonSeedData& SeedData);
+
+	/**
+	 * Decodes a dungeon code into seed data holding the master seed, the derived floor seeds and RoomsPerFloor (no rooms -
+	 * lay them out with ADungeonManager::GenerateFromDungeonCode). Case, dashes and spaces are ignored; returns false for a
+	 * malformed code, a checksum mismatch or a code from another generator version. Cheap enough to validate lobby lists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generation|Dungeon Code")
+	static bool DecodeDungeonCode(const FString& Code, FDungeonSeedData& OutSeedData);
 };
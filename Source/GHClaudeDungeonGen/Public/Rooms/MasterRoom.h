@@ -6,12 +6,26 @@
 #include "GameFramework/Actor.h"
 #include "Types/GridTypes.h"
 #include "Types/RoomShapeTypes.h"
+#include "Data/Grid/RoomGrid.h"
+#include "Types/RoomInstanceTypes.h"
+#include "Types/RoomBuildPlan.h"
+#include "Types/RoomGenerationContext.h"
+#include "Types/RoomMemoryStats.h"
+#include "Engine/StreamableManager.h"
 #include "MasterRoom.generated.h"
 
 // Forward declarations
+class AMasterRoom;
 class UDebugHelpers;
+class UDungeonDebugComponent;
 class URoomData;
 class USceneComponent;
+class UStaticMesh;
+class UMaterialInterface;
+class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoomGenerated, AMasterRoom*, GeneratedRoom);
 
 /**
  * AMasterRoom - Runtime room generator actor
@@ -19,26 +33,6 @@ class USceneComponent;
  * Supports both editor-time and runtime generation with forced placement workflow
  */
 UCLASS(Blueprintable, BlueprintType)
-class URoomData;
-class UDebugHelpers;
-class USceneComponent;
-class UStaticMeshComponent;
-
-/**
- * Master room actor that handles room generation and management
- * Supports both editor-time and runtime generation with forced placement workflow
- */
- * AMasterRoom - Core room actor for dungeon generation
- * Handles both editor-time preview and runtime generation of rooms
- * Supports forced placement workflow for testing and design iteration
- */
-class UDebugHelpers;
-class URoomData;
-class USceneComponent;
-class UStaticMesh;
-class UInstancedStaticMeshComponent;
-
-UCLASS()
 class GHCLAUDEDUNGEONGEN_API AMasterRoom : public AActor
 {
 	GENERATED_BODY()
@@ -47,7 +41,7 @@ public:
 	AMasterRoom();
 
 	// ========== Core Properties ==========
-	
+
 	/** Reference to the RoomData asset that defines this room */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation")
 	TSoftObjectPtr<URoomData> RoomData;
@@ -56,7 +50,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation", meta = (EditCondition = "!bUseRandomSeed"))
 	int32 GenerationSeed;
 
-	/** If true, generates a random seed each time; otherwise uses GenerationSeed */
+	/** If true, GenerateRoom/GenerateRoomAsync roll a new random seed (incremental regeneration keeps it); otherwise uses GenerationSeed */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation")
 	bool bUseRandomSeed;
 
@@ -68,22 +62,54 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation")
 	bool bUseShapeOverride;
 
+	/** If true, the room generates itself on construction (editor) and BeginPlay; disable when an owner such as ADungeonManager drives generation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation")
+	bool bGenerateOnSpawn;
+
+	/** If true, full generations look up the solved layout in FRoomBuildCache and only solve on a miss */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Cache")
+	bool bUseBuildCache;
+
+	/** If true, the build cache also reads and writes its on-disk store under Saved/ (survives restarts) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Cache", meta = (EditCondition = "bUseBuildCache"))
+	bool bPersistBuildCache;
+
+	/** If true, placements are batched into one instanced mesh component per mesh/material instead of one component per tile */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Rendering")
+	bool bUseInstancedMeshes;
+
+	/** If true, instanced batches use hierarchical instancing (HISM) for per-cluster culling and LOD */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Rendering", meta = (EditCondition = "bUseInstancedMeshes"))
+	bool bUseHierarchicalInstancing;
+
+	/** Mesh components kept hidden after cleanup and rebound by the next generation instead of being destroyed and recreated (0 disables pooling) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Rendering", meta = (ClampMin = "0"))
+	int32 MaxPooledComponents;
+
+	/** Broadcast whenever a build plan has been committed (sync or async generation) */
+	UPROPERTY(BlueprintAssignable, Category = "Room Generation")
+	FOnRoomGenerated OnRoomGenerated;
+
 	/** Flag indicating whether this room has been generated */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Generation")
 	bool bIsGenerated;
 
 	// ========== Runtime Grid ==========
-	
-	/** Runtime grid storing all cell data (key = grid coordinates) */
+
+	/** Runtime grid storing all cell data (dense, row-major structure-of-arrays over the room bounds) */
 	UPROPERTY()
-	TMap<FIntPoint, FGridCell> RuntimeGrid;
+	FRoomGrid RuntimeGrid;
+
+	/** Assets resolved once at the start of the last generation */
+	UPROPERTY(Transient)
+	FRoomGenerationContext GenerationContext;
 
-	/** Random stream for consistent random generation */
+	/** Instanced mesh components spawned by the last generation, with per-instance cell back-references */
 	UPROPERTY()
-	FRandomStream RandomStream;
+	TArray<FRoomInstanceBatch> InstanceBatches;
 
 	// ========== Doorway Snap Points ==========
-	
+
 	/** Doorway snap points on the north edge (in grid coordinates) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Generation|Doorways")
 	TArray<FIntPoint> NorthDoorwaySnapPoints;
@@ -101,7 +127,7 @@ public:
 	TArray<FIntPoint> WestDoorwaySnapPoints;
 
 	// ========== Scene Component Containers ==========
-	
+
 	/** Root scene component */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Generation|Components")
 	USceneComponent* RootSceneComponent;
@@ -126,8 +152,12 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Generation|Components")
 	UDebugHelpers* DebugHelpers;
 
+	/** Debug overlay of the generated layout (grid, cell states, walls, doorways, snap points, forced placements), hidden in game */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Generation|Components")
+	UDungeonDebugComponent* DebugOverlay;
+
 	// ========== Forced Placements ==========
-	
+
 	/** Forced floor placements (key = bottom-left grid coordinate) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Generation|Forced Placements")
 	TMap<FIntPoint, FMeshPlacementData> ForcedFloorPlacements;
@@ -141,17 +171,53 @@ public:
 	TMap<FIntPoint, FMeshPlacementData> ForcedCeilingPlacements;
 
 	// ========== API Methods ==========
-	
+
 	/** Main generation entry point - generates complete room from RoomData */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Room Generation")
 	void GenerateRoom();
 
-	/** Clears all generated meshes and resets the room */
+	/**
+	 * Streams RoomData and everything it references, solves the layout on a worker thread and commits it on the game thread
+	 * A newer GenerateRoom/GenerateRoomAsync call supersedes a pending one. Bind OnRoomGenerated to be notified
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Room Generation")
+	void GenerateRoomAsync();
+
+	/** Streams RoomData, its component data assets and all of their meshes/materials (plus forced placement meshes), then calls OnAssetsLoaded */
+	void LoadRoomAssetsAsync(FStreamableDelegate OnAssetsLoaded);
+
+	/**
+	 * Supersedes any pending generation, resolves the generation context and builds the solver input from GenerationSeed (game thread only)
+	 * For owners that solve many rooms themselves and hand the plans back through CommitBuildPlan
+	 */
+	bool PrepareLayoutInput(FRoomLayoutInput& OutInput);
+
+	/** Applies a plan solved from LayoutInput: resets the room, spawns every planned mesh in one batch and adopts the plan's grid */
+	void CommitBuildPlan(const FRoomBuildPlan& Plan, const FRoomLayoutInput& LayoutInput);
+
+	/**
+	 * Re-solves only the cells affected by edits since the last GenerateRoom (forced placements, custom shape cells, tile entries)
+	 * and only adds/removes the placements that changed. Falls back to GenerateRoom when the edit affects the whole room
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Room Generation")
+	void RegenerateIncremental();
+
+	/** Resolves RoomData, its component data assets, meshes and cell size into GenerationContext (game thread only) */
+	bool ResolveGenerationContext();
+
+	/** Copies everything the layout solver needs out of the resolved GenerationContext */
+	bool BuildLayoutInput(FRoomLayoutInput& OutInput) const;
+
+	/** Clears all generated meshes and resets the room */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Room Generation")
 	void CleanupRoom();
 
-	/** Refreshes debug visualization (useful when changing debug settings) */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation|Debug")
+	/** Picks a new seed and regenerates the room */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Room Generation")
+	void RegenerateWithNewSeed();
+
+	/** Rebuilds the debug overlay from the current layout, or clears it while debug drawing is off (layer toggles apply without it) */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Room Generation|Debug")
 	void RefreshDebugVisualization();
 
 	/** Returns true if the room has been successfully generated */
@@ -166,441 +232,132 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Room Generation")
 	int32 GetGridCellCount() const { return RuntimeGrid.Num(); }
 
-protected:
-	/** Generates floor tiles with forced placement support */
-	void GenerateFloor();
-
-	/** Generates wall segments with forced placement support */
-	void GenerateWalls();
-
-	/** Generates ceiling tiles with forced placement support */
-	void GenerateCeiling();
-
-	/** Applies forced placements and validates no overlaps */
-	bool ApplyForcedPlacements();
-
-	/** Converts grid coordinates to world position */
-	FVector GetWorldPositionForCell(const FIntPoint& GridCoord, float ZOffset = 0.0f) const;
-
-	/** Checks if a grid position is valid within the room bounds */
-	bool IsValidGridPosition(const FIntPoint& GridCoord) const;
-
-	/** Calculates pivot offset based on EMeshPivotType and cell size */
-	FVector CalculatePivotOffset(const FMeshPlacementData& PlacementData) const;
-
-	/** Attempts to place a multi-cell mesh at the specified location */
-	bool TryPlaceMultiCellMesh(const FIntPoint& BottomLeftCell, const FMeshPlacementData& PlacementData, USceneComponent* ParentContainer);
-
-	/** Reserves cells for a multi-cell mesh footprint */
-	bool ReserveCellsForFootprint(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY);
-
-	/** Checks if a footprint would overlap occupied or reserved cells */
-	bool CheckFootprintOverlap(const FIntPoint& BottomLeftCell, int32 FootprintX, int32 FootprintY) const;
-
-	/** Initializes the runtime grid based on shape definition */
-	void InitializeGrid(const FRoomShapeDefinition& ShapeDefinition);
-
-	/** Gets the current cell size from RoomData's GridConfig */
-	float GetCellSize() const;
-	// ========== Configuration Properties ==========
-	
-	/** Reference to the room data asset defining this room's configuration */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
-	TSoftObjectPtr<URoomData> RoomData;
-
-	/** Seed for random generation of this room */
-	// ========== Room Data Configuration ==========
-	
-	/** Reference to the room data asset that defines this room */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", meta = (AllowedClasses = "/Script/GHClaudeDungeonGen.RoomData"))
-	TSoftObjectPtr<URoomData> RoomData;
-
-	/** Seed for this room's generation (used if bUseRandomSeed is false) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Generation", meta = (EditCondition = "!bUseRandomSeed"))
-	int32 GenerationSeed;
-
-	/** If true, uses a random seed each time instead of GenerationSeed */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Generation")
-	bool bUseRandomSeed;
-
-	/** If true, overrides the shape from RoomData with ShapeOverride */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Shape")
-	bool bOverrideShape;
-
-	/** Shape override (only used if bOverrideShape is true) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Shape", meta = (EditCondition = "bOverrideShape"))
-	FRoomShapeDefinition ShapeOverride;
-
-	// ========== Runtime Generation State ==========
-	
-	/** Grid cells for this room (populated during generation) */
-	UPROPERTY(BlueprintReadOnly, Category = "Room State")
-	// ========== Configuration Properties ==========
-	
-	/** Reference to the room data asset that defines this room's configuration */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
-	TSoftObjectPtr<URoomData> RoomData;
-
-	/** Seed value for room generation randomness */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", meta = (EditCondition = "!bUseRandomSeed"))
-	int32 GenerationSeed;
-
-	/** If true, uses a random seed instead of the specified GenerationSeed */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
-	bool bUseRandomSeed;
-
-	/** If true, overrides the shape from RoomData with ShapeOverride */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
-	bool bOverrideShape;
-
-	/** Shape override to use when bOverrideShape is true */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", meta = (EditCondition = "bOverrideShape"))
-	FRoomShapeDefinition ShapeOverride;
-
-	// ========== Runtime State ==========
-	
-	/** Grid cells representing the room's layout */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room State")
-	TArray<FGridCell> Grid;
-
-	/** Random stream for reproducible generation */
-	// ========== Forced Placement Configuration ==========
-	
-	/** Forced floor placements: key is bottom-left cell coordinate, value is mesh placement data */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placements")
-	TMap<FIntPoint, FMeshPlacementData> ForcedFloorPlacements;
-
-	/** Forced wall placements: key is position and direction */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placements")
-	TMap<FIntPoint, FMeshPlacementData> ForcedWallPlacements;
-
-	/** Forced ceiling placements: key is bottom-left cell coordinate */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placements")
-	TMap<FIntPoint, FMeshPlacementData> ForcedCeilingPlacements;
-
-	/** Forced doorway placements: key is position and direction */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placements")
-	TMap<FIntPoint, FMeshPlacementData> ForcedDoorwayPlacements;
-
-	// ========== CallInEditor Functions ==========
-	
-	/** Generate the room using current configuration */
-	UFUNCTION(CallInEditor, Category = "Room Generation")
-	void GenerateRoom();
-
-	/** Clear all generated content from the room */
-	UFUNCTION(CallInEditor, Category = "Room Generation")
-	void ClearRoom();
-
-	/** Regenerate the room (clear then generate) */
-	UFUNCTION(CallInEditor, Category = "Room Generation")
-	void RegenerateRoom();
-
-	/** Update debug visualization (call after generation or when debug settings change) */
-	UFUNCTION(CallInEditor, Category = "Room Generation")
-	void UpdateDebugVisualization();
-
-	// ========== Runtime State ==========
-	
-	/** Grid cells representing the room layout */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room State")
-	TArray<FGridCell> Grid;
-
-	/** Random stream for deterministic generation */
-	UPROPERTY()
-	FRandomStream RandomStream;
-
-	/** Whether this room has been generated */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room State")
-	bool bIsGenerated;
-
-	// ========== Doorway Management ==========
-	
-	/** World space positions of doorway snap points for connecting to other rooms */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Doorways")
-	TArray<FVector> DoorwaySnapPoints;
-
-	/** Directions of doorways (North, South, East, West) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Doorways")
-	TArray<EWallDirection> DoorwayDirections;
-
-	// ========== Component Hierarchy ==========
-	
-	/** Root scene component for the entire room */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> RoomRoot;
-
-	/** Container for all floor meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> FloorContainer;
-
-	/** Container for all wall meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> WallContainer;
+	/** Returns a coordinate-keyed copy of the runtime grid (for Blueprint and debug drawing) */
+	UFUNCTION(BlueprintPure, Category = "Room Generation")
+	TMap<FIntPoint, FGridCell> GetRuntimeGridAsMap() const { return RuntimeGrid.ToMap(GetActorLocation(), GetCellSize()); }
 
-	/** Container for all ceiling meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> CeilingContainer;
+	/** Returns the dense runtime grid */
+	const FRoomGrid& GetRuntimeGrid() const { return RuntimeGrid; }
 
-	/** Container for all doorway meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> DoorwayContainer;
+	/** Looks up the cells covered by an instance of one of this room's instanced components (e.g. from a hit result's Component and Item) */
+	UFUNCTION(BlueprintPure, Category = "Room Generation")
+	bool GetCellsForMeshInstance(const UInstancedStaticMeshComponent* Component, int32 InstanceIndex, FIntPoint& OutBottomLeftCell, FIntPoint& OutFootprint) const;
 
-	/** Debug helper component for visualization */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<UDebugHelpers> DebugHelper;
-
-	// ========== Forced Placement System ==========
-	
-	/** Map of forced prop placements (cell coordinates -> actor class) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement")
-	TMap<FIntPoint, TSubclassOf<AActor>> ForcedPropPlacements;
-
-	/** Map of forced furniture placements (cell coordinates -> actor class) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement")
-	TMap<FIntPoint, TSubclassOf<AActor>> ForcedFurniturePlacements;
-
-	/** Map of forced enemy spawn placements (cell coordinates -> actor class) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement")
-	TMap<FIntPoint, TSubclassOf<AActor>> ForcedEnemyPlacements;
-
-	// ========== Generation Methods ==========
-	
-	/** Generate the room using RoomData configuration */
+	/** Removes an instance from one of this room's instanced components, keeping the cell back-references aligned */
 	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void GenerateRoom();
+	bool RemoveMeshInstance(UInstancedStaticMeshComponent* Component, int32 InstanceIndex);
 
-	/** Clear all generated room content */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void ClearRoom();
+	/** Destroys pooled components until at most MaxComponentsToKeep remain (0 empties the pool) */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Room Generation|Rendering")
+	void TrimComponentPool(int32 MaxComponentsToKeep = 0);
 
-	/** Regenerate room with new seed */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void RegenerateRoom(int32 NewSeed);
+	/** Returns the number of components waiting in the pool */
+	UFUNCTION(BlueprintPure, Category = "Room Generation|Rendering")
+	int32 GetNumPooledComponents() const { return NumPooledComponents; }
 
-	/** Apply forced placements to the room */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void ApplyForcedPlacements();
+	/** Memory held by this room: grid, committed plan, bookkeeping, mesh components, instance data and debug caches */
+	FRoomMemoryStats GetMemoryStats() const;
+
+	/** Grid, plan and bookkeeping always; components, instances and debug caches only in EResourceSizeMode::EstimatedTotal */
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
 protected:
 	virtual void BeginPlay() override;
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
-#endif
-
-private:
-	/** Initialize component hierarchy */
-	void InitializeComponents();
-
-	/** Generate grid based on shape definition */
-	void GenerateGrid(const FRoomShapeDefinition& Shape);
-
-	/** Spawn floor meshes */
-	void SpawnFloorMeshes();
-
-	/** Spawn wall meshes */
-	void SpawnWallMeshes();
-
-	/** Spawn ceiling meshes */
-	void SpawnCeilingMeshes();
-
-	/** Spawn doorway meshes */
-	void SpawnDoorwayMeshes();
-
-	/** Calculate doorway snap points from grid */
-	void CalculateDoorwaySnapPoints();
-	UPROPERTY(BlueprintReadOnly, Category = "Room State")
-	/** Whether the room has been generated */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room State")
-	bool bIsGenerated;
-
-	// ========== Doorway Snap Points ==========
-	
-	/** World-space locations for doorway snap points (used for room-to-room connections) */
-	UPROPERTY(BlueprintReadOnly, Category = "Room State|Doorways")
-	TArray<FVector> DoorwaySnapPoints;
-
-	/** Directions for each doorway snap point (North, East, South, West) */
-	UPROPERTY(BlueprintReadOnly, Category = "Room State|Doorways")
-	TArray<EWallDirection> DoorwayDirections;
-
-	// ========== Scene Components ==========
-	
-	/** Root component for the room */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Components")
-	TObjectPtr<USceneComponent> RoomRoot;
-
-	/** Container for all floor mesh components */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Components")
-	TObjectPtr<USceneComponent> FloorContainer;
-
-	/** Container for all wall mesh components */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Components")
-	TObjectPtr<USceneComponent> WallContainer;
-
-	/** Container for all ceiling mesh components */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Components")
-	TObjectPtr<USceneComponent> CeilingContainer;
-
-	/** Container for all doorway mesh components */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Components")
-	TObjectPtr<USceneComponent> DoorwayContainer;
-
-	/** Debug helper component for visualization */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Components")
-	TObjectPtr<UDebugHelpers> DebugHelper;
-
-	// ========== Forced Placement Maps ==========
-	
-	/** Map of grid coordinates to forced floor mesh indices (for designer control) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement", AdvancedDisplay)
-	TMap<FIntPoint, int32> ForcedFloorPlacements;
-
-	/** Map of grid coordinates to forced wall mesh indices */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement", AdvancedDisplay)
-	TMap<FIntPoint, int32> ForcedWallPlacements;
-
-	/** Map of grid coordinates to forced ceiling mesh indices */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement", AdvancedDisplay)
-	TMap<FIntPoint, int32> ForcedCeilingPlacements;
-
-	/** Map of grid coordinates to forced doorway mesh indices */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Forced Placement", AdvancedDisplay)
-	TMap<FIntPoint, int32> ForcedDoorwayPlacements;
-
-	// ========== Generation Methods ==========
-	
-	/** Generate or regenerate the room based on current settings */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void GenerateRoom();
-
-	/** Clear all generated geometry and reset state */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void ClearRoom();
-
-	/** Regenerate room with a new random seed */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	void RegenerateWithNewSeed();
-
-	/** Get the cell size from the RoomData (or default if not set) */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	float GetCellSize() const;
-
-	/** Get the shape definition to use (either from RoomData or override) */
-	UFUNCTION(BlueprintCallable, Category = "Room Generation")
-	FRoomShapeDefinition GetActiveShapeDefinition() const;
-
-	// ========== Editor Support ==========
-	
-#if WITH_EDITOR
-	/** Called when properties change in editor (for live preview) */
-	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
-	
-	/** Called when actor is constructed in editor (for preview) */
+	virtual void PostEditImport() override;
 	virtual void OnConstruction(const FTransform& Transform) override;
-#endif
+	virtual void BeginDestroy() override;
 
-protected:
-	/** Called when the game starts or when spawned */
-	virtual void BeginPlay() override;
-
-private:
-	// ========== Internal Generation Methods ==========
-	
-	/** Initialize the grid based on shape definition */
-	void InitializeGrid();
-
-	/** Generate floor meshes for all cells */
-	void GenerateFloorMeshes();
+	/** Regenerates incrementally when one of the data assets in GenerationContext is edited */
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+#endif
 
-	/** Generate wall meshes for all cells */
-	void GenerateWallMeshes();
+	/** Converts grid coordinates to world position */
+	FVector GetWorldPositionForCell(const FIntPoint& GridCoord, float ZOffset = 0.0f) const;
 
-	/** Generate ceiling meshes for all cells */
-	void GenerateCeilingMeshes();
+	/** Checks if a grid position is valid within the room bounds */
+	bool IsValidGridPosition(const FIntPoint& GridCoord) const;
 
-	/** Generate doorway meshes and snap points */
-	void GenerateDoorways();
+	/** Gets the current cell size from RoomData's GridConfig */
+	float GetCellSize() const;
 
-	/** Spawn a static mesh component in the specified container */
-	UStaticMeshComponent* SpawnMeshComponent(USceneComponent* Parent, UStaticMesh* Mesh, const FTransform& Transform);
+	/** Returns the scene container for a plan container */
+	USceneComponent* GetContainer(ERoomContainer Container) const;
 
-	/** Calculate world position for a grid coordinate */
-	FVector GridToWorldPosition(const FIntPoint& GridCoord) const;
+	/** Spawns a mesh as its own component, or queues it into an instanced batch when bUseInstancedMeshes is set */
+	void SpawnMeshAtTransform(UStaticMesh* Mesh, UMaterialInterface* Material, USceneComponent* ParentContainer, const FTransform& WorldTransform,
+		const FRoomInstanceCellRef& CellRef, const FString& ComponentName);
 
-	/** Get the effective seed to use for generation */
-	int32 GetEffectiveSeed() const;
-	/** World positions of doorway snap points for connecting to other rooms */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Doorways")
-	TArray<FVector> DoorwaySnapPoints;
+	/** Creates one instanced component per queued batch and adds all of its transforms in bulk */
+	void FlushInstanceBatches();
 
-	/** Directions corresponding to each doorway snap point */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Doorways")
-	TArray<EWallDirection> DoorwayDirections;
+	/** Spawns (or queues) the meshes of the given plan entries */
+	void SpawnPlanEntries(const FRoomBuildPlan& Plan, TConstArrayView<int32> EntryIndices);
 
-	// ========== Components ==========
-	
-	/** Root component for the entire room hierarchy */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> RoomRoot;
+	/** Solves (or fetches from the build cache) a prepared input and commits the plan */
+	void SolveAndCommit(const FRoomLayoutInput& LayoutInput);
 
-	/** Container for all floor meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> FloorContainer;
+	/** Flushes queued instances, adopts the plan's grid once its meshes are spawned and records the plan and its input */
+	void FinishCommit(const FRoomBuildPlan& Plan, const FRoomLayoutInput& LayoutInput);
 
-	/** Container for all wall meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> WallContainer;
+	/** Hands the runtime grid, forced placements and doorway snap points to the debug overlay (clears it when ShouldDrawDebugOverlay is false) */
+	void UpdateDebugOverlay();
 
-	/** Container for all ceiling meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> CeilingContainer;
+	/** True while DebugHelpers has debug drawing enabled, outside shipping game worlds */
+	bool ShouldDrawDebugOverlay() const;
 
-	/** Container for all doorway meshes */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<USceneComponent> DoorwayContainer;
+	/** Commits a plan against CommittedPlan, removing and spawning only the entries that differ */
+	void ApplyBuildPlanDelta(const FRoomBuildPlan& Plan, const FRoomLayoutInput& LayoutInput);
 
-	/** Debug visualization component */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-	TObjectPtr<UDebugHelpers> DebugHelper;
+	/** Removes the instance or component spawned for an entry of SourcePlan */
+	bool RemovePlanEntryMesh(const FRoomBuildPlan& SourcePlan, const FRoomBuildPlanEntry& Entry);
 
-protected:
-	// ========== Internal Generation Methods ==========
-	
-	/** Initialize the grid based on room shape */
-	void InitializeGrid();
+	/** Rebinds a pooled component of exactly ComponentClass (same mesh preferred) or creates one, attached to ParentContainer and visible */
+	UStaticMeshComponent* AcquireMeshComponent(UClass* ComponentClass, UStaticMesh* Mesh, USceneComponent* ParentContainer, FName BaseName);
 
-	/** Apply forced placements and mark occupied cells */
-	void ApplyForcedPlacements();
+	/** Hides a component and returns it to the pool (destroys it once the pool holds MaxPooledComponents) */
+	void ReleaseMeshComponent(UStaticMeshComponent* Component);
 
-	/** Generate floor tiles using weighted multi-cell placement */
-	void GenerateFloorTiles();
+private:
+	/** Instances queued during generation for one mesh/material/container combination */
+	struct FPendingInstanceBatch
+	{
+		UStaticMesh* Mesh = nullptr;
+		UMaterialInterface* Material = nullptr;
+		USceneComponent* ParentContainer = nullptr;
+		TArray<FTransform> Transforms;
+		TArray<FRoomInstanceCellRef> InstanceCells;
+	};
 
-	/** Generate wall meshes based on grid configuration */
-	void GenerateWalls();
+	/** Batches waiting for FlushInstanceBatches */
+	TArray<FPendingInstanceBatch> PendingInstanceBatches;
 
-	/** Generate ceiling tiles */
-	void GenerateCeiling();
+	/** Requests one batch of soft paths through the streamable manager (calls OnStageLoaded immediately when empty) */
+	void RequestAssetStage(TArray<FSoftObjectPath> AssetPaths, FStreamableDelegate OnStageLoaded);
 
-	/** Generate doorway meshes and populate snap points */
-	void GenerateDoorways();
+	/** Builds the layout input from resident assets and solves it on a worker thread */
+	void LaunchLayoutSolve(int32 RequestId);
 
-	/** Check if a multi-cell placement at the given position fits within available cells */
-	bool CanPlaceMeshAt(const FIntPoint& BottomLeft, int32 CellsX, int32 CellsY) const;
+	/** Incremented per generation request so stale async loads and solves are dropped */
+	int32 GenerationRequestId = 0;
 
-	/** Mark cells as occupied for a multi-cell placement */
-	void MarkCellsOccupied(const FIntPoint& BottomLeft, int32 CellsX, int32 CellsY);
+	/** Streamable handles keeping this room's assets resident */
+	TArray<TSharedPtr<FStreamableHandle>> RoomAssetHandles;
 
-	/** Spawn a static mesh at the given world position */
-	UStaticMeshComponent* SpawnMeshAtPosition(const FVector& WorldPosition, UStaticMesh* Mesh, const FMeshPlacementData& PlacementData, USceneComponent* ParentComponent);
+	/** Pooled components keyed by the mesh they last displayed */
+	UPROPERTY(Transient)
+	TMap<UStaticMesh*, FRoomComponentPoolBucket> ComponentPool;
 
-	/** Calculate world position for a cell coordinate considering pivot type */
-	FVector CalculateWorldPositionForCell(const FIntPoint& CellCoord, const FMeshPlacementData& PlacementData) const;
+	/** Total components across ComponentPool */
+	int32 NumPooledComponents = 0;
 
-	/** Get the active room shape (from override or RoomData) */
-	FRoomShapeDefinition GetActiveRoomShape() const;
+	/** Plan and input of the last commit (sync, async or from the dungeon manager), diffed by the next RegenerateIncremental (empty otherwise) */
+	FRoomBuildPlan CommittedPlan;
+	FRoomLayoutInput CommittedLayoutInput;
 
-	/** Load and validate RoomData asset */
-	bool LoadRoomData();
+#if WITH_EDITOR
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
 };
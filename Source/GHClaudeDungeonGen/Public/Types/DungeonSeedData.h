@@ -5,6 +5,38 @@
 #include "CoreMinimal.h"
 #include "DungeonSeedData.generated.h"
 
+// Forward declarations
+class UPackageMap;
+
+/**
+ * Custom version of the FDungeonSeedData archive format, recorded by the archive rather than in the data itself
+ * Values match FDungeonSeedData::SaveVersion; archives without it hold the tagged-property layout
+ */
+struct GHCLAUDEDUNGEONGEN_API FDungeonSeedDataCustomVersion
+{
+	enum Type
+	{
+		/** Tagged properties (SaveVersion 1) */
+		BeforeCustomVersionWasAdded = 0,
+
+		/** Compact binary format written by operator<< */
+		CompactBinaryFormat = 2,
+
+		/** RoomsPerFloor is stored */
+		AddedRoomsPerFloor,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	/** Unique ID for this custom version */
+	static const FGuid GUID;
+
+private:
+	FDungeonSeedDataCustomVersion() {}
+};
+
 /**
  * Struct containing seed data for a single room
  * Used for saving and loading room configurations
@@ -95,19 +127,50 @@ struct GHCLAUDEDUNGEONGEN_API FDungeonSeedData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Seed Data")
 	TArray<FFloorSeedData> FloorSeeds;
 
+	/** Rooms requested per floor when the layout was generated (0 if unknown) - with MasterSeed and the floor count it reproduces the layout */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Seed Data")
+	int32 RoomsPerFloor;
+
 	/** Timestamp when this seed data was generated */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Seed Data")
 	FDateTime GenerationTimestamp;
 
-	/** Version number for save compatibility */
+	/** Version number for save compatibility (the FDungeonSeedDataCustomVersion this data was loaded from, 1 for tagged properties) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Seed Data")
 	int32 SaveVersion;
 
+	/** Version written by operator<< */
+	static constexpr int32 CurrentSaveVersion = FDungeonSeedDataCustomVersion::LatestVersion;
+
 	FDungeonSeedData()
 		: MasterSeed(0)
 		, FloorSeeds()
+		, RoomsPerFloor(0)
 		, GenerationTimestamp(FDateTime::Now())
-		, SaveVersion(1)
+		, SaveVersion(CurrentSaveVersion)
 	{
 	}
+
+	/** Archives (save games included) use the compact binary form; older archives fall back to tagged properties */
+	bool Serialize(FArchive& Ar);
+
+	/** Replication uses the same compact form, so a whole dungeon fits in one packet */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/**
+	 * Compact encoding, versioned by the archive's FDungeonSeedDataCustomVersion: varint counts, seeds and coordinates, room locations delta-encoded within a floor,
+	 * rotation in 2 bits, asset names interned in a per-dungeon string table, and floor/room seeds that match their
+	 * FDungeonSeed derivation reduced to a flag bit (about 4-5 bytes per room)
+	 */
+	friend GHCLAUDEDUNGEONGEN_API FArchive& operator<<(FArchive& Ar, FDungeonSeedData& SeedData);
+};
+
+template<>
+struct TStructOpsTypeTraits<FDungeonSeedData> : public TStructOpsTypeTraitsBase2<FDungeonSeedData>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithNetSerializer = true,
+	};
 };
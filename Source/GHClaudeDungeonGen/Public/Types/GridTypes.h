@@ -72,6 +72,7 @@ enum class EWallDirection : uint8
 /**
  * Struct representing a single cell in the dungeon grid
  * Contains all information about the cell's state, position, walls, and occupancy
+ * Blueprint-facing view type - runtime room cells are stored compactly in FRoomGrid
  */
 USTRUCT(BlueprintType)
 struct GHCLAUDEDUNGEONGEN_API FGridCell
@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Types/GridTypes.h"
+#include "Types/RoomShapeTypes.h"
+#include "Data/Grid/RoomGrid.h"
+#include "RoomBuildPlan.generated.h"
+
+// Forward declarations
+class UMaterialInterface;
+
+/**
+ * Enum identifying which scene container a planned mesh is spawned under
+ */
+UENUM(BlueprintType)
+enum class ERoomContainer : uint8
+{
+	Floor UMETA(DisplayName = "Floor"),
+	Wall UMETA(DisplayName = "Wall"),
+	Door UMETA(DisplayName = "Door"),
+	Ceiling UMETA(DisplayName = "Ceiling")
+};
+
+/**
+ * Everything the room layout solver needs, copied out of the room's data assets on the game thread
+ * Holds soft references only as paths - the solver never resolves them
+ * New fields must also be fed into FRoomBuildCache::MakeKey, or cached plans would ignore them
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomLayoutInput
+{
+	GENERATED_BODY()
+
+	/** Seed for the solver's random stream */
+	UPROPERTY()
+	int32 Seed;
+
+	/** Whether ShapeOverride is used instead of AllowedShapes */
+	UPROPERTY()
+	bool bUseShapeOverride;
+
+	/** Shape used when bUseShapeOverride is set */
+	UPROPERTY()
+	FRoomShapeDefinition ShapeOverride;
+
+	/** Shapes to pick from when no override is set */
+	UPROPERTY()
+	TArray<FRoomShapeDefinition> AllowedShapes;
+
+	/** Size of each cell in world units */
+	UPROPERTY()
+	float CellSize;
+
+	/** Floor tile candidates */
+	UPROPERTY()
+	TArray<FMeshPlacementData> FloorTiles;
+
+	/** Wall segment candidates */
+	UPROPERTY()
+	TArray<FMeshPlacementData> WallSegments;
+
+	/** Corner candidates for concave (inner) and convex (outer) outline vertices */
+	UPROPERTY()
+	TArray<FMeshPlacementData> InnerCorners;
+
+	UPROPERTY()
+	TArray<FMeshPlacementData> OuterCorners;
+
+	/** Ceiling tile candidates */
+	UPROPERTY()
+	TArray<FMeshPlacementData> CeilingTiles;
+
+	/** Height of the ceiling above the floor */
+	UPROPERTY()
+	float CeilingHeightOffset;
+
+	/** Default materials per container */
+	UPROPERTY()
+	TSoftObjectPtr<UMaterialInterface> FloorMaterial;
+
+	UPROPERTY()
+	TSoftObjectPtr<UMaterialInterface> WallMaterial;
+
+	UPROPERTY()
+	TSoftObjectPtr<UMaterialInterface> CeilingMaterial;
+
+	/** Forced placements (key = bottom-left grid coordinate) */
+	UPROPERTY()
+	TMap<FIntPoint, FMeshPlacementData> ForcedFloorPlacements;
+
+	UPROPERTY()
+	TMap<FIntPoint, FMeshPlacementData> ForcedWallPlacements;
+
+	UPROPERTY()
+	TMap<FIntPoint, FMeshPlacementData> ForcedCeilingPlacements;
+
+	FRoomLayoutInput()
+		: Seed(0)
+		, bUseShapeOverride(false)
+		, CellSize(100.0f)
+		, CeilingHeightOffset(300.0f)
+	{
+	}
+
+	/** Heap memory held by the candidate lists, shapes and forced placements */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = ShapeOverride.CustomCellLayout.GetAllocatedSize() + AllowedShapes.GetAllocatedSize()
+			+ FloorTiles.GetAllocatedSize() + WallSegments.GetAllocatedSize() + InnerCorners.GetAllocatedSize() + OuterCorners.GetAllocatedSize()
+			+ CeilingTiles.GetAllocatedSize() + ForcedFloorPlacements.GetAllocatedSize() + ForcedWallPlacements.GetAllocatedSize()
+			+ ForcedCeilingPlacements.GetAllocatedSize();
+		for (const FRoomShapeDefinition& Shape : AllowedShapes)
+		{
+			Size += Shape.CustomCellLayout.GetAllocatedSize();
+		}
+		return Size;
+	}
+};
+
+/**
+ * A single mesh placement decided by the solver
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomBuildPlanEntry
+{
+	GENERATED_BODY()
+
+	/** Index into FRoomBuildPlan::MeshPaths */
+	UPROPERTY()
+	int32 MeshIndex;
+
+	/** Index into FRoomBuildPlan::MaterialPaths (INDEX_NONE = keep the mesh's own materials) */
+	UPROPERTY()
+	int32 MaterialIndex;
+
+	/** Container the mesh is spawned under */
+	UPROPERTY()
+	ERoomContainer Container;
+
+	/** Transform relative to the room origin */
+	UPROPERTY()
+	FTransform LocalTransform;
+
+	/** Bottom-left grid coordinate of the cells covered by this placement */
+	UPROPERTY()
+	FIntPoint BottomLeftCell;
+
+	/** Number of cells covered in X and Y */
+	UPROPERTY()
+	FIntPoint Footprint;
+
+	FRoomBuildPlanEntry()
+		: MeshIndex(INDEX_NONE)
+		, MaterialIndex(INDEX_NONE)
+		, Container(ERoomContainer::Floor)
+		, LocalTransform(FTransform::Identity)
+		, BottomLeftCell(0, 0)
+		, Footprint(1, 1)
+	{
+	}
+};
+
+/**
+ * Flat result of a room layout solve - applied to an AMasterRoom in one batch by CommitBuildPlan
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomBuildPlan
+{
+	GENERATED_BODY()
+
+	/** Unique meshes referenced by the entries */
+	UPROPERTY()
+	TArray<FSoftObjectPath> MeshPaths;
+
+	/** Unique materials referenced by the entries */
+	UPROPERTY()
+	TArray<FSoftObjectPath> MaterialPaths;
+
+	/** Every mesh placement, in solve order */
+	UPROPERTY()
+	TArray<FRoomBuildPlanEntry> Entries;
+
+	/** Final cell states, walls and doorways */
+	UPROPERTY()
+	FRoomGrid Grid;
+
+	/** Seed the plan was solved with */
+	UPROPERTY()
+	int32 Seed;
+
+	/** False if no shape could be selected */
+	UPROPERTY()
+	bool bSucceeded;
+
+	/** Number of forced placements rejected because they overlapped or fell outside the room */
+	UPROPERTY()
+	int32 NumRejectedForcedPlacements;
+
+	FRoomBuildPlan()
+		: Seed(0)
+		, bSucceeded(false)
+		, NumRejectedForcedPlacements(0)
+	{
+	}
+
+	/** Returns the handle for a mesh path, adding it to the table if needed */
+	int32 AddMeshPath(const FSoftObjectPath& Path)
+	{
+		return MeshPaths.AddUnique(Path);
+	}
+
+	/** Returns the handle for a material path (INDEX_NONE for a null path) */
+	int32 AddMaterialPath(const FSoftObjectPath& Path)
+	{
+		return Path.IsNull() ? INDEX_NONE : MaterialPaths.AddUnique(Path);
+	}
+
+	/** Heap memory held by the entries, path tables and grid */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Entries.GetAllocatedSize() + MeshPaths.GetAllocatedSize() + MaterialPaths.GetAllocatedSize() + Grid.GetAllocatedSize();
+	}
+};
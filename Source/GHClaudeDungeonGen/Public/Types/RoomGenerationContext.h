@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RoomGenerationContext.generated.h"
+
+// Forward declarations
+class URoomData;
+class UFloorData;
+class UWallData;
+class UDoorData;
+class UCeilingData;
+class UStaticMesh;
+class UMaterialInterface;
+
+/**
+ * Assets resolved once at the start of a room generation
+ * Every pass reads hard pointers from here instead of resolving soft references again
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomGenerationContext
+{
+	GENERATED_BODY()
+
+	/** Resolved room definition */
+	UPROPERTY()
+	URoomData* RoomData;
+
+	/** Resolved component data assets (null if the room does not reference one) */
+	UPROPERTY()
+	UFloorData* FloorData;
+
+	UPROPERTY()
+	UWallData* WallData;
+
+	UPROPERTY()
+	UDoorData* DoorData;
+
+	UPROPERTY()
+	UCeilingData* CeilingData;
+
+	/** Cell size from RoomData's GridConfig */
+	UPROPERTY()
+	float CellSize;
+
+	/** Every mesh referenced by the component data assets and forced placements, keyed by soft path */
+	UPROPERTY()
+	TMap<FSoftObjectPath, UStaticMesh*> Meshes;
+
+	/** Every material referenced by the component data assets, keyed by soft path */
+	UPROPERTY()
+	TMap<FSoftObjectPath, UMaterialInterface*> Materials;
+
+	FRoomGenerationContext()
+		: RoomData(nullptr)
+		, FloorData(nullptr)
+		, WallData(nullptr)
+		, DoorData(nullptr)
+		, CeilingData(nullptr)
+		, CellSize(100.0f)
+	{
+	}
+
+	/** True once RoomData has been resolved */
+	bool IsValid() const { return RoomData != nullptr; }
+
+	/** Returns a resolved mesh, or nullptr if the path was not part of this context */
+	UStaticMesh* FindMesh(const FSoftObjectPath& Path) const
+	{
+		UStaticMesh* const* Found = Meshes.Find(Path);
+		return Found ? *Found : nullptr;
+	}
+
+	/** Returns a resolved material, or nullptr if the path was not part of this context */
+	UMaterialInterface* FindMaterial(const FSoftObjectPath& Path) const
+	{
+		UMaterialInterface* const* Found = Materials.Find(Path);
+		return Found ? *Found : nullptr;
+	}
+};
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RoomInstanceTypes.generated.h"
+
+// Forward declarations
+class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Back-reference from a mesh instance to the grid cells it covers
+ */
+USTRUCT(BlueprintType)
+struct GHCLAUDEDUNGEONGEN_API FRoomInstanceCellRef
+{
+	GENERATED_BODY()
+
+	/** Bottom-left grid coordinate of the placement */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Instance")
+	FIntPoint BottomLeftCell;
+
+	/** Footprint of the placement in cells */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Room Instance")
+	FIntPoint Footprint;
+
+	FRoomInstanceCellRef()
+		: BottomLeftCell(0, 0)
+		, Footprint(1, 1)
+	{
+	}
+
+	FRoomInstanceCellRef(const FIntPoint& InBottomLeftCell, const FIntPoint& InFootprint)
+		: BottomLeftCell(InBottomLeftCell)
+		, Footprint(InFootprint)
+	{
+	}
+};
+
+/**
+ * One instanced mesh component spawned by a room, with a cell back-reference per instance
+ * InstanceCells is kept index-aligned with the component's instances
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomInstanceBatch
+{
+	GENERATED_BODY()
+
+	/** Instanced component holding every placement of one mesh/material pair in one container */
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Component;
+
+	/** Cell back-reference for each instance (same index as the component's instance) */
+	UPROPERTY()
+	TArray<FRoomInstanceCellRef> InstanceCells;
+
+	FRoomInstanceBatch()
+		: Component(nullptr)
+		, InstanceCells()
+	{
+	}
+};
+
+/**
+ * Hidden, registered components of one mesh kept by a room for reuse by its next generation
+ */
+USTRUCT()
+struct GHCLAUDEDUNGEONGEN_API FRoomComponentPoolBucket
+{
+	GENERATED_BODY()
+
+	/** Pooled components (per-placement and instanced; instanced ones hold no instances) */
+	UPROPERTY()
+	TArray<UStaticMeshComponent*> Components;
+};
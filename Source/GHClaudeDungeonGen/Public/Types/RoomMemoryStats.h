@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Memory held by a generated room, by category (bytes)
+ * Filled by AMasterRoom::GetMemoryStats and summed per floor and per room data asset by DungeonGen.DumpMemory
+ */
+struct GHCLAUDEDUNGEONGEN_API FRoomMemoryStats
+{
+	/** Runtime grid arrays, bitboard and occupancy map */
+	SIZE_T GridBytes = 0;
+
+	/** Committed plan and layout input, kept for incremental regeneration */
+	SIZE_T PlanBytes = 0;
+
+	/** Generation context, instance batch back-references, component pool and streaming handles */
+	SIZE_T BookkeepingBytes = 0;
+
+	/** Mesh component objects (visible and pooled) and their own resources */
+	SIZE_T ComponentBytes = 0;
+
+	/** Per-instance data of the instanced components */
+	SIZE_T InstanceBytes = 0;
+
+	/** Debug visualization caches */
+	SIZE_T DebugBytes = 0;
+
+	int32 NumCells = 0;
+	int32 NumComponents = 0;
+	int32 NumPooledComponents = 0;
+	int32 NumInstances = 0;
+
+	SIZE_T GetTotalBytes() const
+	{
+		return GridBytes + PlanBytes + BookkeepingBytes + ComponentBytes + InstanceBytes + DebugBytes;
+	}
+
+	FRoomMemoryStats& operator+=(const FRoomMemoryStats& Other)
+	{
+		GridBytes += Other.GridBytes;
+		PlanBytes += Other.PlanBytes;
+		BookkeepingBytes += Other.BookkeepingBytes;
+		ComponentBytes += Other.ComponentBytes;
+		InstanceBytes += Other.InstanceBytes;
+		DebugBytes += Other.DebugBytes;
+		NumCells += Other.NumCells;
+		NumComponents += Other.NumComponents;
+		NumPooledComponents += Other.NumPooledComponents;
+		NumInstances += Other.NumInstances;
+		return *this;
+	}
+};